@@ -0,0 +1,44 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/disassembler/Disassembler.hpp>
+
+#include <libnpln/libnpln.bench.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+using namespace libnpln;
+
+namespace {
+
+// Disassembles every ROM per iteration.
+auto BM_DisassemblerRun(benchmark::State& state) -> void
+{
+    auto const& roms = bench::get_roms();
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        for (auto const& rom : roms) {
+            disassembler::Disassembler d{rom.program};
+            benchmark::DoNotOptimize(d.run());
+            bytes += rom.program.size();
+        }
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+}
+
+} // namespace
+
+BENCHMARK(BM_DisassemblerRun);
@@ -16,68 +16,121 @@
 
 #include <gsl/gsl>
 
+#include <algorithm>
+#include <limits>
+
 namespace libnpln::disassembler {
 
+namespace {
+
+// The offset past the last byte of a program that can be addressed once it is loaded.
+constexpr std::size_t addressable_size =
+    std::numeric_limits<machine::Address>::max() + std::size_t{1}
+    - machine::Machine::program_address;
+
+} // namespace
+
 Disassembler::Disassembler(gsl::span<machine::Byte const> const program) : program_{program} {}
 
 auto Disassembler::run() -> Table const&
 {
     if (table_.empty()) {
-        step();
+        marks_.assign(
+            std::min(static_cast<std::size_t>(program_.size()), addressable_size), Mark::data);
+        trace(marks_);
+        tabulate(marks_);
     }
     return table_;
 }
 
-auto Disassembler::index() const -> gsl::index
+auto Disassembler::reset(gsl::span<machine::Byte const> const program) -> void
 {
-    return gsl::narrow<gsl::index>(address_) - machine::Machine::program_address;
+    program_ = program;
+    table_.clear();
 }
 
-auto Disassembler::fetch() const -> std::optional<machine::Word>
+auto Disassembler::fetch(std::size_t const offset) const -> std::optional<machine::Instruction>
 {
-    auto const idx = index();
-    if (idx < 0 || idx + 1 >= program_.size()) {
+    if (offset + 1 >= static_cast<std::size_t>(program_.size())) {
         return std::nullopt;
     }
 
-    auto const high = gsl::at(program_, idx + 0);
-    auto const low = gsl::at(program_, idx + 1);
-    return machine::make_word(high, low); // Big-endian
+    auto const high = program_[gsl::narrow_cast<gsl::index>(offset + 0)];
+    auto const low = program_[gsl::narrow_cast<gsl::index>(offset + 1)];
+    return machine::Instruction::decode(machine::make_word(high, low)); // Big-endian
 }
 
-auto Disassembler::step() -> bool
+auto Disassembler::trace(std::vector<Mark>& marks) const -> void
 {
     using namespace machine;
 
-    // Treat the current address as a data byte if it's the last byte in the program (fetch fails)
-    // or it, combined with the following byte, does not form an instruction (decode fails).
-    auto const w = fetch();
-    auto const i = w != std::nullopt ? Instruction::decode(*w) : std::nullopt;
-    if (i == std::nullopt) {
-        auto const idx = index();
-        if (idx < 0 || idx >= program_.size()) {
-            return false;
+    // The worklist holds offsets into the program.  Jumps and calls below the program address have
+    // no offset, so they are not followed.
+    std::vector<std::size_t> worklist{0};
+    auto const push = [&worklist](Address const a) {
+        if (a >= Machine::program_address) {
+            worklist.push_back(a - Machine::program_address);
         }
+    };
 
-        auto const b = gsl::at(program_, idx);
-        add_byte(b);
-        address_ += sizeof b;
-        return step();
-    }
+    while (!worklist.empty()) {
+        auto const offset = worklist.back();
+        worklist.pop_back();
 
-    add_instruction(*i);
-    address_ += Instruction::width;
-    return step();
-}
+        // An instruction that would overlap one that was already found is not decoded.
+        if (offset + 1 >= marks.size() || marks[offset] != Mark::data
+            || marks[offset + 1] != Mark::data) {
+            continue;
+        }
 
-auto Disassembler::add_instruction(machine::Instruction const& instr) -> void
-{
-    insert_row(table_, {address_, instr});
+        auto const i = fetch(offset);
+        if (i == std::nullopt) {
+            continue;
+        }
+        marks[offset] = Mark::instruction;
+        marks[offset + 1] = Mark::continuation;
+
+        auto const next = offset + Instruction::width;
+        switch (i->op) {
+        case Operator::ret: break;
+        case Operator::jmp_a: push(std::get<AOperands>(i->args).address); break;
+        case Operator::call_a:
+            push(std::get<AOperands>(i->args).address);
+            worklist.push_back(next);
+            break;
+        case Operator::jmp_v0_a:
+            // The target depends on V0 at run time, and is only known to begin at the address.
+            push(std::get<AOperands>(i->args).address);
+            break;
+        case Operator::seq_v_b:
+        case Operator::sne_v_b:
+        case Operator::seq_v_v:
+        case Operator::sne_v_v:
+        case Operator::skp_v:
+        case Operator::sknp_v:
+            worklist.push_back(next + Instruction::width);
+            worklist.push_back(next);
+            break;
+        default: worklist.push_back(next); break;
+        }
+    }
 }
 
-auto Disassembler::add_byte(machine::Byte byte) -> void
+auto Disassembler::tabulate(std::vector<Mark> const& marks) -> void
 {
-    insert_row(table_, {address_, byte});
+    using namespace machine;
+
+    // The rows are found in the order of their addresses, so each is inserted at the end.
+    for (std::size_t offset = 0; offset < marks.size(); ++offset) {
+        auto const address = static_cast<Address>(Machine::program_address + offset);
+        switch (marks[offset]) {
+        case Mark::instruction: insert_row(table_, {address, *fetch(offset), {}}); break;
+        case Mark::continuation: break;
+        case Mark::data:
+            insert_row(table_, {address, program_[gsl::narrow_cast<gsl::index>(offset)], {}});
+            break;
+        }
+    }
 }
 
 } // namespace libnpln::disassembler
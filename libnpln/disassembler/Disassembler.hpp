@@ -22,12 +22,20 @@
 
 #include <gsl/span>
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <variant>
 #include <vector>
 
 namespace libnpln::disassembler {
 
+// Disassembles a program loaded at the program address by following its control flow from the
+// first instruction.  Each instruction that is reached is decoded, and its successors are added to
+// a worklist: the next instruction, the target of a jump or call, or both instructions after a
+// skip.  Every byte that is never reached as part of an instruction is listed as data.  The
+// traversal is iterative, so a program of any size disassembles without deep recursion, in time
+// linear in its size.  Bytes that would lie past the end of the address space are not listed.
 class Disassembler
 {
 public:
@@ -45,18 +53,26 @@ public:
 
     auto run() -> Table const&;
 
+    // Replaces the program with another to disassemble, reusing the storage of the traversal.
+    auto reset(gsl::span<machine::Byte const> program) -> void;
+
 private:
-    [[nodiscard]] auto index() const -> gsl::index;
-    [[nodiscard]] auto fetch() const -> std::optional<machine::Word>;
+    // What each byte of the program was found to be by the traversal.
+    enum class Mark : std::uint8_t
+    {
+        data,
+        instruction,
+        continuation,
+    };
 
-    auto step() -> bool;
+    [[nodiscard]] auto fetch(std::size_t offset) const -> std::optional<machine::Instruction>;
 
-    auto add_instruction(machine::Instruction const& instr) -> void;
-    auto add_byte(machine::Byte byte) -> void;
+    auto trace(std::vector<Mark>& marks) const -> void;
+    auto tabulate(std::vector<Mark> const& marks) -> void;
 
     gsl::span<machine::Byte const> program_;
-    machine::Address address_{machine::Machine::program_address};
 
+    std::vector<Mark> marks_;
     Table table_;
 };
 
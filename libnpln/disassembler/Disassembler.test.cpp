@@ -16,5 +16,152 @@
 
 #include <catch2/catch.hpp>
 
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
 using namespace libnpln;
 using namespace libnpln::disassembler;
+using namespace libnpln::machine;
+
+template<>
+struct Catch::StringMaker<Row>
+{
+    static auto convert(Row const& r)
+    {
+        return fmt::to_string(r);
+    }
+};
+
+namespace {
+
+auto decode(Word const w) -> Instruction
+{
+    return *Instruction::decode(w);
+}
+
+} // namespace
+
+TEST_CASE("Disassembler follows control flow from the first instruction", "[disassembler]")
+{
+    std::vector<Byte> const program{
+        0x22, 0x08, // CALL 208h
+        0x30, 0x01, // SEQ %V0, $01h
+        0x12, 0x0C, // JMP 20Ch
+        0x12, 0x06, // JMP 206h
+        0x60, 0x01, // MOV %V0, $01h
+        0x00, 0xEE, // RET
+        0x12, 0x0C, // JMP 20Ch
+        0xAB, 0xCD, // Data
+    };
+    Disassembler d{program};
+    REQUIRE(d.run()
+        == Table{
+            {0x200, decode(0x2208), {}},
+            {0x202, decode(0x3001), {}},
+            {0x204, decode(0x120C), {}},
+            {0x206, decode(0x1206), {}},
+            {0x208, decode(0x6001), {}},
+            {0x20A, decode(0x00EE), {}},
+            {0x20C, decode(0x120C), {}},
+            {0x20E, Byte{0xAB}, {}},
+            {0x20F, Byte{0xCD}, {}},
+        });
+}
+
+TEST_CASE("Disassembler lists unreachable bytes as data", "[disassembler]")
+{
+    std::vector<Byte> const program{
+        0x12, 0x05, // JMP 205h
+        0x60, 0x01, // Unreachable MOV %V0, $01h
+        0xFF, //       Data
+        0x00, 0xE0, // CLS
+        0x12, 0x05, // JMP 205h
+        0x00, //       Trailing byte
+    };
+    Disassembler d{program};
+    REQUIRE(d.run()
+        == Table{
+            {0x200, decode(0x1205), {}},
+            {0x202, Byte{0x60}, {}},
+            {0x203, Byte{0x01}, {}},
+            {0x204, Byte{0xFF}, {}},
+            {0x205, decode(0x00E0), {}},
+            {0x207, decode(0x1205), {}},
+            {0x209, Byte{0x00}, {}},
+        });
+}
+
+TEST_CASE("Disassembler does not decode instructions that overlap others", "[disassembler]")
+{
+    std::vector<Byte> const program{
+        0x60, 0x12, // MOV %V0, $12h
+        0x22, 0x01, // CALL 201h, whose target overlaps the first instruction
+        0x00, 0xEE, // RET
+    };
+    Disassembler d{program};
+    REQUIRE(d.run()
+        == Table{
+            {0x200, decode(0x6012), {}},
+            {0x202, decode(0x2201), {}},
+            {0x204, decode(0x00EE), {}},
+        });
+}
+
+TEST_CASE("Disassembler handles large programs", "[disassembler]")
+{
+    // Every instruction follows the one before it, up to the end of the address space.
+    constexpr std::size_t size = 0x10000;
+    std::vector<Byte> program(size);
+    for (std::size_t i = 0; i < size; i += 2) {
+        program[i] = 0x70; // ADD %V0, $01h
+        program[i + 1] = 0x01;
+    }
+
+    Disassembler d{program};
+    auto const& table = d.run();
+    REQUIRE(table.size() == (size - Machine::program_address) / 2);
+    REQUIRE(table.front() == Row{0x200, decode(0x7001), {}});
+    REQUIRE(table.back() == Row{0xFFFE, decode(0x7001), {}});
+    REQUIRE(find_address(table, 0xFFFF) == std::prev(std::end(table)));
+}
+
+TEST_CASE("Disassembler finds the last byte of a full-size program", "[disassembler]")
+{
+    // The program loops on its first instruction, so every other byte is data.
+    constexpr std::size_t size = 0x10000;
+    std::vector<Byte> program(size);
+    program[0] = 0x12; // JMP 200h
+    program[1] = 0x00;
+    program[0xFFFF - Machine::program_address] = 0xAA;
+
+    Disassembler d{program};
+    auto const& table = d.run();
+    REQUIRE(table.back() == Row{0xFFFF, Byte{0xAA}, {}});
+    REQUIRE(table.back().end_address() == 0x10000);
+
+    auto const i = find_address(table, 0xFFFF);
+    REQUIRE(i != std::end(table));
+    REQUIRE(*i == table.back());
+}
+
+TEST_CASE("Disassembler disassembles another program after a reset", "[disassembler]")
+{
+    std::vector<Byte> const first{
+        0x00, 0xE0, // CLS
+        0x12, 0x02, // JMP 202h
+    };
+    std::vector<Byte> const second{
+        0x00, 0xEE, // RET
+        0xAB,       // Data
+    };
+    Disassembler d{first};
+    REQUIRE(d.run().size() == 2);
+
+    d.reset(second);
+    REQUIRE(d.run()
+        == Table{
+            {0x200, decode(0x00EE), {}},
+            {0x202, Byte{0xAB}, {}},
+        });
+}
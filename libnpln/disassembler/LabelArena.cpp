@@ -0,0 +1,116 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/disassembler/LabelArena.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace libnpln::disassembler {
+
+LabelArena::LabelArena(LabelArena const& other)
+{
+    labels_.reserve(other.labels_.size());
+    ids_.reserve(other.ids_.size());
+    for (auto const l : other.labels_) {
+        intern(l);
+    }
+}
+
+auto LabelArena::operator=(LabelArena const& other) -> LabelArena&
+{
+    if (this != &other) {
+        *this = LabelArena{other};
+    }
+    return *this;
+}
+
+auto LabelArena::intern(std::string_view const label) -> LabelId
+{
+    if (label.empty()) {
+        return no_label;
+    }
+    if (auto const i = ids_.find(label); i != ids_.end()) {
+        return i->second;
+    }
+    if (labels_.size() >= std::numeric_limits<LabelId>::max()) {
+        throw std::length_error{"Too many labels in LabelArena::intern"};
+    }
+
+    auto const stored = store(label);
+    labels_.push_back(stored);
+    auto const id = static_cast<LabelId>(labels_.size());
+    ids_.emplace(stored, id);
+    return id;
+}
+
+auto LabelArena::find(std::string_view const label) const -> std::optional<LabelId>
+{
+    if (label.empty()) {
+        return no_label;
+    }
+    if (auto const i = ids_.find(label); i != ids_.end()) {
+        return i->second;
+    }
+    return std::nullopt;
+}
+
+auto LabelArena::get(LabelId const id) const -> std::string_view
+{
+    if (id == no_label) {
+        return {};
+    }
+    if (id > labels_.size()) {
+        throw std::out_of_range{"Unknown LabelId in LabelArena::get"};
+    }
+    return labels_[id - 1];
+}
+
+auto LabelArena::clear() noexcept -> void
+{
+    blocks_.clear();
+    block_free_ = 0;
+    labels_.clear();
+    ids_.clear();
+}
+
+auto LabelArena::store(std::string_view const label) -> std::string_view
+{
+    if (label.size() > block_free_) {
+        // A label longer than a block gets a block of its own, which is inserted before the last
+        // block so that the free space of the last block is kept.
+        if (label.size() > block_size) {
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+            auto block = std::make_unique<char[]>(label.size());
+            std::copy(label.begin(), label.end(), block.get());
+            auto const stored = std::string_view{block.get(), label.size()};
+            blocks_.insert(blocks_.empty() ? blocks_.end() : std::prev(blocks_.end()),
+                std::move(block));
+            return stored;
+        }
+        blocks_.push_back(std::make_unique<char[]>(block_size)); // NOLINT
+        block_free_ = block_size;
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    auto* const first = blocks_.back().get() + (block_size - block_free_);
+    std::copy(label.begin(), label.end(), first);
+    block_free_ -= label.size();
+    return {first, label.size()};
+}
+
+} // namespace libnpln::disassembler
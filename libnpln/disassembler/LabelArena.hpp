@@ -0,0 +1,84 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_DISASSEMBLER_LABELARENA_HPP
+#define LIBNPLN_DISASSEMBLER_LABELARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace libnpln::disassembler {
+
+// The identifier of a label interned by a LabelArena.  The identifier of the empty label is
+// no_label in every arena.
+using LabelId = std::uint32_t;
+
+constexpr LabelId no_label = 0;
+
+// Interns labels, so that each distinct label is stored once and is named by a small identifier.
+// The characters of the labels are stored back to back in blocks that never move, so that interning
+// a label allocates only when a block fills.  Labels are never removed, except by clearing the
+// arena.  A copy of an arena gives every label the same identifier as the original.
+class LabelArena
+{
+public:
+    LabelArena() = default;
+    LabelArena(LabelArena const& other);
+    LabelArena(LabelArena&&) noexcept = default;
+    ~LabelArena() = default;
+
+    auto operator=(LabelArena const& other) -> LabelArena&;
+    auto operator=(LabelArena&&) noexcept -> LabelArena& = default;
+
+    // Returns the identifier of a label, adding the label if the arena does not yet hold it.
+    auto intern(std::string_view label) -> LabelId;
+
+    // Returns the identifier of a label, or nothing if the arena does not hold it.
+    [[nodiscard]] auto find(std::string_view label) const -> std::optional<LabelId>;
+
+    // Returns the label that an identifier names.  Throws std::out_of_range if the identifier was
+    // not returned by this arena.
+    [[nodiscard]] auto get(LabelId id) const -> std::string_view;
+
+    // Returns the number of labels held, not counting the empty label.
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return labels_.size();
+    }
+
+    auto clear() noexcept -> void;
+
+private:
+    static constexpr std::size_t block_size = 4096;
+
+    // Returns a copy of a label whose characters are stored in the blocks.
+    auto store(std::string_view label) -> std::string_view;
+
+    // Labels longer than a block are stored in blocks of their own.
+    std::vector<std::unique_ptr<char[]>> blocks_; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    std::size_t block_free_ = 0;
+
+    // The labels by their identifiers, less one, and the identifiers by their labels.
+    std::vector<std::string_view> labels_;
+    std::unordered_map<std::string_view, LabelId> ids_;
+};
+
+} // namespace libnpln::disassembler
+
+#endif
@@ -0,0 +1,81 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/disassembler/LabelArena.hpp>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include <stdexcept>
+#include <string>
+
+using namespace libnpln::disassembler;
+
+TEST_CASE("LabelArena interns each label once", "[disassembler][label_arena]")
+{
+    auto a = LabelArena{};
+    auto const foo = a.intern("foo");
+    auto const bar = a.intern("bar");
+    REQUIRE(foo != no_label);
+    REQUIRE(bar != no_label);
+    REQUIRE(foo != bar);
+    REQUIRE(a.intern(std::string{"foo"}) == foo);
+    REQUIRE(a.size() == 2);
+
+    REQUIRE(a.get(foo) == "foo");
+    REQUIRE(a.get(bar) == "bar");
+    REQUIRE(a.find("bar") == bar);
+    REQUIRE(a.find("baz") == std::nullopt);
+}
+
+TEST_CASE("LabelArena names the empty label by no_label", "[disassembler][label_arena]")
+{
+    auto a = LabelArena{};
+    REQUIRE(a.intern("") == no_label);
+    REQUIRE(a.find("") == no_label);
+    REQUIRE(a.get(no_label).empty());
+    REQUIRE(a.size() == 0);
+}
+
+TEST_CASE("LabelArena keeps its labels as it grows", "[disassembler][label_arena]")
+{
+    auto a = LabelArena{};
+    auto const first = a.intern("first");
+    auto const first_view = a.get(first);
+    auto const long_label = std::string(10'000, 'x');
+    auto const long_id = a.intern(long_label);
+    for (auto i = 0; i < 2'000; ++i) {
+        a.intern(fmt::format("label_{}", i));
+    }
+
+    REQUIRE(a.get(first).data() == first_view.data());
+    REQUIRE(a.get(first) == "first");
+    REQUIRE(a.get(long_id) == long_label);
+    REQUIRE(a.find("label_1999") != std::nullopt);
+    REQUIRE_THROWS_AS(a.get(static_cast<LabelId>(a.size() + 1)), std::out_of_range);
+}
+
+TEST_CASE("LabelArena copies keep identifiers", "[disassembler][label_arena]")
+{
+    auto a = LabelArena{};
+    auto const foo = a.intern("foo");
+    auto const bar = a.intern("bar");
+
+    auto const b = a;
+    a.clear();
+    REQUIRE(a.size() == 0);
+    REQUIRE(b.get(foo) == "foo");
+    REQUIRE(b.get(bar) == "bar");
+    REQUIRE(b.find("foo") == foo);
+}
@@ -15,38 +15,71 @@
 #ifndef LIBNPLN_DISASSEMBLER_ROW_HPP
 #define LIBNPLN_DISASSEMBLER_ROW_HPP
 
+#include <libnpln/disassembler/LabelArena.hpp>
 #include <libnpln/machine/DataUnits.hpp>
 #include <libnpln/machine/Instruction.hpp>
 
-#include <libnpln/detail/Overload.hpp>
-
 #include <fmt/format.h>
 
-#include <string>
-#include <variant>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 
 namespace libnpln::disassembler {
 
+// An instruction or byte of data at an address of a disassembly.  The data is kept as the word that
+// encodes the instruction or as the byte, and the label as the identifier of a label interned by
+// the table that holds the row, so that a row is small and trivially copyable.
 struct Row
 {
+    enum class Kind : std::uint8_t
+    {
+        instruction,
+        byte,
+    };
+
+    constexpr Row(machine::Address const a, machine::Instruction const& i,
+        LabelId const l = no_label) noexcept
+        : label{l}, address{a}, word{i.encode()}, kind{Kind::instruction}
+    {}
+
+    constexpr Row(
+        machine::Address const a, machine::Byte const b, LabelId const l = no_label) noexcept
+        : label{l}, address{a}, word{b}, kind{Kind::byte}
+    {}
+
+    [[nodiscard]] constexpr auto instruction() const noexcept -> std::optional<machine::Instruction>
+    {
+        if (kind != Kind::instruction) {
+            return std::nullopt;
+        }
+        return machine::Instruction::decode(word);
+    }
+
+    [[nodiscard]] constexpr auto byte() const noexcept -> std::optional<machine::Byte>
+    {
+        if (kind != Kind::byte) {
+            return std::nullopt;
+        }
+        return static_cast<machine::Byte>(word);
+    }
+
     [[nodiscard]] constexpr auto data_width() const noexcept -> std::size_t
     {
-        return std::visit(
-            detail::overload{
-                [](machine::Instruction const&) { return machine::Instruction::width; },
-                [](machine::Byte b) { return sizeof b; },
-            },
-            data);
+        return kind == Kind::instruction ? machine::Instruction::width : sizeof(machine::Byte);
     }
 
-    [[nodiscard]] constexpr auto end_address() const noexcept -> machine::Address
+    // Returns the address past the last byte of the row, which is past the address space for a row
+    // that ends at its top.
+    [[nodiscard]] constexpr auto end_address() const noexcept -> std::size_t
     {
         return address + data_width();
     }
 
+    LabelId label;
     machine::Address address;
-    std::variant<machine::Instruction, machine::Byte> data;
-    std::string label;
+    machine::Word word;
+    Kind kind;
 };
 
 // Determine whether the ranges of addresses spanned by two rows intersect.
@@ -65,7 +98,8 @@ constexpr auto intersects(Row const& lhs, machine::Address const rhs) noexcept -
 
 constexpr auto operator==(Row const& lhs, Row const& rhs) noexcept -> bool
 {
-    return lhs.address == rhs.address && lhs.data == rhs.data && lhs.label == rhs.label;
+    return lhs.address == rhs.address && lhs.kind == rhs.kind && lhs.word == rhs.word
+        && lhs.label == rhs.label;
 }
 
 constexpr auto operator!=(Row const& lhs, Row const& rhs) noexcept -> bool
@@ -149,15 +183,15 @@ struct fmt::formatter<libnpln::disassembler::Row>
     template<typename FormatContext>
     auto format(libnpln::disassembler::Row const& value, FormatContext& context)
     {
-        return format_to(context.out(), "{}@{:03X}-{:03X}:{}", value.label, value.address,
-            value.end_address(),
-            std::visit(libnpln::detail::overload{
-                           [](libnpln::machine::Instruction const& i) {
-                               return fmt::format("Instruction({})", i);
-                           },
-                           [](libnpln::machine::Byte b) { return fmt::format("Byte({:02X})", b); },
-                       },
-                value.data));
+        auto out = context.out();
+        if (value.label != libnpln::disassembler::no_label) {
+            out = format_to(out, "#{}", value.label);
+        }
+        out = format_to(out, "@{:03X}-{:03X}:", value.address, value.end_address());
+        if (auto const i = value.instruction(); i != std::nullopt) {
+            return format_to(out, "Instruction({})", *i);
+        }
+        return format_to(out, "Byte({:02X})", value.word);
     }
 };
 
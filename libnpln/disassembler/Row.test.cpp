@@ -16,20 +16,32 @@
 
 #include <catch2/catch.hpp>
 
+#include <optional>
+#include <type_traits>
+
 using namespace libnpln;
 using namespace libnpln::disassembler;
 
+TEST_CASE("Row is compact", "[disassembler][row]")
+{
+    static_assert(std::is_trivially_copyable_v<Row>);
+    static_assert(sizeof(Row) <= 12);
+}
+
 TEST_CASE("Row can contain instruction data", "[disassembler][row]")
 {
     auto const r = Row{
-        0x000, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, "test"};
-    REQUIRE(std::holds_alternative<machine::Instruction>(r.data));
+        0x000, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, 1};
+    REQUIRE(r.instruction()
+        == machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}});
+    REQUIRE(r.byte() == std::nullopt);
 }
 
 TEST_CASE("Row can contain byte data", "[disassembler][row]")
 {
-    auto const r = Row{0x000, machine::Byte{0xAA}, "test"};
-    REQUIRE(std::holds_alternative<machine::Byte>(r.data));
+    auto const r = Row{0x000, machine::Byte{0xAA}, 1};
+    REQUIRE(r.byte() == machine::Byte{0xAA});
+    REQUIRE(r.instruction() == std::nullopt);
 }
 
 TEST_CASE("Row can compute its data width", "[disassembler][row]")
@@ -37,13 +49,13 @@ TEST_CASE("Row can compute its data width", "[disassembler][row]")
     SECTION("when it contains instruction data")
     {
         auto const r = Row{0x000,
-            machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, "test"};
+            machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, 1};
         REQUIRE(r.data_width() == machine::Instruction::width);
     }
 
     SECTION("when it contains byte data")
     {
-        auto const r = Row{0x000, machine::Byte{0xAA}, "test"};
+        auto const r = Row{0x000, machine::Byte{0xAA}, 1};
         REQUIRE(r.data_width() == sizeof(machine::Byte));
     }
 }
@@ -53,13 +65,13 @@ TEST_CASE("Row can compute its end address", "[disassembler][row]")
     SECTION("when it contains instruction data")
     {
         auto const r = Row{0x200,
-            machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, "test"};
+            machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, 1};
         REQUIRE(r.end_address() == r.address + r.data_width());
     }
 
     SECTION("when it contains byte data")
     {
-        auto const r = Row{0x200, machine::Byte{0xAA}, "test"};
+        auto const r = Row{0x200, machine::Byte{0xAA}, 1};
         REQUIRE(r.end_address() == r.address + r.data_width());
     }
 }
@@ -67,14 +79,14 @@ TEST_CASE("Row can compute its end address", "[disassembler][row]")
 TEST_CASE("Row intersections can be computed", "[disassembler][row]")
 {
     auto const r1 = Row{
-        0x200, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, "test"};
+        0x200, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, 1};
     auto const r2 = Row{
-        0x201, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, "test"};
+        0x201, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, 1};
     auto const r3 = Row{
-        0x202, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, "test"};
-    auto const r4 = Row{0x200, machine::Byte{0xAA}, "test"};
-    auto const r5 = Row{0x201, machine::Byte{0xAA}, "test"};
-    auto const r6 = Row{0x202, machine::Byte{0xAA}, "test"};
+        0x202, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, 1};
+    auto const r4 = Row{0x200, machine::Byte{0xAA}, 1};
+    auto const r5 = Row{0x201, machine::Byte{0xAA}, 1};
+    auto const r6 = Row{0x202, machine::Byte{0xAA}, 1};
 
     SECTION("between two instruction rows")
     {
@@ -116,7 +128,7 @@ TEST_CASE("Row-address intersections can be computed", "[disassembler][row]")
     SECTION("with instruction rows")
     {
         auto const r = Row{0x200,
-            machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, "test"};
+            machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, 1};
         REQUIRE(!intersects(r, 0x199));
         REQUIRE(intersects(r, 0x200));
         REQUIRE(intersects(r, 0x201));
@@ -125,7 +137,7 @@ TEST_CASE("Row-address intersections can be computed", "[disassembler][row]")
 
     SECTION("with instruction rows")
     {
-        auto const r = Row{0x200, machine::Byte{0xAA}, "test"};
+        auto const r = Row{0x200, machine::Byte{0xAA}, 1};
         REQUIRE(!intersects(r, 0x199));
         REQUIRE(intersects(r, 0x200));
         REQUIRE(!intersects(r, 0x201));
@@ -135,9 +147,9 @@ TEST_CASE("Row-address intersections can be computed", "[disassembler][row]")
 TEST_CASE("Rows can be compared for equality", "[disassembler][row]")
 {
     auto const r1 = Row{0x200, machine::Instruction::decode(0x00EE).value(), {}};
-    auto const r2 = Row{0x200, machine::Instruction::decode(0x00EE).value(), "foo"};
+    auto const r2 = Row{0x200, machine::Instruction::decode(0x00EE).value(), 1};
     auto const r3 = Row{0x200, machine::Byte{0xAA}, {}};
-    auto const r4 = Row{0x200, machine::Byte{0xAA}, "foo"};
+    auto const r4 = Row{0x200, machine::Byte{0xAA}, 1};
     auto const r5 = Row{0x201, machine::Instruction::decode(0x00EE).value(), {}};
 
     REQUIRE(r1 == r1);
@@ -156,14 +168,14 @@ TEST_CASE("Rows can be compared for equality", "[disassembler][row]")
 TEST_CASE("Rows can be compared for order", "[disassembler][row]")
 {
     auto const r1 = Row{
-        0x200, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, "test"};
+        0x200, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, 1};
     auto const r2 = Row{
-        0x201, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, "test"};
+        0x201, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, 1};
     auto const r3 = Row{
-        0x202, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, "test"};
-    auto const r4 = Row{0x200, machine::Byte{0xAA}, "test"};
-    auto const r5 = Row{0x201, machine::Byte{0xAA}, "test"};
-    auto const r6 = Row{0x202, machine::Byte{0xAA}, "test"};
+        0x202, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, 1};
+    auto const r4 = Row{0x200, machine::Byte{0xAA}, 1};
+    auto const r5 = Row{0x201, machine::Byte{0xAA}, 1};
+    auto const r6 = Row{0x202, machine::Byte{0xAA}, 1};
 
     REQUIRE(r1 <= r1);
     REQUIRE(r1 >= r1);
@@ -183,13 +195,34 @@ TEST_CASE("Rows can be compared for order", "[disassembler][row]")
     REQUIRE(r3 >= r2);
 }
 
+TEST_CASE("Rows of bytes can be compared for order", "[disassembler][row]")
+{
+    auto const i1 = Row{
+        0x200, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, 1};
+    auto const i2 = Row{
+        0x201, machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, 1};
+    auto const b1 = Row{0x200, machine::Byte{0xAA}, 1};
+    auto const b2 = Row{0x201, machine::Byte{0xAA}, 1};
+    auto const b3 = Row{0x202, machine::Byte{0xAA}, 1};
+
+    // Rows of bytes span a single address.
+    REQUIRE(b1 < b2);
+    REQUIRE(b2 < b3);
+    REQUIRE(b1 < i2);
+    REQUIRE(!(i1 < b2));
+    REQUIRE(i1 <= b2);
+    REQUIRE(b3 > b1);
+    REQUIRE(!(b3 > i2));
+    REQUIRE(b3 >= i2);
+}
+
 TEST_CASE("Row can be formatted", "[disassembler][row]")
 {
     SECTION("when it contains instruction data")
     {
         auto const r1 = Row{0x200,
-            machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, "test"};
-        REQUIRE(fmt::format("{}", r1) == "test@200-202:Instruction(CLS)");
+            machine::Instruction{machine::Operator::cls, machine::NullaryOperands{}}, 1};
+        REQUIRE(fmt::format("{}", r1) == "#1@200-202:Instruction(CLS)");
 
         auto const r2 = Row{
             0x302, machine::Instruction{machine::Operator::ret, machine::NullaryOperands{}}, {}};
@@ -198,8 +231,8 @@ TEST_CASE("Row can be formatted", "[disassembler][row]")
 
     SECTION("when it contains byte data")
     {
-        auto const r1 = Row{0x200, machine::Byte{0xAA}, "test"};
-        REQUIRE(fmt::format("{}", r1) == "test@200-201:Byte(AA)");
+        auto const r1 = Row{0x200, machine::Byte{0xAA}, 1};
+        REQUIRE(fmt::format("{}", r1) == "#1@200-201:Byte(AA)");
 
         auto const r2 = Row{0x302, machine::Byte{0x55}, {}};
         REQUIRE(fmt::format("{}", r2) == "@302-303:Byte(55)");
@@ -0,0 +1,50 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/disassembler/Summary.hpp>
+
+#include <optional>
+
+namespace libnpln::disassembler {
+
+Summary::Summary(Table const& table)
+{
+    for (auto const& row : table) {
+        if (auto const i = row.instruction(); i != std::nullopt) {
+            code_bytes_ += row.data_width();
+            ++operator_counts_[static_cast<std::size_t>(machine::to_operator_id(i->op))];
+        }
+        else {
+            data_bytes_ += row.data_width();
+        }
+    }
+}
+
+auto Summary::operator+=(Summary const& other) noexcept -> Summary&
+{
+    code_bytes_ += other.code_bytes_;
+    data_bytes_ += other.data_bytes_;
+    for (std::size_t i = 0; i < operator_counts_.size(); ++i) {
+        operator_counts_[i] += other.operator_counts_[i];
+    }
+    return *this;
+}
+
+auto Summary::code_ratio() const noexcept -> double
+{
+    auto const bytes = code_bytes_ + data_bytes_;
+    return bytes == 0 ? 0.0 : static_cast<double>(code_bytes_) / static_cast<double>(bytes);
+}
+
+} // namespace libnpln::disassembler
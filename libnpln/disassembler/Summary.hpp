@@ -0,0 +1,60 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_DISASSEMBLER_SUMMARY_HPP
+#define LIBNPLN_DISASSEMBLER_SUMMARY_HPP
+
+#include <libnpln/disassembler/Table.hpp>
+#include <libnpln/machine/Operator.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace libnpln::disassembler {
+
+// Counts the bytes of a disassembly that are code and data, and the instructions by operator.
+// Summaries add, so that the summaries of many programs may be combined into one.
+class Summary
+{
+public:
+    Summary() = default;
+    explicit Summary(Table const& table);
+
+    auto operator+=(Summary const& other) noexcept -> Summary&;
+
+    [[nodiscard]] auto code_bytes() const noexcept -> std::size_t
+    {
+        return code_bytes_;
+    }
+    [[nodiscard]] auto data_bytes() const noexcept -> std::size_t
+    {
+        return data_bytes_;
+    }
+    [[nodiscard]] auto operator_count(machine::Operator const op) const -> std::size_t
+    {
+        return operator_counts_[static_cast<std::size_t>(machine::to_operator_id(op))];
+    }
+
+    // Returns the fraction of the bytes that are code, or zero if there are no bytes.
+    [[nodiscard]] auto code_ratio() const noexcept -> double;
+
+private:
+    std::size_t code_bytes_ = 0;
+    std::size_t data_bytes_ = 0;
+    std::array<std::size_t, machine::operator_id_count> operator_counts_{};
+};
+
+} // namespace libnpln::disassembler
+
+#endif
@@ -0,0 +1,57 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/disassembler/Summary.hpp>
+
+#include <catch2/catch.hpp>
+
+using namespace libnpln;
+using namespace libnpln::disassembler;
+
+namespace {
+
+auto const table = Table{
+    Row{0x200, machine::Instruction::decode(0x00E0).value(), {}},
+    Row{0x202, machine::Instruction::decode(0x00E0).value(), {}},
+    Row{0x204, machine::Instruction::decode(0x1204).value(), {}},
+    Row{0x206, machine::Byte{0xAA}, {}},
+};
+
+} // namespace
+
+TEST_CASE("Summary counts code, data, and operators", "[disassembler][summary]")
+{
+    auto const s = Summary{table};
+    REQUIRE(s.code_bytes() == 6);
+    REQUIRE(s.data_bytes() == 1);
+    REQUIRE(s.operator_count(machine::Operator::cls) == 2);
+    REQUIRE(s.operator_count(machine::Operator::jmp_a) == 1);
+    REQUIRE(s.operator_count(machine::Operator::ret) == 0);
+    REQUIRE(s.code_ratio() == Approx(6.0 / 7.0));
+}
+
+TEST_CASE("Summary of an empty table has no code ratio", "[disassembler][summary]")
+{
+    REQUIRE(Summary{Table{}}.code_ratio() == 0.0);
+}
+
+TEST_CASE("Summaries add", "[disassembler][summary]")
+{
+    auto s = Summary{table};
+    s += Summary{table};
+    REQUIRE(s.code_bytes() == 12);
+    REQUIRE(s.data_bytes() == 2);
+    REQUIRE(s.operator_count(machine::Operator::cls) == 4);
+    REQUIRE(s.code_ratio() == Approx(6.0 / 7.0));
+}
@@ -16,65 +16,125 @@
 
 #include <algorithm>
 #include <iterator>
+#include <optional>
 #include <utility>
 
 namespace libnpln::disassembler {
 
-auto find_address(Table const& table, machine::Address addr) -> Table::const_iterator
+Table::Table(std::initializer_list<Row> const rows)
 {
-    auto i = std::lower_bound(std::begin(table), std::end(table), addr);
-    if (i == std::end(table) || !intersects(*i, addr)) {
-        return std::end(table);
+    for (auto const& r : rows) {
+        insert_row(*this, r);
     }
-    return i;
 }
 
-auto find_address(Table& table, machine::Address addr) -> Table::iterator
+Table::Table(std::initializer_list<std::pair<Row, std::string_view>> const labeled_rows)
 {
-    auto i = std::lower_bound(std::begin(table), std::end(table), addr);
-    if (i == std::end(table) || !intersects(*i, addr)) {
-        return std::end(table);
+    for (auto const& [r, l] : labeled_rows) {
+        insert_row(*this, r, l);
     }
-    return i;
 }
 
-auto find_label(Table const& table, std::string_view label) -> Table::const_iterator
+auto Table::clear() noexcept -> void
 {
-    return std::find_if(
-        std::begin(table), std::end(table), [&label](auto const& x) { return x.label == label; });
+    rows_.clear();
+    labels_.clear();
+    labeled_rows_.clear();
 }
 
-auto find_label(Table& table, std::string_view label) -> Table::iterator
+auto operator==(Table const& lhs, Table const& rhs) -> bool
 {
-    return std::find_if(
-        std::begin(table), std::end(table), [&label](auto const& x) { return x.label == label; });
+    // The labels are compared by name, as each table identifies them differently.
+    auto const equal = [&lhs, &rhs](Row const& l, Row const& r) {
+        return l.address == r.address && l.kind == r.kind && l.word == r.word
+            && lhs.label(l) == rhs.label(r);
+    };
+    return lhs.size() == rhs.size()
+        && std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), equal);
 }
 
-auto insert_row(Table& table, Row const& row) -> Table::iterator
+auto Table::erase(Rows::const_iterator const i) -> Rows::const_iterator
 {
-    return insert_row(table, Row{row});
+    if (i->label != no_label) {
+        auto const [first, last] = labeled_rows_.equal_range(i->label);
+        auto const j =
+            std::find_if(first, last, [&i](auto const& x) { return x.second == i->address; });
+        if (j != last) {
+            labeled_rows_.erase(j);
+        }
+    }
+    return rows_.erase(i);
 }
 
-auto insert_row(Table& table, Row&& row) -> Table::iterator
+auto find_address(Table const& table, machine::Address const addr) -> Table::const_iterator
+{
+    // The only row that can span the address is the last one to begin at or before it.
+    auto const& rows = table.rows_;
+    auto i = rows.upper_bound(std::size_t{addr});
+    if (i == rows.begin()) {
+        return rows.end();
+    }
+    --i;
+    return intersects(*i, addr) ? i : rows.end();
+}
+
+auto find_label(Table const& table, std::string_view const label) -> Table::const_iterator
 {
-    auto i = std::lower_bound(std::begin(table), std::end(table), row);
-    if (i == std::end(table)) {
-        table.push_back(std::move(row));
-        return std::end(table);
+    auto const& rows = table.rows_;
+
+    // Unlabeled rows are not indexed.
+    if (label.empty()) {
+        return std::find_if(
+            std::begin(rows), std::end(rows), [](Row const& r) { return r.label == no_label; });
     }
-    if (intersects(*i, row)) {
-        *i = std::move(row);
+
+    auto const id = table.labels_.find(label);
+    if (id == std::nullopt) {
+        return rows.end();
     }
-    else {
-        i = table.insert(i, std::move(row));
+    auto const [first, last] = table.labeled_rows_.equal_range(*id);
+    if (first == last) {
+        return rows.end();
     }
+    auto const j = std::min_element(
+        first, last, [](auto const& x, auto const& y) { return x.second < y.second; });
+    return rows.find(std::size_t{j->second});
+}
 
-    // Remove conflicting rows following the inserted row.
-    auto j = std::next(i);
-    if (j != std::end(table) && intersects(*i, *j)) {
-        table.erase(j);
+auto insert_row(Table& table, Row&& row) -> Table::iterator
+{
+    return insert_row(table, static_cast<Row const&>(row));
+}
+
+auto insert_row(Table& table, Row row, std::string_view const label) -> Table::iterator
+{
+    row.label = table.intern(label);
+    return insert_row(table, row);
+}
+
+auto insert_row(Table& table, Row const& row) -> Table::iterator
+{
+    auto& rows = table.rows_;
+
+    // A disassembly inserts its rows in order, so each is inserted after the last one, which the
+    // hint makes take constant time.
+    auto i = rows.end();
+    if (!rows.empty() && rows.rbegin()->end_address() > row.address) {
+        // Remove the rows that intersect the inserted row, which begin after the row before it
+        // ends and before the row ends.
+        i = rows.lower_bound(std::size_t{row.address});
+        if (i != rows.begin() && intersects(*std::prev(i), row)) {
+            --i;
+        }
+        while (i != rows.end() && i->address < row.end_address()) {
+            i = table.erase(i);
+        }
     }
 
+    i = rows.emplace_hint(i, row);
+    if (row.label != no_label) {
+        table.labeled_rows_.emplace(row.label, row.address);
+    }
     return i;
 }
 
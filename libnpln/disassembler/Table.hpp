@@ -15,25 +15,143 @@
 #ifndef LIBNPLN_DISASSEMBLER_TABLE_HPP
 #define LIBNPLN_DISASSEMBLER_TABLE_HPP
 
+#include <libnpln/disassembler/LabelArena.hpp>
 #include <libnpln/disassembler/Row.hpp>
 #include <libnpln/machine/DataUnits.hpp>
 
+#include <cstddef>
+#include <initializer_list>
+#include <set>
 #include <string_view>
-#include <vector>
+#include <unordered_map>
+#include <utility>
 
 namespace libnpln::disassembler {
 
-using Table = std::vector<Row>;
+// The rows of a disassembly in the order of their addresses, none of which intersect.  The rows
+// are kept in a tree ordered by their first addresses, so that finding the row that spans an
+// address and inserting a row in place of those that it intersects take logarithmic time, and
+// inserting a row after the last one takes constant time.  The rows are also indexed by their
+// labels, so that finding a label takes constant time.  The labels of the rows are interned by the
+// table, and each row holds the identifier of its label, which is only meaningful to its table.
+//
+// The iterators are bidirectional, and the rows cannot be modified through them, as the order and
+// the index of labels depend on them.
+class Table
+{
+    // Orders rows by their first addresses, which are unique as the rows do not intersect.
+    struct ByAddress
+    {
+        using is_transparent = void;
+
+        constexpr auto operator()(Row const& lhs, Row const& rhs) const noexcept -> bool
+        {
+            return lhs.address < rhs.address;
+        }
+        constexpr auto operator()(Row const& lhs, std::size_t const rhs) const noexcept -> bool
+        {
+            return lhs.address < rhs;
+        }
+        constexpr auto operator()(std::size_t const lhs, Row const& rhs) const noexcept -> bool
+        {
+            return lhs < rhs.address;
+        }
+    };
+
+    using Rows = std::set<Row, ByAddress>;
+
+public:
+    using value_type = Row;
+    using size_type = Rows::size_type;
+    using difference_type = Rows::difference_type;
+    using reference = Row const&;
+    using const_reference = Row const&;
+    using iterator = Rows::const_iterator;
+    using const_iterator = Rows::const_iterator;
+
+    Table() = default;
+    Table(std::initializer_list<Row> rows);
+    Table(std::initializer_list<std::pair<Row, std::string_view>> labeled_rows);
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator
+    {
+        return rows_.begin();
+    }
+    [[nodiscard]] auto end() const noexcept -> const_iterator
+    {
+        return rows_.end();
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return rows_.empty();
+    }
+    [[nodiscard]] auto size() const noexcept -> size_type
+    {
+        return rows_.size();
+    }
+
+    [[nodiscard]] auto front() const -> Row const&
+    {
+        return *rows_.begin();
+    }
+    [[nodiscard]] auto back() const -> Row const&
+    {
+        return *rows_.rbegin();
+    }
+
+    auto clear() noexcept -> void;
+
+    // Returns the identifier of a label for the rows of this table, interning it if it is new.
+    auto intern(std::string_view const label) -> LabelId
+    {
+        return labels_.intern(label);
+    }
+
+    [[nodiscard]] auto label(Row const& row) const -> std::string_view
+    {
+        return labels_.get(row.label);
+    }
+
+    [[nodiscard]] auto labels() const noexcept -> LabelArena const&
+    {
+        return labels_;
+    }
+
+    friend auto operator==(Table const& lhs, Table const& rhs) -> bool;
+
+    friend auto find_address(Table const& table, machine::Address addr) -> const_iterator;
+    friend auto find_label(Table const& table, std::string_view label) -> const_iterator;
+    friend auto insert_row(Table& table, Row const& row) -> iterator;
+
+private:
+    // Removes a row and its entry in the index of labels.
+    auto erase(Rows::const_iterator i) -> Rows::const_iterator;
+
+    Rows rows_;
+    LabelArena labels_;
+    // The first address of each labeled row by its label.  Unlabeled rows are not indexed.
+    std::unordered_multimap<LabelId, machine::Address> labeled_rows_;
+};
+
+inline auto operator!=(Table const& lhs, Table const& rhs) -> bool
+{
+    return !(lhs == rhs);
+}
 
 auto find_address(Table const& table, machine::Address addr) -> Table::const_iterator;
-auto find_address(Table& table, machine::Address addr) -> Table::iterator;
 
+// Returns the first row with the label.
 auto find_label(Table const& table, std::string_view label) -> Table::const_iterator;
-auto find_label(Table& table, std::string_view label) -> Table::iterator;
 
+// Inserts a row in place of every row that it intersects.  The label of the row must have been
+// interned by the table.
 auto insert_row(Table& table, Row const& row) -> Table::iterator;
 auto insert_row(Table& table, Row&& row) -> Table::iterator;
 
+// Inserts a row in place of every row that it intersects, with a label interned by the table.
+auto insert_row(Table& table, Row row, std::string_view label) -> Table::iterator;
+
 } // namespace libnpln::disassembler
 
 #endif
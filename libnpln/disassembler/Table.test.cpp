@@ -18,6 +18,9 @@
 
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <iterator>
+
 using namespace libnpln;
 using namespace libnpln::disassembler;
 
@@ -49,7 +52,7 @@ TEST_CASE("Table can find by unaligned address", "[disassembler][table]")
     };
 
     for (auto&& r : t) {
-        if (!std::holds_alternative<machine::Instruction>(r.data)) {
+        if (r.kind != Row::Kind::instruction) {
             continue;
         }
 
@@ -78,14 +81,14 @@ TEST_CASE("Table cannot find by non-existent address", "[disassembler][table]")
 TEST_CASE("Table can find by label", "[disassembler][table]")
 {
     auto const t = Table{
-        Row{0x200, machine::Instruction::decode(0x00E0).value(), "foo"},
-        Row{0x202, machine::Byte{0xAA}, "bar"},
-        Row{0x203, machine::Byte{0x55}, "baz"},
-        Row{0x300, machine::Instruction::decode(0x00EE).value(), "qux"},
+        {Row{0x200, machine::Instruction::decode(0x00E0).value()}, "foo"},
+        {Row{0x202, machine::Byte{0xAA}}, "bar"},
+        {Row{0x203, machine::Byte{0x55}}, "baz"},
+        {Row{0x300, machine::Instruction::decode(0x00EE).value()}, "qux"},
     };
 
     for (auto&& r : t) {
-        auto const i = find_label(t, r.label);
+        auto const i = find_label(t, t.label(r));
         REQUIRE(i != std::end(t));
         REQUIRE(*i == r);
     }
@@ -94,10 +97,10 @@ TEST_CASE("Table can find by label", "[disassembler][table]")
 TEST_CASE("Table cannot find by non-existent label", "[disassembler][table]")
 {
     auto const t = Table{
-        Row{0x200, machine::Instruction::decode(0x00E0).value(), "foo"},
-        Row{0x202, machine::Byte{0xAA}, "bar"},
-        Row{0x203, machine::Byte{0x55}, "baz"},
-        Row{0x300, machine::Instruction::decode(0x00EE).value(), "qux"},
+        {Row{0x200, machine::Instruction::decode(0x00E0).value()}, "foo"},
+        {Row{0x202, machine::Byte{0xAA}}, "bar"},
+        {Row{0x203, machine::Byte{0x55}}, "baz"},
+        {Row{0x300, machine::Instruction::decode(0x00EE).value()}, "qux"},
     };
 
     REQUIRE(find_label(t, "") == std::end(t));
@@ -108,15 +111,15 @@ TEST_CASE("Table cannot find by non-existent label", "[disassembler][table]")
 TEST_CASE("Table returns first matching label", "[disassembler][table]")
 {
     auto const t = Table{
-        Row{0x200, machine::Instruction::decode(0x00E0).value(), "foo"},
-        Row{0x202, machine::Byte{0xAA}, "bar"},
-        Row{0x203, machine::Byte{0x55}, "baz"},
-        Row{0x300, machine::Instruction::decode(0x00EE).value(), "foo"},
+        {Row{0x200, machine::Instruction::decode(0x00E0).value()}, "foo"},
+        {Row{0x202, machine::Byte{0xAA}}, "bar"},
+        {Row{0x203, machine::Byte{0x55}}, "baz"},
+        {Row{0x300, machine::Instruction::decode(0x00EE).value()}, "foo"},
     };
 
     auto const i = find_label(t, "foo");
     REQUIRE(i != std::end(t));
-    REQUIRE(t[0] == *i);
+    REQUIRE(t.front() == *i);
 }
 
 TEST_CASE("Table insertion creates rows at new addresses", "[disassembler][table]")
@@ -184,11 +187,7 @@ TEST_CASE("Table insertion does not create conflicts", "[disassembler][table]")
 
 TEST_CASE("Table insertion preserves ordering", "[disassembler][table]")
 {
-    auto is_sorted = [](auto const& t0) {
-        auto t1 = t0;
-        std::sort(std::begin(t1), std::end(t1));
-        return t0 == t1;
-    };
+    auto is_sorted = [](auto const& t) { return std::is_sorted(std::begin(t), std::end(t)); };
 
     auto t = Table{
         Row{0x200, machine::Instruction::decode(0x00E0).value(), {}},
@@ -211,3 +210,52 @@ TEST_CASE("Table insertion preserves ordering", "[disassembler][table]")
     insert_row(t, Row{0x400, machine::Byte{0x33}, {}});
     REQUIRE(is_sorted(t));
 }
+
+TEST_CASE("Table insertion orders rows inserted out of order", "[disassembler][table]")
+{
+    auto t = Table{};
+    for (auto const a : {0x300, 0x200, 0x280, 0x202, 0x2FF}) {
+        insert_row(t, Row{static_cast<machine::Address>(a), machine::Byte{0xAA}, {}});
+    }
+
+    REQUIRE(t.size() == 5);
+    REQUIRE(std::is_sorted(std::begin(t), std::end(t)));
+    REQUIRE(t.front().address == 0x200);
+    REQUIRE(std::next(std::begin(t), 2)->address == 0x280);
+    REQUIRE(t.back().address == 0x300);
+    REQUIRE(std::distance(std::begin(t), std::end(t)) == 5);
+    REQUIRE(std::prev(std::end(t), 2)->address == 0x2FF);
+}
+
+TEST_CASE("Table insertion replaces labels of overwritten rows", "[disassembler][table]")
+{
+    auto t = Table{
+        {Row{0x200, machine::Instruction::decode(0x00E0).value()}, "foo"},
+        {Row{0x202, machine::Byte{0xAA}}, "bar"},
+        {Row{0x203, machine::Byte{0x55}}, "baz"},
+    };
+
+    insert_row(t, Row{0x201, machine::Instruction::decode(0x00EE).value()}, "qux");
+    REQUIRE(find_label(t, "foo") == std::end(t));
+    REQUIRE(find_label(t, "bar") == std::end(t));
+    REQUIRE(find_label(t, "baz") != std::end(t));
+    REQUIRE(find_label(t, "qux") == find_address(t, 0x201));
+}
+
+TEST_CASE("Table copies keep labels", "[disassembler][table]")
+{
+    auto t0 = Table{
+        {Row{0x200, machine::Instruction::decode(0x00E0).value()}, "foo"},
+        {Row{0x202, machine::Byte{0xAA}}, "bar"},
+    };
+    auto const t1 = t0;
+    t0.clear();
+
+    REQUIRE(t1.label(t1.front()) == "foo");
+    REQUIRE(t1.label(t1.back()) == "bar");
+    REQUIRE(find_label(t1, "bar") == find_address(t1, 0x202));
+    REQUIRE(t1 == Table{
+        {Row{0x200, machine::Instruction::decode(0x00E0).value()}, "foo"},
+        {Row{0x202, machine::Byte{0xAA}}, "bar"},
+    });
+}
@@ -0,0 +1,66 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/disassembler/TextRenderer.hpp>
+
+#include <iterator>
+#include <optional>
+
+namespace libnpln::disassembler {
+
+auto TextRenderer::render(
+    Row const& row, std::string_view const label, fmt::memory_buffer& out) const -> void
+{
+    if ((columns_ & Column::label) && !label.empty()) {
+        fmt::format_to(std::back_inserter(out), "{}:\n", label);
+    }
+
+    // The columns are separated by two spaces, and padded only when another column follows them.
+    auto const address = static_cast<bool>(columns_ & Column::address);
+    auto const opcode = static_cast<bool>(columns_ & Column::opcode);
+    auto const instruction = static_cast<bool>(columns_ & Column::instruction);
+    if (!address && !opcode && !instruction) {
+        return;
+    }
+
+    auto const separator = std::string_view{"  "};
+    if (address) {
+        fmt::format_to(std::back_inserter(out), "{:04X}", row.address);
+        if (opcode || instruction) {
+            out.append(separator);
+        }
+    }
+    if (opcode) {
+        if (row.kind == Row::Kind::instruction) {
+            fmt::format_to(std::back_inserter(out), "{:04X}", row.word);
+        }
+        else {
+            fmt::format_to(std::back_inserter(out), instruction ? "{:02X}  " : "{:02X}", row.word);
+        }
+        if (instruction) {
+            out.append(separator);
+        }
+    }
+    if (instruction) {
+        if (auto const i = row.instruction(); i != std::nullopt) {
+            fmt::format_to(std::back_inserter(out), "{}", *i);
+        }
+        else {
+            fmt::format_to(std::back_inserter(out), "DB ${:02X}h", row.word);
+        }
+    }
+    out.push_back('\n');
+}
+
+} // namespace libnpln::disassembler
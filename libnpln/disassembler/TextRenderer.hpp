@@ -0,0 +1,52 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_DISASSEMBLER_TEXTRENDERER_HPP
+#define LIBNPLN_DISASSEMBLER_TEXTRENDERER_HPP
+
+#include <libnpln/disassembler/Column.hpp>
+#include <libnpln/disassembler/Row.hpp>
+
+#include <flags/flags.hpp>
+#include <fmt/format.h>
+
+#include <string_view>
+
+namespace libnpln::disassembler {
+
+// Renders the rows of a disassembly as lines of a listing.  A labeled row is preceded by a line
+// holding its label, and is followed by its address, opcode, and instruction, each only if its
+// column is included.  The lines are appended to a buffer, so that a listing may be written in
+// pieces of any size as it is rendered.
+class TextRenderer
+{
+public:
+    explicit TextRenderer(flags::flags<Column> columns = all_columns) noexcept
+        : columns_{columns}
+    {}
+
+    [[nodiscard]] auto columns() const noexcept -> flags::flags<Column>
+    {
+        return columns_;
+    }
+
+    auto render(Row const& row, std::string_view label, fmt::memory_buffer& out) const -> void;
+
+private:
+    flags::flags<Column> columns_;
+};
+
+} // namespace libnpln::disassembler
+
+#endif
@@ -0,0 +1,63 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/disassembler/TextRenderer.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+
+using namespace libnpln;
+using namespace libnpln::disassembler;
+
+namespace {
+
+auto render(TextRenderer const& renderer, Row const& row, std::string_view const label = {})
+    -> std::string
+{
+    auto out = fmt::memory_buffer{};
+    renderer.render(row, label, out);
+    return fmt::to_string(out);
+}
+
+auto const instruction_row = Row{0x200, machine::Instruction::decode(0x12FE).value()};
+auto const byte_row = Row{0x202, machine::Byte{0xAA}};
+
+} // namespace
+
+TEST_CASE("TextRenderer renders every column", "[disassembler][text_renderer]")
+{
+    auto const renderer = TextRenderer{};
+    REQUIRE(render(renderer, instruction_row, "start") == "start:\n0200  12FE  JMP 2FEh\n");
+    REQUIRE(render(renderer, byte_row) == "0202  AA    DB $AAh\n");
+}
+
+TEST_CASE("TextRenderer omits excluded columns", "[disassembler][text_renderer]")
+{
+    REQUIRE(render(TextRenderer{Column::instruction}, instruction_row) == "JMP 2FEh\n");
+    REQUIRE(render(TextRenderer{Column::address | Column::opcode}, byte_row) == "0202  AA\n");
+    REQUIRE(render(TextRenderer{Column::label}, instruction_row, "start") == "start:\n");
+    REQUIRE(render(TextRenderer{Column::label}, byte_row).empty());
+    REQUIRE(render(TextRenderer{no_columns}, instruction_row).empty());
+}
+
+TEST_CASE("TextRenderer appends to its buffer", "[disassembler][text_renderer]")
+{
+    auto const renderer = TextRenderer{Column::address | Column::instruction};
+    auto out = fmt::memory_buffer{};
+    renderer.render(instruction_row, "start", out);
+    renderer.render(byte_row, {}, out);
+    REQUIRE(fmt::to_string(out) == "0200  JMP 2FEh\n0202  DB $AAh\n");
+}
@@ -0,0 +1,126 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/executor/Executor.hpp>
+
+#include <libnpln/utility/WorkStealingDeque.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace libnpln::executor {
+
+Executor::Executor(std::size_t const thread_count, std::size_t const cycle_slice)
+    : thread_count_(thread_count != 0
+            ? thread_count
+            : std::max<std::size_t>(1, std::thread::hardware_concurrency()))
+    , cycle_slice_(std::max<std::size_t>(1, cycle_slice))
+{}
+
+auto Executor::run(std::vector<Job> jobs, ResultHandler const& handle_result) const -> void
+{
+    struct Task
+    {
+        std::size_t index;
+        Job job;
+    };
+
+    auto const worker_count = std::max<std::size_t>(1, std::min(thread_count_, jobs.size()));
+    std::vector<utility::WorkStealingDeque<Task>> queues(worker_count);
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        queues[i % worker_count].push(Task{i, std::move(jobs[i])});
+    }
+
+    std::atomic<std::size_t> remaining{jobs.size()};
+    std::atomic<bool> failed{false};
+    std::mutex result_mutex;
+    std::exception_ptr error;
+
+    // Workers that find no task wait until a task is deferred or a job completes, rather than
+    // spinning while the remaining tasks run on other workers.  The version is only changed while
+    // the mutex is held, so that a worker cannot miss a change between searching and waiting.
+    std::mutex idle_mutex;
+    std::condition_variable work_changed;
+    std::atomic<std::size_t> work_version{0};
+    auto const notify_workers = [&]() {
+        {
+            auto const lock = std::lock_guard{idle_mutex};
+            work_version.fetch_add(1);
+        }
+        work_changed.notify_all();
+    };
+
+    auto const work = [&](std::size_t const w) {
+        auto& queue = queues[w];
+        while (remaining.load(std::memory_order_acquire) > 0
+            && !failed.load(std::memory_order_relaxed)) {
+            auto const version = work_version.load();
+            auto task = queue.pop();
+            for (std::size_t k = 1; task == std::nullopt && k < worker_count; ++k) {
+                task = queues[(w + k) % worker_count].steal();
+            }
+            if (task == std::nullopt) {
+                // The remaining tasks are running on other workers.
+                auto lock = std::unique_lock{idle_mutex};
+                work_changed.wait(lock, [&] { return work_version.load() != version; });
+                continue;
+            }
+
+            try {
+                auto const result = task->job.run(cycle_slice_);
+                if (result == std::nullopt) {
+                    queue.defer(std::move(*task));
+                    notify_workers();
+                    continue;
+                }
+
+                auto const lock = std::lock_guard{result_mutex};
+                handle_result(JobResult{task->index, *result, std::move(task->job.machine())});
+                remaining.fetch_sub(1, std::memory_order_release);
+            }
+            catch (...) {
+                auto const lock = std::lock_guard{result_mutex};
+                if (error == nullptr) {
+                    error = std::current_exception();
+                }
+                failed.store(true, std::memory_order_relaxed);
+            }
+
+            // The job completed or failed, either of which may let the waiting workers stop.
+            notify_workers();
+        }
+    };
+
+    // The calling thread is one of the workers.
+    std::vector<std::thread> threads;
+    threads.reserve(worker_count - 1);
+    for (std::size_t w = 1; w < worker_count; ++w) {
+        threads.emplace_back(work, w);
+    }
+    work(0);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace libnpln::executor
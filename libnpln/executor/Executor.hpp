@@ -0,0 +1,71 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_EXECUTOR_EXECUTOR_HPP
+#define LIBNPLN_EXECUTOR_EXECUTOR_HPP
+
+#include <libnpln/executor/Job.hpp>
+#include <libnpln/machine/Machine.hpp>
+#include <libnpln/machine/RunResult.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace libnpln::executor {
+
+struct JobResult
+{
+    // The position of the job in the jobs that were run.
+    std::size_t index;
+    machine::RunResult result;
+    machine::Machine machine;
+};
+
+// Runs many independent jobs in parallel on a pool of worker threads.  Each worker runs jobs from
+// its own queue and steals from the others when its queue is empty.  Jobs run in slices of cycles,
+// after which they go to the back of the queue, so that long jobs do not delay short ones.
+class Executor
+{
+public:
+    using ResultHandler = std::function<auto(JobResult&&)->void>;
+
+    static constexpr std::size_t default_cycle_slice = 100'000;
+
+    // A thread count of zero uses one thread per hardware thread.
+    explicit Executor(std::size_t thread_count = 0, std::size_t cycle_slice = default_cycle_slice);
+
+    // Runs every job to completion, handing each result to the handler as soon as its job
+    // completes.  Calls to the handler are never concurrent.  If a job or the handler throws, the
+    // remaining jobs are abandoned and the first exception is rethrown.
+    auto run(std::vector<Job> jobs, ResultHandler const& handle_result) const -> void;
+
+    [[nodiscard]] auto thread_count() const noexcept -> std::size_t
+    {
+        return thread_count_;
+    }
+
+    [[nodiscard]] auto cycle_slice() const noexcept -> std::size_t
+    {
+        return cycle_slice_;
+    }
+
+private:
+    std::size_t thread_count_;
+    std::size_t cycle_slice_;
+};
+
+} // namespace libnpln::executor
+
+#endif
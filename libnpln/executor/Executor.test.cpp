@@ -0,0 +1,93 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/executor/Executor.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+using namespace libnpln::executor;
+using namespace libnpln::machine;
+
+namespace {
+
+// Counts in V1 up to a limit that depends on the job, then faults on an invalid instruction.
+auto create_job(std::size_t const index) -> Job
+{
+    auto const limit = static_cast<Byte>(index % 200);
+
+    Machine m{Backend::threaded};
+    load_into_memory<Machine::program_address>(
+        {
+            0x71, 0x01, // ADD %V1, $01h
+            0x31, limit, // SEQ %V1, limit
+            0x12, 0x00, // JMP 200h
+            0x00, 0x00, // Invalid
+        },
+        m.memory());
+    return Job{std::move(m), InputScript{}, 1'000};
+}
+
+} // namespace
+
+TEST_CASE("Executor reports each job once", "[executor][executor]")
+{
+    auto const thread_count = GENERATE(as<std::size_t>{}, 1, 2, 4);
+    auto const cycle_slice = GENERATE(as<std::size_t>{}, 1, 7, Executor::default_cycle_slice);
+    constexpr std::size_t job_count = 500;
+
+    auto jobs = std::vector<Job>{};
+    for (std::size_t i = 0; i < job_count; ++i) {
+        jobs.push_back(create_job(i));
+    }
+
+    auto results = std::vector<std::optional<JobResult>>(job_count);
+    Executor{thread_count, cycle_slice}.run(std::move(jobs), [&](JobResult&& r) {
+        REQUIRE(r.index < job_count);
+        REQUIRE(results[r.index] == std::nullopt);
+        results[r.index] = std::move(r);
+    });
+
+    for (std::size_t i = 0; i < job_count; ++i) {
+        auto expect = create_job(i);
+        auto const result_expect = expect.run(expect.cycle_budget());
+
+        REQUIRE(results[i] != std::nullopt);
+        REQUIRE(results[i]->result == result_expect);
+        REQUIRE(results[i]->machine == expect.machine());
+    }
+}
+
+TEST_CASE("Executor can run no jobs", "[executor][executor]")
+{
+    std::size_t count = 0;
+    Executor{}.run({}, [&](JobResult&&) { ++count; });
+    REQUIRE(count == 0);
+}
+
+TEST_CASE("Executor rethrows exceptions from the handler", "[executor][executor]")
+{
+    auto jobs = std::vector<Job>{};
+    for (std::size_t i = 0; i < 100; ++i) {
+        jobs.push_back(create_job(i));
+    }
+
+    REQUIRE_THROWS_AS(Executor{4}.run(std::move(jobs),
+                          [](JobResult&&) { throw std::runtime_error{"handler"}; }),
+        std::runtime_error);
+}
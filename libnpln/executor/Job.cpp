@@ -0,0 +1,56 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/executor/Job.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace libnpln::executor {
+
+Job::Job(machine::Machine machine, machine::InputScript script, std::size_t const cycle_budget)
+    : machine_(std::move(machine)), script_(std::move(script)), cycle_budget_(cycle_budget)
+{}
+
+auto Job::run(std::size_t const cycle_slice) -> std::optional<machine::RunResult>
+{
+    using namespace machine;
+
+    // Run in segments between the key events, so that each event happens at its exact cycle.
+    auto const slice_end = cycle_slice < cycle_budget_ - cycles_ ? cycles_ + cycle_slice
+                                                                 : cycle_budget_;
+    while (cycles_ < slice_end) {
+        for (; next_event_ < script_.size() && script_[next_event_].cycle <= cycles_;
+             ++next_event_) {
+            auto const& event = script_[next_event_];
+            machine_.keys().set(to_index(event.key), event.pressed);
+        }
+
+        auto const segment_end = next_event_ < script_.size()
+            ? std::min(script_[next_event_].cycle, slice_end)
+            : slice_end;
+        auto const segment = machine_.run(segment_end - cycles_, no_stop_reasons);
+        cycles_ += segment.cycles;
+        if (segment.reason == StopReason::fault) {
+            return RunResult{StopReason::fault, cycles_};
+        }
+    }
+
+    if (cycles_ == cycle_budget_) {
+        return RunResult{StopReason::budget_exhausted, cycles_};
+    }
+    return std::nullopt;
+}
+
+} // namespace libnpln::executor
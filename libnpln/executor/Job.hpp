@@ -0,0 +1,67 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_EXECUTOR_JOB_HPP
+#define LIBNPLN_EXECUTOR_JOB_HPP
+
+#include <libnpln/machine/InputScript.hpp>
+#include <libnpln/machine/Machine.hpp>
+#include <libnpln/machine/RunResult.hpp>
+
+#include <cstddef>
+#include <optional>
+
+namespace libnpln::executor {
+
+// A machine to run for a budget of cycles while replaying an input script to it.  The job may be
+// run in slices of any number of cycles with the same result as running it all at once.
+class Job
+{
+public:
+    Job(machine::Machine machine, machine::InputScript script, std::size_t cycle_budget);
+
+    // Runs for at most the given number of cycles, applying each key event at its cycle.  Returns
+    // the result of the whole job once its budget is exhausted or the machine faults.
+    auto run(std::size_t cycle_slice) -> std::optional<machine::RunResult>;
+
+    auto machine() noexcept -> machine::Machine&
+    {
+        return machine_;
+    }
+    [[nodiscard]] auto machine() const noexcept -> machine::Machine const&
+    {
+        return machine_;
+    }
+
+    [[nodiscard]] auto cycles() const noexcept -> std::size_t
+    {
+        return cycles_;
+    }
+
+    [[nodiscard]] auto cycle_budget() const noexcept -> std::size_t
+    {
+        return cycle_budget_;
+    }
+
+private:
+    machine::Machine machine_;
+    machine::InputScript script_;
+    std::size_t cycle_budget_;
+    std::size_t cycles_ = 0;
+    std::size_t next_event_ = 0;
+};
+
+} // namespace libnpln::executor
+
+#endif
@@ -0,0 +1,119 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/executor/Job.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <optional>
+
+using namespace libnpln::executor;
+using namespace libnpln::machine;
+
+template<>
+struct Catch::StringMaker<Machine>
+{
+    static auto convert(Machine const& m)
+    {
+        return fmt::to_string(m);
+    }
+};
+
+namespace {
+
+// Counts in V1 the iterations of a loop during which key 0 is held.
+auto create_counter(Backend const backend) -> Machine
+{
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x60, 0x00, // MOV %V0, $00h
+            0xE0, 0x9E, // SKP %V0
+            0x12, 0x02, // JMP 202h
+            0x71, 0x01, // ADD %V1, $01h
+            0x12, 0x02, // JMP 202h
+        },
+        m.memory());
+    return m;
+}
+
+auto const counter_script = InputScript{
+    KeyEvent{10, Key::k0, true},
+    KeyEvent{25, Key::k0, false},
+    KeyEvent{40, Key::k0, true},
+};
+
+} // namespace
+
+TEST_CASE("Jobs apply key events at their cycles", "[executor][job]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+    constexpr std::size_t budget = 100;
+
+    auto m_expect = create_counter(backend);
+    auto event = counter_script.begin();
+    for (std::size_t cycle = 0; cycle < budget; ++cycle) {
+        for (; event != counter_script.end() && event->cycle == cycle; ++event) {
+            m_expect.keys().set(to_index(event->key), event->pressed);
+        }
+        REQUIRE(m_expect.cycle());
+    }
+
+    auto job = Job{create_counter(backend), counter_script, budget};
+    REQUIRE(job.run(budget) == RunResult{StopReason::budget_exhausted, budget});
+    REQUIRE(job.cycles() == budget);
+    REQUIRE(job.machine() == m_expect);
+}
+
+TEST_CASE("Jobs run in slices are equivalent to running at once", "[executor][job]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+    auto const slice = GENERATE(range<std::size_t>(1, 8), 33);
+    constexpr std::size_t budget = 100;
+
+    auto whole = Job{create_counter(backend), counter_script, budget};
+    REQUIRE(whole.run(budget) == RunResult{StopReason::budget_exhausted, budget});
+
+    auto sliced = Job{create_counter(backend), counter_script, budget};
+    auto result = std::optional<RunResult>{};
+    std::size_t runs = 0;
+    while (result == std::nullopt) {
+        result = sliced.run(slice);
+        ++runs;
+        REQUIRE(sliced.cycles() == std::min(runs * slice, budget));
+    }
+
+    REQUIRE(result == RunResult{StopReason::budget_exhausted, budget});
+    REQUIRE(runs == (budget + slice - 1) / slice);
+    REQUIRE(sliced.machine() == whole.machine());
+}
+
+TEST_CASE("Jobs finish when the machine faults", "[executor][job]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x60, 0x00, // MOV %V0, $00h
+            0x00, 0x00, // Invalid
+        },
+        m.memory());
+
+    auto job = Job{std::move(m), InputScript{}, 100};
+    REQUIRE(job.run(1) == std::nullopt);
+    REQUIRE(job.run(10) == RunResult{StopReason::fault, 1});
+    REQUIRE(job.machine().fault() != std::nullopt);
+}
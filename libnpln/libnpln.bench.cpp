@@ -0,0 +1,50 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/libnpln.bench.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace libnpln::bench {
+
+auto get_roms() -> std::vector<Rom> const&
+{
+    static auto const roms = []() {
+        std::vector<Rom> roms;
+        std::error_code error;
+        for (auto const& entry : std::filesystem::directory_iterator{NPLN_ROM_DIRECTORY, error}) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+
+            std::ifstream s{entry.path(), std::ios::binary};
+            roms.push_back({entry.path().filename().string(),
+                {std::istreambuf_iterator<char>{s}, std::istreambuf_iterator<char>{}}});
+        }
+
+        std::sort(std::begin(roms), std::end(roms),
+            [](Rom const& lhs, Rom const& rhs) { return lhs.name < rhs.name; });
+        return roms;
+    }();
+    return roms;
+}
+
+} // namespace libnpln::bench
+
+BENCHMARK_MAIN();
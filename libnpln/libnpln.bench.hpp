@@ -0,0 +1,37 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_LIBNPLN_BENCH_HPP
+#define LIBNPLN_LIBNPLN_BENCH_HPP
+
+#include <libnpln/machine/DataUnits.hpp>
+
+#include <string>
+#include <vector>
+
+namespace libnpln::bench {
+
+struct Rom
+{
+    std::string name;
+    std::vector<machine::Byte> program;
+};
+
+// Returns the programs in the ROM directory that the benchmarks were built with, in the order of
+// their names, loading them on the first call.
+auto get_roms() -> std::vector<Rom> const&;
+
+} // namespace libnpln::bench
+
+#endif
@@ -0,0 +1,73 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_BACKEND_HPP
+#define LIBNPLN_MACHINE_BACKEND_HPP
+
+#include <fmt/format.h>
+
+#include <array>
+#include <stdexcept>
+#include <string_view>
+
+namespace libnpln::machine {
+
+// The interpreter cores that a machine can execute instructions with.  Every backend has identical
+// semantics; they differ only in how instructions are dispatched to their handlers.
+enum class Backend
+{
+    // Dispatches each decoded instruction through a switch over its operator.
+    switched,
+    // Dispatches each instruction through a table of handlers indexed by its operator identifier,
+    // jumping directly from one handler to the next where the compiler supports computed goto.
+    threaded,
+    // Executes straight-line runs of instructions that only operate on the registers as compiled
+    // blocks, and interprets the instructions between them with the threaded backend.
+    compiled,
+};
+
+// Every backend, in the order of declaration.
+constexpr std::array<Backend, 3> backends = {
+    Backend::switched, Backend::threaded, Backend::compiled};
+
+constexpr auto get_name(Backend const b) -> std::string_view
+{
+    switch (b) {
+    case Backend::switched: return "switched";
+    case Backend::threaded: return "threaded";
+    case Backend::compiled: return "compiled";
+    }
+
+    throw std::out_of_range("Unknown Backend in get_name");
+}
+
+} // namespace libnpln::machine
+
+template<>
+struct fmt::formatter<libnpln::machine::Backend>
+{
+    template<typename ParseContext>
+    constexpr auto parse(ParseContext& context)
+    {
+        return context.begin();
+    }
+
+    template<typename FormatContext>
+    auto format(libnpln::machine::Backend const& value, FormatContext& context)
+    {
+        return format_to(context.out(), "{}", libnpln::machine::get_name(value));
+    }
+};
+
+#endif
@@ -0,0 +1,52 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Backend.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace libnpln::machine;
+
+TEST_CASE("Backends define names", "[machine][backend]")
+{
+    REQUIRE(get_name(Backend::switched) == "switched");
+    REQUIRE(get_name(Backend::threaded) == "threaded");
+    REQUIRE(get_name(Backend::compiled) == "compiled");
+}
+
+TEST_CASE("Backends are all listed once", "[machine][backend]")
+{
+    REQUIRE(backends.size() == 3);
+    for (std::size_t i = 0; i < backends.size(); ++i) {
+        REQUIRE(static_cast<std::size_t>(backends.at(i)) == i);
+    }
+}
+
+TEST_CASE("Unknown Backends do not define names", "[machine][backend]")
+{
+    auto const invalid_backend =
+        static_cast<Backend>(std::numeric_limits<std::underlying_type_t<Backend>>::max());
+    REQUIRE_THROWS_AS(get_name(invalid_backend), std::out_of_range);
+}
+
+TEST_CASE("Backend returns its name when formatted", "[machine][backend]")
+{
+    REQUIRE(fmt::format("{}", Backend::switched) == get_name(Backend::switched));
+    REQUIRE(fmt::format("{}", Backend::threaded) == get_name(Backend::threaded));
+    REQUIRE(fmt::format("{}", Backend::compiled) == get_name(Backend::compiled));
+}
@@ -0,0 +1,764 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Batch.hpp>
+
+#include <libnpln/detail/cpp2b.hpp>
+#include <libnpln/machine/Font.hpp>
+#include <libnpln/utility/Numeric.hpp>
+
+#include <gsl/gsl>
+
+#include <algorithm>
+#include <stdexcept>
+#include <variant>
+
+namespace libnpln::machine {
+
+namespace {
+
+constexpr auto width = static_cast<Address>(Instruction::width);
+
+// Selects between the values for a selected and an unselected lane without branching, so that
+// loops over lanes can be vectorized.
+template<typename T>
+constexpr auto blend(std::uint8_t const selected, T const value, T const original) noexcept -> T
+{
+    return selected != 0 ? value : original;
+}
+
+} // namespace
+
+Batch::Batch(std::vector<Machine> const& machines)
+    : lane_count_(machines.size())
+    , selected_(lane_count_)
+    , faults_(lane_count_)
+    , program_counters_(lane_count_)
+    , dt_(lane_count_)
+    , st_(lane_count_)
+    , i_(lane_count_)
+    , stacks_(lane_count_)
+    , memories_(lane_count_ * memory_size)
+    , keys_(lane_count_)
+    , displays_(lane_count_)
+    , backends_(lane_count_)
+    , delay_cycles_(lane_count_)
+    , sound_cycles_(lane_count_)
+    , randoms_(lane_count_)
+{
+    for (auto& v : v_) {
+        v.resize(lane_count_);
+    }
+    if (machines.empty()) {
+        return;
+    }
+
+    auto periods = Machine{};
+    periods.master_clock_rate_ = machines.front().master_clock_rate_;
+    periods.update_timer_periods();
+    master_clock_rate_ = periods.master_clock_rate_;
+    delay_period_ = periods.delay_period_;
+    sound_period_ = periods.sound_period_;
+
+    for (std::size_t l = 0; l < lane_count_; ++l) {
+        auto const& m = machines[l];
+        if (m.master_clock_rate_ != master_clock_rate_) {
+            throw std::invalid_argument{"Machines in a Batch must have the same master clock rate"};
+        }
+
+        faults_[l] = m.fault_;
+        program_counters_[l] = m.program_counter_;
+        for (std::size_t r = 0; r < register_count; ++r) {
+            gsl::at(v_, r)[l] = m.registers_[static_cast<Register>(r)];
+        }
+        dt_[l] = m.registers_.dt;
+        st_[l] = m.registers_.st;
+        i_[l] = m.registers_.i;
+        stacks_[l] = m.stack_;
+        std::copy(std::begin(*m.memory_), std::end(*m.memory_), memory(l));
+        keys_[l] = m.keys_;
+        displays_[l] = m.display_;
+        backends_[l] = m.backend_;
+
+        // As in Machine::update_timer_periods, for counters last computed at another rate.
+        auto const current = m.timer_periods_clock_rate_ == master_clock_rate_;
+        delay_cycles_[l] = current ? m.delay_cycles : std::min(m.delay_cycles, delay_period_ - 1);
+        sound_cycles_[l] = current ? m.sound_cycles : std::min(m.sound_cycles, sound_period_ - 1);
+        randoms_[l] = m.random_;
+    }
+}
+
+auto Batch::lane(std::size_t const l) const -> Machine
+{
+    Machine m{backends_.at(l)};
+    m.fault_ = faults_[l];
+    m.program_counter_ = program_counters_[l];
+    for (std::size_t r = 0; r < register_count; ++r) {
+        m.registers_[static_cast<Register>(r)] = gsl::at(v_, r)[l];
+    }
+    m.registers_.dt = dt_[l];
+    m.registers_.st = st_[l];
+    m.registers_.i = i_[l];
+    m.stack_ = stacks_[l];
+    auto const* const lane_memory = memories_.data() + l * memory_size;
+    std::copy(lane_memory, lane_memory + memory_size, std::begin(m.memory()));
+    m.keys_ = keys_[l];
+    m.display_ = displays_[l];
+
+    m.master_clock_rate_ = master_clock_rate_;
+    m.timer_periods_clock_rate_ = master_clock_rate_;
+    m.delay_period_ = delay_period_;
+    m.sound_period_ = sound_period_;
+    m.delay_cycles = delay_cycles_[l];
+    m.sound_cycles = sound_cycles_[l];
+    m.random_ = randoms_[l];
+    return m;
+}
+
+auto Batch::cycle() -> void
+{
+    std::fill(std::begin(selected_), std::end(selected_), std::uint8_t{0});
+    converged_lanes_ = 0;
+
+    // Every lane at the same instruction as the first running lane executes it together.
+    auto const runs = [this](std::size_t const l) {
+        return faults_[l] == std::nullopt && std::size_t{program_counters_[l]} + 1 < memory_size;
+    };
+    std::size_t leader = 0;
+    while (leader < lane_count_ && !runs(leader)) {
+        ++leader;
+    }
+
+    if (leader < lane_count_) {
+        auto const pc = program_counters_[leader];
+        auto const w = load(leader, pc);
+        auto const instr = Instruction::decode(w);
+        if (instr != std::nullopt) {
+            for (std::size_t l = 0; l < lane_count_; ++l) {
+                auto const converged = faults_[l] == std::nullopt && program_counters_[l] == pc
+                    && load(l, pc) == w;
+                selected_[l] = converged ? 1U : 0U;
+                converged_lanes_ += selected_[l];
+            }
+
+            execute(*instr, 0, lane_count_);
+            tick_timers(0, lane_count_);
+        }
+    }
+
+    // Every other lane diverged, so it executes on its own.
+    for (std::size_t l = 0; l < lane_count_; ++l) {
+        if (selected_[l] == 0 && faults_[l] == std::nullopt) {
+            selected_[l] = 1;
+            cycle_lane(l);
+        }
+    }
+}
+
+auto Batch::run(std::size_t const cycles) -> void
+{
+    for (std::size_t c = 0; c < cycles; ++c) {
+        cycle();
+    }
+}
+
+auto Batch::cycle_lane(std::size_t const l) -> void
+{
+    auto const pc = program_counters_[l];
+    if (std::size_t{pc} + 1 >= memory_size) {
+        fault(l, Fault::Type::invalid_address);
+        return;
+    }
+
+    auto const instr = Instruction::decode(load(l, pc));
+    if (instr == std::nullopt) {
+        fault(l, Fault::Type::invalid_instruction);
+        return;
+    }
+
+    execute(*instr, l, l + 1);
+    tick_timers(l, l + 1);
+}
+
+auto Batch::load(std::size_t const l, Address const a) const noexcept -> Word
+{
+    auto const* m = memories_.data() + l * memory_size;
+    return make_word(m[a], m[a + 1]); // Big-endian
+}
+
+auto Batch::memory(std::size_t const l) noexcept -> Byte*
+{
+    return memories_.data() + l * memory_size;
+}
+
+auto Batch::fault(std::size_t const l, Fault::Type const type) -> void
+{
+    faults_[l] = Fault{type, program_counters_[l]};
+    selected_[l] = 0;
+}
+
+auto Batch::v(Register const r) noexcept -> Byte*
+{
+    return v_[libnpln::detail::to_underlying(r)].data();
+}
+
+auto Batch::advance(std::size_t const first, std::size_t const last) noexcept -> void
+{
+    auto* const pc = program_counters_.data();
+    for (auto l = first; l < last; ++l) {
+        pc[l] += blend(selected_[l], width, Address{0});
+    }
+}
+
+template<typename Predicate>
+auto Batch::skip_if(std::size_t const first, std::size_t const last, Predicate const& p) -> void
+{
+    auto* const pc = program_counters_.data();
+    for (auto l = first; l < last; ++l) {
+        auto const skip = p(l) ? static_cast<Address>(2 * width) : width;
+        pc[l] += blend(selected_[l], skip, Address{0});
+    }
+}
+
+auto Batch::tick_timers(std::size_t const first, std::size_t const last) noexcept -> void
+{
+    // The counters are always less than the periods, so a lane that is not selected never
+    // reaches its period.
+    for (auto l = first; l < last; ++l) {
+        auto const delay_cycles = delay_cycles_[l] + selected_[l];
+        auto const delay_elapsed = delay_cycles >= delay_period_;
+        delay_cycles_[l] = delay_elapsed ? 0 : delay_cycles;
+        dt_[l] = static_cast<Byte>(dt_[l] - (delay_elapsed && dt_[l] > 0 ? 1 : 0));
+
+        auto const sound_cycles = sound_cycles_[l] + selected_[l];
+        auto const sound_elapsed = sound_cycles >= sound_period_;
+        sound_cycles_[l] = sound_elapsed ? 0 : sound_cycles;
+        st_[l] = static_cast<Byte>(st_[l] - (sound_elapsed && st_[l] > 0 ? 1 : 0));
+    }
+}
+
+auto Batch::execute(Instruction const& instr, std::size_t const first, std::size_t const last)
+    -> void
+{
+    switch (instr.op) {
+    case Operator::cls: return execute_cls(first, last);
+    case Operator::ret: return execute_ret(first, last);
+    case Operator::jmp_a: return execute_jmp_a(std::get<AOperands>(instr.args), first, last);
+    case Operator::call_a: return execute_call_a(std::get<AOperands>(instr.args), first, last);
+    case Operator::seq_v_b: return execute_seq_v_b(std::get<VBOperands>(instr.args), first, last);
+    case Operator::sne_v_b: return execute_sne_v_b(std::get<VBOperands>(instr.args), first, last);
+    case Operator::seq_v_v: return execute_seq_v_v(std::get<VVOperands>(instr.args), first, last);
+    case Operator::mov_v_b: return execute_mov_v_b(std::get<VBOperands>(instr.args), first, last);
+    case Operator::add_v_b: return execute_add_v_b(std::get<VBOperands>(instr.args), first, last);
+    case Operator::mov_v_v: return execute_mov_v_v(std::get<VVOperands>(instr.args), first, last);
+    case Operator::or_v_v: return execute_or_v_v(std::get<VVOperands>(instr.args), first, last);
+    case Operator::and_v_v: return execute_and_v_v(std::get<VVOperands>(instr.args), first, last);
+    case Operator::xor_v_v: return execute_xor_v_v(std::get<VVOperands>(instr.args), first, last);
+    case Operator::add_v_v: return execute_add_v_v(std::get<VVOperands>(instr.args), first, last);
+    case Operator::sub_v_v: return execute_sub_v_v(std::get<VVOperands>(instr.args), first, last);
+    case Operator::shr_v: return execute_shr_v(std::get<VOperands>(instr.args), first, last);
+    case Operator::subn_v_v:
+        return execute_subn_v_v(std::get<VVOperands>(instr.args), first, last);
+    case Operator::shl_v: return execute_shl_v(std::get<VOperands>(instr.args), first, last);
+    case Operator::sne_v_v: return execute_sne_v_v(std::get<VVOperands>(instr.args), first, last);
+    case Operator::mov_i_a: return execute_mov_i_a(std::get<AOperands>(instr.args), first, last);
+    case Operator::jmp_v0_a:
+        return execute_jmp_v0_a(std::get<AOperands>(instr.args), first, last);
+    case Operator::rnd_v_b: return execute_rnd_v_b(std::get<VBOperands>(instr.args), first, last);
+    case Operator::drw_v_v_n:
+        return execute_drw_v_v_n(std::get<VVNOperands>(instr.args), first, last);
+    case Operator::skp_v: return execute_skp_v(std::get<VOperands>(instr.args), first, last);
+    case Operator::sknp_v: return execute_sknp_v(std::get<VOperands>(instr.args), first, last);
+    case Operator::mov_v_dt: return execute_mov_v_dt(std::get<VOperands>(instr.args), first, last);
+    case Operator::wkp_v: return execute_wkp_v(std::get<VOperands>(instr.args), first, last);
+    case Operator::mov_dt_v: return execute_mov_dt_v(std::get<VOperands>(instr.args), first, last);
+    case Operator::mov_st_v: return execute_mov_st_v(std::get<VOperands>(instr.args), first, last);
+    case Operator::add_i_v: return execute_add_i_v(std::get<VOperands>(instr.args), first, last);
+    case Operator::font_v: return execute_font_v(std::get<VOperands>(instr.args), first, last);
+    case Operator::bcd_v: return execute_bcd_v(std::get<VOperands>(instr.args), first, last);
+    case Operator::mov_ii_v: return execute_mov_ii_v(std::get<VOperands>(instr.args), first, last);
+    case Operator::mov_v_ii: return execute_mov_v_ii(std::get<VOperands>(instr.args), first, last);
+    }
+
+    throw std::out_of_range("Unknown Operator in Batch::execute");
+}
+
+// Each instruction has the same effect on each selected lane as it has on a Machine, which
+// documents its corner cases.
+
+auto Batch::execute_cls(std::size_t const first, std::size_t const last) -> void
+{
+    for (auto l = first; l < last; ++l) {
+        if (selected_[l] != 0) {
+            displays_[l].clear();
+        }
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_ret(std::size_t const first, std::size_t const last) -> void
+{
+    for (auto l = first; l < last; ++l) {
+        if (selected_[l] == 0) {
+            continue;
+        }
+
+        auto const a = stacks_[l].pop();
+        if (a == std::nullopt) {
+            fault(l, Fault::Type::empty_stack);
+            continue;
+        }
+        program_counters_[l] = *a;
+    }
+}
+
+auto Batch::execute_jmp_a(AOperands const& args, std::size_t const first, std::size_t const last)
+    -> void
+{
+    auto* const pc = program_counters_.data();
+    for (auto l = first; l < last; ++l) {
+        pc[l] = blend(selected_[l], args.address, pc[l]);
+    }
+}
+
+auto Batch::execute_call_a(AOperands const& args, std::size_t const first, std::size_t const last)
+    -> void
+{
+    for (auto l = first; l < last; ++l) {
+        if (selected_[l] == 0) {
+            continue;
+        }
+
+        if (!stacks_[l].push(program_counters_[l] + width)) {
+            fault(l, Fault::Type::full_stack);
+            continue;
+        }
+        program_counters_[l] = args.address;
+    }
+}
+
+auto Batch::execute_seq_v_b(VBOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto const* const x = v(args.vx);
+    skip_if(first, last, [&](std::size_t const l) { return x[l] == args.byte; });
+}
+
+auto Batch::execute_sne_v_b(VBOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto const* const x = v(args.vx);
+    skip_if(first, last, [&](std::size_t const l) { return x[l] != args.byte; });
+}
+
+auto Batch::execute_seq_v_v(VVOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto const* const x = v(args.vx);
+    auto const* const y = v(args.vy);
+    skip_if(first, last, [&](std::size_t const l) { return x[l] == y[l]; });
+}
+
+auto Batch::execute_mov_v_b(VBOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto* const x = v(args.vx);
+    for (auto l = first; l < last; ++l) {
+        x[l] = blend(selected_[l], args.byte, x[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_add_v_b(VBOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto* const x = v(args.vx);
+    for (auto l = first; l < last; ++l) {
+        x[l] = blend(selected_[l], static_cast<Byte>(x[l] + args.byte), x[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_mov_v_v(VVOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto* const x = v(args.vx);
+    auto const* const y = v(args.vy);
+    for (auto l = first; l < last; ++l) {
+        x[l] = blend(selected_[l], y[l], x[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_or_v_v(VVOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto* const x = v(args.vx);
+    auto const* const y = v(args.vy);
+    for (auto l = first; l < last; ++l) {
+        x[l] = blend(selected_[l], static_cast<Byte>(x[l] | y[l]), x[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_and_v_v(VVOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto* const x = v(args.vx);
+    auto const* const y = v(args.vy);
+    for (auto l = first; l < last; ++l) {
+        x[l] = blend(selected_[l], static_cast<Byte>(x[l] & y[l]), x[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_xor_v_v(VVOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto* const x = v(args.vx);
+    auto const* const y = v(args.vy);
+    for (auto l = first; l < last; ++l) {
+        x[l] = blend(selected_[l], static_cast<Byte>(x[l] ^ y[l]), x[l]);
+    }
+
+    advance(first, last);
+}
+
+// As in Machine, the flag is written before the result, so that a result in VF takes precedence
+// over the flag.  The operands are read before either is written.
+
+auto Batch::execute_add_v_v(VVOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto* const x = v(args.vx);
+    auto const* const y = v(args.vy);
+    auto* const f = v(Register::vf);
+    for (auto l = first; l < last; ++l) {
+        auto const a = x[l];
+        auto const b = y[l];
+        f[l] = blend(selected_[l], utility::addition_overflow(a, b) ? Byte{1} : Byte{0}, f[l]);
+        x[l] = blend(selected_[l], static_cast<Byte>(a + b), x[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_sub_v_v(VVOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto* const x = v(args.vx);
+    auto const* const y = v(args.vy);
+    auto* const f = v(Register::vf);
+    for (auto l = first; l < last; ++l) {
+        auto const a = x[l];
+        auto const b = y[l];
+        f[l] = blend(selected_[l], utility::subtraction_underflow(a, b) ? Byte{0} : Byte{1}, f[l]);
+        x[l] = blend(selected_[l], static_cast<Byte>(a - b), x[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_shr_v(VOperands const& args, std::size_t const first, std::size_t const last)
+    -> void
+{
+    auto* const x = v(args.vx);
+    auto* const f = v(Register::vf);
+    for (auto l = first; l < last; ++l) {
+        auto const a = x[l];
+        f[l] = blend(selected_[l], utility::lsb(a) ? Byte{1} : Byte{0}, f[l]);
+        x[l] = blend(selected_[l], static_cast<Byte>(a >> 1U), x[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_subn_v_v(VVOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto* const x = v(args.vx);
+    auto const* const y = v(args.vy);
+    auto* const f = v(Register::vf);
+    for (auto l = first; l < last; ++l) {
+        auto const a = x[l];
+        auto const b = y[l];
+        f[l] = blend(selected_[l], utility::subtraction_underflow(b, a) ? Byte{0} : Byte{1}, f[l]);
+        x[l] = blend(selected_[l], static_cast<Byte>(b - a), x[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_shl_v(VOperands const& args, std::size_t const first, std::size_t const last)
+    -> void
+{
+    auto* const x = v(args.vx);
+    auto* const f = v(Register::vf);
+    for (auto l = first; l < last; ++l) {
+        auto const a = x[l];
+        f[l] = blend(selected_[l], utility::msb(a) ? Byte{1} : Byte{0}, f[l]);
+        x[l] = blend(selected_[l], static_cast<Byte>(a << 1U), x[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_sne_v_v(VVOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto const* const x = v(args.vx);
+    auto const* const y = v(args.vy);
+    skip_if(first, last, [&](std::size_t const l) { return x[l] != y[l]; });
+}
+
+auto Batch::execute_mov_i_a(AOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto* const i = i_.data();
+    for (auto l = first; l < last; ++l) {
+        i[l] = blend(selected_[l], Word{args.address}, i[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_jmp_v0_a(AOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto const* const x = v(Register::v0);
+    auto* const pc = program_counters_.data();
+    for (auto l = first; l < last; ++l) {
+        pc[l] = blend(selected_[l], static_cast<Address>(x[l] + args.address), pc[l]);
+    }
+}
+
+auto Batch::execute_rnd_v_b(VBOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto* const x = v(args.vx);
+    for (auto l = first; l < last; ++l) {
+        if (selected_[l] != 0) {
+            x[l] = static_cast<Byte>(randoms_[l]() & args.byte);
+        }
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_drw_v_v_n(VVNOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto const* const x = v(args.vx);
+    auto const* const y = v(args.vy);
+    auto* const f = v(Register::vf);
+    for (auto l = first; l < last; ++l) {
+        if (selected_[l] == 0) {
+            continue;
+        }
+
+        if (args.nibble > max_nibble) {
+            fault(l, Fault::Type::invalid_instruction);
+            continue;
+        }
+        if (std::size_t{i_[l]} + args.nibble >= memory_size) {
+            fault(l, Fault::Type::invalid_address);
+            continue;
+        }
+
+        auto const sprite = gsl::span<Byte const>{memory(l) + i_[l], args.nibble};
+        auto const cleared = displays_[l].draw_sprite(x[l], y[l], sprite);
+        f[l] = cleared ? 1U : 0U; // Pixel cleared
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_skp_v(VOperands const& args, std::size_t const first, std::size_t const last)
+    -> void
+{
+    auto const* const x = v(args.vx);
+    skip_if(first, last, [&](std::size_t const l) {
+        return x[l] < key_count && keys_[l].test(x[l]); // Unknown keys are never pressed
+    });
+}
+
+auto Batch::execute_sknp_v(VOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto const* const x = v(args.vx);
+    skip_if(first, last, [&](std::size_t const l) {
+        return x[l] >= key_count || !keys_[l].test(x[l]); // Unknown keys are never pressed
+    });
+}
+
+auto Batch::execute_mov_v_dt(VOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto* const x = v(args.vx);
+    for (auto l = first; l < last; ++l) {
+        x[l] = blend(selected_[l], dt_[l], x[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_wkp_v(VOperands const& args, std::size_t const first, std::size_t const last)
+    -> void
+{
+    // A lane without a pressed key repeats the instruction.
+    auto* const x = v(args.vx);
+    for (auto l = first; l < last; ++l) {
+        if (selected_[l] == 0 || keys_[l].none()) {
+            continue;
+        }
+
+        std::size_t k = 0;
+        while (!keys_[l].test(k)) {
+            ++k;
+        }
+        x[l] = static_cast<Byte>(k);
+        program_counters_[l] += width;
+    }
+}
+
+auto Batch::execute_mov_dt_v(VOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto const* const x = v(args.vx);
+    for (auto l = first; l < last; ++l) {
+        dt_[l] = blend(selected_[l], x[l], dt_[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_mov_st_v(VOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto const* const x = v(args.vx);
+    for (auto l = first; l < last; ++l) {
+        st_[l] = blend(selected_[l], x[l], st_[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_add_i_v(VOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto const* const x = v(args.vx);
+    auto* const i = i_.data();
+    for (auto l = first; l < last; ++l) {
+        i[l] = blend(selected_[l], static_cast<Word>((i[l] + x[l]) & 0xFFFU), i[l]);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_font_v(VOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto const* const x = v(args.vx);
+    for (auto l = first; l < last; ++l) {
+        if (selected_[l] == 0) {
+            continue;
+        }
+
+        auto const offset = get_glyph_offset(x[l]);
+        if (offset == std::nullopt) {
+            fault(l, Fault::Type::invalid_digit);
+            continue;
+        }
+        i_[l] = static_cast<Word>(Machine::font_address + *offset);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_bcd_v(VOperands const& args, std::size_t const first, std::size_t const last)
+    -> void
+{
+    auto const* const x = v(args.vx);
+    for (auto l = first; l < last; ++l) {
+        if (selected_[l] == 0) {
+            continue;
+        }
+
+        if (std::size_t{i_[l]} + 2 >= memory_size) {
+            fault(l, Fault::Type::invalid_address);
+            continue;
+        }
+
+        auto* const m = memory(l) + i_[l];
+        m[0] = static_cast<Byte>(x[l] / 100);
+        m[1] = static_cast<Byte>((x[l] % 100) / 10);
+        m[2] = static_cast<Byte>(x[l] % 10);
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_mov_ii_v(VOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto const count = std::size_t{libnpln::detail::to_underlying(args.vx)} + 1;
+    for (auto l = first; l < last; ++l) {
+        if (selected_[l] == 0) {
+            continue;
+        }
+
+        if (i_[l] + count >= memory_size) {
+            fault(l, Fault::Type::invalid_address);
+            continue;
+        }
+
+        auto* const m = memory(l) + i_[l];
+        for (std::size_t r = 0; r < count; ++r) {
+            m[r] = gsl::at(v_, r)[l];
+        }
+    }
+
+    advance(first, last);
+}
+
+auto Batch::execute_mov_v_ii(VOperands const& args, std::size_t const first,
+    std::size_t const last) -> void
+{
+    auto const count = std::size_t{libnpln::detail::to_underlying(args.vx)} + 1;
+    for (auto l = first; l < last; ++l) {
+        if (selected_[l] == 0) {
+            continue;
+        }
+
+        if (i_[l] + count >= memory_size) {
+            fault(l, Fault::Type::invalid_address);
+            continue;
+        }
+
+        auto const* const m = memory(l) + i_[l];
+        for (std::size_t r = 0; r < count; ++r) {
+            gsl::at(v_, r)[l] = m[r];
+        }
+    }
+
+    advance(first, last);
+}
+
+} // namespace libnpln::machine
@@ -0,0 +1,168 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_BATCH_HPP
+#define LIBNPLN_MACHINE_BATCH_HPP
+
+#include <libnpln/machine/Backend.hpp>
+#include <libnpln/machine/DataUnits.hpp>
+#include <libnpln/machine/Display.hpp>
+#include <libnpln/machine/Fault.hpp>
+#include <libnpln/machine/Instruction.hpp>
+#include <libnpln/machine/Keys.hpp>
+#include <libnpln/machine/Machine.hpp>
+#include <libnpln/machine/Operands.hpp>
+#include <libnpln/machine/Random.hpp>
+#include <libnpln/machine/Stack.hpp>
+
+#include <frequencypp/frequency.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace libnpln::machine {
+
+// Runs many machines in lockstep, with each part of their state stored in an array that holds it
+// for every machine in its own lane.  The lanes that are at the same instruction execute it
+// together in loops over the arrays that the compiler can vectorize, and the lanes that diverged
+// from them execute on their own.  A cycle of the batch is equivalent to a cycle of each machine.
+class Batch
+{
+public:
+    // Every machine must have the same master clock rate.
+    explicit Batch(std::vector<Machine> const& machines);
+
+    // Executes one cycle of every lane that has not faulted.
+    auto cycle() -> void;
+
+    // Executes the given number of cycles.
+    auto run(std::size_t cycles) -> void;
+
+    [[nodiscard]] auto lane_count() const noexcept -> std::size_t
+    {
+        return lane_count_;
+    }
+
+    // Returns a machine with the state of the given lane.
+    [[nodiscard]] auto lane(std::size_t l) const -> Machine;
+
+    [[nodiscard]] auto fault(std::size_t const l) const -> std::optional<Fault> const&
+    {
+        return faults_.at(l);
+    }
+
+    auto keys(std::size_t const l) -> Keys&
+    {
+        return keys_.at(l);
+    }
+    [[nodiscard]] auto keys(std::size_t const l) const -> Keys const&
+    {
+        return keys_.at(l);
+    }
+
+    // The number of lanes that executed the same instruction together in the last cycle.
+    [[nodiscard]] auto converged_lanes() const noexcept -> std::size_t
+    {
+        return converged_lanes_;
+    }
+
+    static constexpr std::size_t register_count = 16;
+
+private:
+    auto cycle_lane(std::size_t l) -> void;
+    auto load(std::size_t l, Address a) const noexcept -> Word;
+    auto memory(std::size_t l) noexcept -> Byte*;
+    auto fault(std::size_t l, Fault::Type type) -> void;
+    auto v(Register r) noexcept -> Byte*;
+
+    // The following operate on the selected lanes in [first, last).  A lane that faults is no
+    // longer selected.
+    auto advance(std::size_t first, std::size_t last) noexcept -> void;
+    template<typename Predicate>
+    auto skip_if(std::size_t first, std::size_t last, Predicate const& p) -> void;
+    auto tick_timers(std::size_t first, std::size_t last) noexcept -> void;
+
+    auto execute(Instruction const& instr, std::size_t first, std::size_t last) -> void;
+    auto execute_cls(std::size_t first, std::size_t last) -> void;
+    auto execute_ret(std::size_t first, std::size_t last) -> void;
+    auto execute_jmp_a(AOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_call_a(AOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_seq_v_b(VBOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_sne_v_b(VBOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_seq_v_v(VVOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_mov_v_b(VBOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_add_v_b(VBOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_mov_v_v(VVOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_or_v_v(VVOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_and_v_v(VVOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_xor_v_v(VVOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_add_v_v(VVOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_sub_v_v(VVOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_shr_v(VOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_subn_v_v(VVOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_shl_v(VOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_sne_v_v(VVOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_mov_i_a(AOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_jmp_v0_a(AOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_rnd_v_b(VBOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_drw_v_v_n(VVNOperands const& args, std::size_t first, std::size_t last)
+        -> void;
+    auto execute_skp_v(VOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_sknp_v(VOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_mov_v_dt(VOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_wkp_v(VOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_mov_dt_v(VOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_mov_st_v(VOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_add_i_v(VOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_font_v(VOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_bcd_v(VOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_mov_ii_v(VOperands const& args, std::size_t first, std::size_t last) -> void;
+    auto execute_mov_v_ii(VOperands const& args, std::size_t first, std::size_t last) -> void;
+
+    std::size_t lane_count_;
+
+    // Whether each lane executes the current instruction, as a byte rather than a bool so that
+    // it can be used in vectorized loops.
+    std::vector<std::uint8_t> selected_;
+    std::size_t converged_lanes_ = 0;
+
+    std::vector<std::optional<Fault>> faults_;
+    std::vector<Address> program_counters_;
+    std::array<std::vector<Byte>, register_count> v_;
+    std::vector<Byte> dt_;
+    std::vector<Byte> st_;
+    std::vector<Word> i_;
+    std::vector<Stack> stacks_;
+    // The memory of each lane, one after another.
+    std::vector<Byte> memories_;
+    std::vector<Keys> keys_;
+    std::vector<Display> displays_;
+    std::vector<Backend> backends_;
+
+    // The timers of every lane count at the same master clock rate, as in Machine.
+    frequencypp::hertz master_clock_rate_{120};
+    std::size_t delay_period_ = 1;
+    std::size_t sound_period_ = 1;
+    std::vector<std::size_t> delay_cycles_;
+    std::vector<std::size_t> sound_cycles_;
+
+    std::vector<Random> randoms_;
+};
+
+} // namespace libnpln::machine
+
+#endif
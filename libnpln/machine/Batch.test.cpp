@@ -0,0 +1,153 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Batch.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using namespace libnpln::machine;
+
+template<>
+struct Catch::StringMaker<Machine>
+{
+    static auto convert(Machine const& m)
+    {
+        return fmt::to_string(m);
+    }
+};
+
+namespace {
+
+// Exercises every kind of instruction, with branches that depend on the initial V0 and keys.
+auto create_machines(std::size_t const count) -> std::vector<Machine>
+{
+    Machine m;
+    load_into_memory<Machine::program_address>(
+        {
+            0xA3, 0x00, // MOV %I, $300h
+            0x81, 0x04, // ADD %V1, %V0
+            0x80, 0x15, // SUB %V0, %V1
+            0x82, 0x0E, // SHL %V2
+            0x40, 0x03, // SNE %V0, $03h
+            0x22, 0x30, // CALL 230h
+            0xC4, 0x0F, // RND %V4, $0Fh
+            0xF4, 0x33, // BCD %V4
+            0xF1, 0x55, // MOV (%I), %V0..%V1
+            0xF4, 0x29, // FONT %V4
+            0xD1, 0x25, // DRW %V1, %V2, $5h
+            0xE0, 0x9E, // SKP %V0
+            0x75, 0x01, // ADD %V5, $01h
+            0xF5, 0x15, // MOV %DT, %V5
+            0xF6, 0x07, // MOV %V6, %DT
+            0x12, 0x02, // JMP 202h
+        },
+        m.memory());
+    load_into_memory<0x230>(
+        {
+            0x77, 0x01, // ADD %V7, $01h
+            0x00, 0xEE, // RET
+        },
+        m.memory());
+
+    auto machines = std::vector<Machine>(count, m);
+    for (std::size_t l = 0; l < count; ++l) {
+        auto& ml = machines[l];
+        ml.registers().v0 = static_cast<Byte>(l * 7);
+        ml.keys().set(l % key_count);
+    }
+    return machines;
+}
+
+} // namespace
+
+TEST_CASE("Batch cycles are equivalent to cycles of each machine", "[machine][batch]")
+{
+    auto const cycles = GENERATE(1, 2, 17, 300);
+
+    auto machines = create_machines(64);
+    // A lane that has faulted, and a lane that faults on its own.
+    machines[3].fault() = Fault{Fault::Type::invalid_instruction, Machine::program_address};
+    machines[5].program_counter() = 0x232;
+
+    auto batch = Batch{machines};
+    REQUIRE(batch.lane_count() == machines.size());
+    for (int c = 0; c < cycles; ++c) {
+        batch.cycle();
+        for (auto& m : machines) {
+            m.cycle();
+        }
+    }
+
+    for (std::size_t l = 0; l < machines.size(); ++l) {
+        REQUIRE(batch.lane(l) == machines[l]);
+        REQUIRE(batch.fault(l) == machines[l].fault());
+    }
+    REQUIRE(batch.fault(5) == Fault{Fault::Type::empty_stack, 0x232});
+}
+
+TEST_CASE("Batch executes the lanes at the same instruction together", "[machine][batch]")
+{
+    auto machines = create_machines(16);
+    for (auto& m : machines) {
+        m.registers().v0 = 0x01;
+        m.keys().reset();
+    }
+    machines[7].program_counter() = 0x232;
+
+    auto batch = Batch{machines};
+    batch.cycle();
+    REQUIRE(batch.converged_lanes() == 15);
+    REQUIRE(batch.fault(7) != std::nullopt);
+
+    batch.run(10);
+    REQUIRE(batch.converged_lanes() == 15);
+}
+
+TEST_CASE("Batch lanes can be modified between cycles", "[machine][batch]")
+{
+    auto machines = create_machines(4);
+    auto batch = Batch{machines};
+
+    batch.keys(2).reset();
+    machines[2].keys().reset();
+    batch.run(50);
+    for (auto& m : machines) {
+        for (int c = 0; c < 50; ++c) {
+            m.cycle();
+        }
+    }
+
+    for (std::size_t l = 0; l < machines.size(); ++l) {
+        REQUIRE(batch.lane(l) == machines[l]);
+    }
+}
+
+TEST_CASE("Batch requires the same master clock rate", "[machine][batch]")
+{
+    auto machines = create_machines(2);
+    machines[1].master_clock_rate() = frequencypp::hertz{1000};
+    REQUIRE_THROWS_AS(Batch{machines}, std::invalid_argument);
+}
+
+TEST_CASE("Batch can be empty", "[machine][batch]")
+{
+    auto batch = Batch{std::vector<Machine>{}};
+    batch.run(10);
+    REQUIRE(batch.lane_count() == 0);
+    REQUIRE_THROWS_AS(batch.lane(0), std::out_of_range);
+}
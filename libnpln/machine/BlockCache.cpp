@@ -0,0 +1,251 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/BlockCache.hpp>
+
+#include <libnpln/detail/cpp2b.hpp>
+#include <libnpln/machine/Instruction.hpp>
+#include <libnpln/utility/Numeric.hpp>
+
+#include <gsl/gsl>
+
+#include <algorithm>
+
+namespace libnpln::machine {
+
+namespace {
+
+auto reg(BlockRegisters& r, Register const x) noexcept -> Byte&
+{
+    // The register identifiers decoded from a word are always within bounds.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    return r.v[libnpln::detail::to_underlying(x)];
+}
+
+// These operations mirror the semantics of the corresponding Machine::execute_* operations, except
+// that they do not advance the program counter.  The Machine tests run blocks of them against the
+// switched backend to verify that they are equivalent.
+
+auto execute_mov_v_b(BlockRegisters& r, Word const w) noexcept -> void
+{
+    auto const args = VBOperands::decode(w);
+    reg(r, args.vx) = args.byte;
+}
+
+auto execute_add_v_b(BlockRegisters& r, Word const w) noexcept -> void
+{
+    auto const args = VBOperands::decode(w);
+    reg(r, args.vx) += args.byte;
+}
+
+auto execute_mov_v_v(BlockRegisters& r, Word const w) noexcept -> void
+{
+    auto const args = VVOperands::decode(w);
+    reg(r, args.vx) = reg(r, args.vy);
+}
+
+auto execute_or_v_v(BlockRegisters& r, Word const w) noexcept -> void
+{
+    auto const args = VVOperands::decode(w);
+    reg(r, args.vx) |= reg(r, args.vy);
+}
+
+auto execute_and_v_v(BlockRegisters& r, Word const w) noexcept -> void
+{
+    auto const args = VVOperands::decode(w);
+    reg(r, args.vx) &= reg(r, args.vy);
+}
+
+auto execute_xor_v_v(BlockRegisters& r, Word const w) noexcept -> void
+{
+    auto const args = VVOperands::decode(w);
+    reg(r, args.vx) ^= reg(r, args.vy);
+}
+
+// As in the Machine, the operations that modify %VF as a flag read their operands before writing
+// the flag, and then write the destination register, so that %VF as an operand takes precedence.
+
+auto execute_add_v_v(BlockRegisters& r, Word const w) noexcept -> void
+{
+    auto const args = VVOperands::decode(w);
+    auto const x = reg(r, args.vx);
+    auto const y = reg(r, args.vy);
+    reg(r, Register::vf) = utility::addition_overflow(x, y) ? 1U : 0U; // Carry
+    reg(r, args.vx) = x + y;
+}
+
+auto execute_sub_v_v(BlockRegisters& r, Word const w) noexcept -> void
+{
+    auto const args = VVOperands::decode(w);
+    auto const x = reg(r, args.vx);
+    auto const y = reg(r, args.vy);
+    reg(r, Register::vf) = utility::subtraction_underflow(x, y) ? 0U : 1U; // Not borrow
+    reg(r, args.vx) = x - y;
+}
+
+auto execute_shr_v(BlockRegisters& r, Word const w) noexcept -> void
+{
+    auto const args = VOperands::decode(w);
+    auto const x = reg(r, args.vx);
+    reg(r, Register::vf) = utility::lsb(x) ? 1U : 0U;
+    reg(r, args.vx) = x >> 1U;
+}
+
+auto execute_subn_v_v(BlockRegisters& r, Word const w) noexcept -> void
+{
+    auto const args = VVOperands::decode(w);
+    auto const x = reg(r, args.vx);
+    auto const y = reg(r, args.vy);
+    reg(r, Register::vf) = utility::subtraction_underflow(y, x) ? 0U : 1U; // Not borrow
+    reg(r, args.vx) = y - x;
+}
+
+auto execute_shl_v(BlockRegisters& r, Word const w) noexcept -> void
+{
+    auto const args = VOperands::decode(w);
+    auto const x = reg(r, args.vx);
+    reg(r, Register::vf) = utility::msb(x) ? 1U : 0U;
+    reg(r, args.vx) = x << 1U;
+}
+
+auto execute_mov_i_a(BlockRegisters& r, Word const w) noexcept -> void
+{
+    r.i = AOperands::decode(w).address;
+}
+
+auto execute_add_i_v(BlockRegisters& r, Word const w) noexcept -> void
+{
+    r.i += reg(r, VOperands::decode(w).vx);
+    r.i &= 0xFFFU;
+}
+
+// Returns the operation that executes the given word, or null if the word does not decode to an
+// instruction that can be part of a block.
+auto compile_operation(Word const w) noexcept -> BlockOperation::Execute
+{
+    auto const i = Instruction::decode(w);
+    if (i == std::nullopt) {
+        return nullptr;
+    }
+
+    switch (i->op) {
+    case Operator::mov_v_b: return execute_mov_v_b;
+    case Operator::add_v_b: return execute_add_v_b;
+    case Operator::mov_v_v: return execute_mov_v_v;
+    case Operator::or_v_v: return execute_or_v_v;
+    case Operator::and_v_v: return execute_and_v_v;
+    case Operator::xor_v_v: return execute_xor_v_v;
+    case Operator::add_v_v: return execute_add_v_v;
+    case Operator::sub_v_v: return execute_sub_v_v;
+    case Operator::shr_v: return execute_shr_v;
+    case Operator::subn_v_v: return execute_subn_v_v;
+    case Operator::shl_v: return execute_shl_v;
+    case Operator::mov_i_a: return execute_mov_i_a;
+    case Operator::add_i_v: return execute_add_i_v;
+    default: return nullptr;
+    }
+}
+
+} // namespace
+
+BlockRegisters::BlockRegisters(Registers const& r) noexcept
+    : v{r.v0, r.v1, r.v2, r.v3, r.v4, r.v5, r.v6, r.v7, r.v8, r.v9, r.va, r.vb, r.vc, r.vd, r.ve,
+        r.vf}
+    , i{r.i}
+{}
+
+auto BlockRegisters::store(Registers& r) const noexcept -> void
+{
+    r.v0 = v[0x0];
+    r.v1 = v[0x1];
+    r.v2 = v[0x2];
+    r.v3 = v[0x3];
+    r.v4 = v[0x4];
+    r.v5 = v[0x5];
+    r.v6 = v[0x6];
+    r.v7 = v[0x7];
+    r.v8 = v[0x8];
+    r.v9 = v[0x9];
+    r.va = v[0xA];
+    r.vb = v[0xB];
+    r.vc = v[0xC];
+    r.vd = v[0xD];
+    r.ve = v[0xE];
+    r.vf = v[0xF];
+    r.i = i;
+}
+
+auto BlockCache::compile_new(Memory const& m, Address const a) -> void
+{
+    // The operations of a block are stored at the addresses of their words, where they are shared
+    // with every block that overlaps them.  Recompiling them is harmless, as the words of the
+    // blocks that are compiled have not changed since those blocks were compiled.
+    std::size_t size = 0;
+    auto end = std::size_t{a};
+    while (end + 1 < m.size() && size < Block::max_size) {
+        auto const w = make_word(m[end], m[end + 1]); // Big-endian
+        auto const execute = compile_operation(w);
+        if (execute == nullptr) {
+            break;
+        }
+
+        gsl::at(operations_, end) = {execute, w};
+        ++size;
+        end += Instruction::width;
+    }
+    gsl::at(sizes_, a) = static_cast<std::uint8_t>(size + 1);
+
+    // The block also depends on the word that ended it, which must be invalidated with it.
+    end = std::min(end + Instruction::width, m.size());
+    for (auto b = std::size_t{a}; b < end; ++b) {
+        compiled_bytes_[b] = true;
+    }
+}
+
+auto BlockCache::is_compiled(Address const a) const -> bool
+{
+    return gsl::at(sizes_, a) != 0;
+}
+
+auto BlockCache::invalidate(Address const first, std::size_t const count) noexcept -> void
+{
+    auto const end = std::min(std::size_t{first} + count, memory_size);
+    auto compiled = false;
+    for (auto b = std::size_t{first}; b < end; ++b) {
+        compiled = compiled || compiled_bytes_[b];
+        compiled_bytes_[b] = false;
+    }
+    if (!compiled) {
+        return;
+    }
+
+    // Only the blocks beginning at most max_span - 1 bytes before the range can extend into it.
+    auto const begin = first >= max_span - 1 ? first - (max_span - 1) : std::size_t{0};
+    for (auto a = begin; a < end; ++a) {
+        auto& size = gsl::at(sizes_, a);
+        // A block of n operations spans n + 1 words, including the word that ended it.
+        auto const span = std::size_t{size} * Instruction::width;
+        if (size != 0 && a + span > first) {
+            size = 0;
+        }
+    }
+}
+
+auto BlockCache::invalidate() noexcept -> void
+{
+    sizes_.fill(0);
+    compiled_bytes_.reset();
+}
+
+} // namespace libnpln::machine
@@ -0,0 +1,145 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_BLOCKCACHE_HPP
+#define LIBNPLN_MACHINE_BLOCKCACHE_HPP
+
+#include <libnpln/machine/DataUnits.hpp>
+#include <libnpln/machine/Instruction.hpp>
+#include <libnpln/machine/Memory.hpp>
+#include <libnpln/machine/Operator.hpp>
+#include <libnpln/machine/Registers.hpp>
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+namespace libnpln::machine {
+
+// Whether instructions of the operator only operate on the registers, so that they can be part of
+// a block.
+constexpr auto is_block_operator(OperatorId const id) noexcept -> bool
+{
+    switch (id) {
+    case OperatorId::mov_v_b:
+    case OperatorId::add_v_b:
+    case OperatorId::mov_v_v:
+    case OperatorId::or_v_v:
+    case OperatorId::and_v_v:
+    case OperatorId::xor_v_v:
+    case OperatorId::add_v_v:
+    case OperatorId::sub_v_v:
+    case OperatorId::shr_v:
+    case OperatorId::subn_v_v:
+    case OperatorId::shl_v:
+    case OperatorId::mov_i_a:
+    case OperatorId::add_i_v: return true;
+    default: return false;
+    }
+}
+
+// Local copies of the registers that the operations of a block read and write.  The general-purpose
+// registers are indexed by the underlying value of their Register.
+struct BlockRegisters
+{
+    explicit BlockRegisters(Registers const& r) noexcept;
+
+    auto store(Registers& r) const noexcept -> void;
+
+    std::array<Byte, 16> v{};
+    Address i = 0x000;
+};
+
+// An operation of a block, which executes the instruction word that it was compiled from.
+struct BlockOperation
+{
+    using Execute = auto (*)(BlockRegisters& r, Word w) noexcept -> void;
+
+    Execute execute;
+    Word word;
+};
+
+// A straight-line run of instructions that only operate on the registers, which cannot branch or
+// fault.  The run ends before the first instruction that is not such an operation.  The operations
+// are those compiled from each word of the run, so they are one per Instruction::width entries of
+// the operations of the cache from which the block was compiled.
+struct Block
+{
+    auto run(BlockRegisters& r) const noexcept -> void
+    {
+        for (std::size_t k = 0; k < size; ++k) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            auto const& o = operations[k * Instruction::width];
+            o.execute(r, o.word);
+        }
+    }
+
+    static constexpr std::size_t max_size = 64;
+
+    Address address;
+    std::size_t size;
+    BlockOperation const* operations;
+};
+
+// Caches the block compiled from each address of a Memory.  A block is compiled on the first lookup
+// of its address and is reused by every following lookup until it is invalidated.  Like the
+// DecodeCache, the cache does not observe the memory that it compiles from; the owner of the memory
+// must invalidate the affected blocks whenever it writes to that memory.  The cache stores the
+// operation compiled from each address and the size of the block beginning at each address, so
+// compiling and invalidating blocks never allocates.
+class BlockCache
+{
+public:
+    // Returns the block beginning at the given address, which must be within the memory.  The
+    // returned block is valid until it is invalidated.
+    auto compile(Memory const& m, Address const a) -> Block
+    {
+        // The operator[] accesses are bounded by the precondition on the address.
+        if (sizes_[a] == 0) {
+            compile_new(m, a);
+        }
+
+        return Block{a, sizes_[a] - std::size_t{1}, &operations_[a]};
+    }
+
+    [[nodiscard]] auto is_compiled(Address a) const -> bool;
+
+    // Invalidates every block that was compiled from at least one byte in the given range.
+    auto invalidate(Address first, std::size_t count) noexcept -> void;
+
+    // Invalidates every block.
+    auto invalidate() noexcept -> void;
+
+private:
+    auto compile_new(Memory const& m, Address a) -> void;
+
+    // The block beginning at an address also depends on the word that ends it, so it spans at most
+    // this many bytes.
+    static constexpr std::size_t max_span = (Block::max_size + 1) * Instruction::width;
+
+    std::array<BlockOperation, memory_size> operations_{};
+
+    // The size of the block beginning at each address plus one, or zero if no block beginning at
+    // that address is compiled.
+    std::array<std::uint8_t, memory_size> sizes_{};
+
+    // Whether each byte may be part of a compiled block, which lets writes to memory from which no
+    // block was compiled skip the search for the blocks that they invalidate.
+    std::bitset<memory_size> compiled_bytes_;
+};
+
+} // namespace libnpln::machine
+
+#endif
@@ -0,0 +1,161 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/BlockCache.hpp>
+
+#include <catch2/catch.hpp>
+
+using namespace libnpln::machine;
+
+TEST_CASE("BlockCache compiles runs of register operations", "[machine][block_cache]")
+{
+    auto m = Memory{};
+    load_into_memory<0x200>(
+        {
+            0x60, 0x05, // MOV %V0, $05h
+            0x71, 0x03, // ADD %V1, $03h
+            0x81, 0x04, // ADD %V1, %V0
+            0xA3, 0x00, // MOV %I, $300h
+            0xF1, 0x1E, // ADD %I, %V1
+            0x12, 0x00, // JMP 200h
+        },
+        m);
+
+    auto c = BlockCache{};
+    REQUIRE_FALSE(c.is_compiled(0x200));
+
+    auto const b = c.compile(m, 0x200);
+    REQUIRE(c.is_compiled(0x200));
+    REQUIRE(b.address == 0x200);
+    REQUIRE(b.size == 5);
+    REQUIRE(c.compile(m, 0x200).operations == b.operations);
+
+    auto r = BlockRegisters{Registers{}};
+    r.v[0x1] = 0xFE;
+    b.run(r);
+    REQUIRE(r.v[0x0] == 0x05);
+    REQUIRE(r.v[0x1] == 0x06);
+    REQUIRE(r.v[0xF] == 0x00);
+    REQUIRE(r.i == 0x306);
+
+    // Blocks beginning within another block share its operations.
+    REQUIRE(c.compile(m, 0x204).size == 3);
+    REQUIRE(c.is_compiled(0x200));
+    REQUIRE(c.compile(m, 0x20A).size == 0);
+}
+
+TEST_CASE("BlockCache compiles exactly the block operators", "[machine][block_cache]")
+{
+    for (std::size_t i = 0; i + 1 < operator_id_count; ++i) {
+        auto const id = static_cast<OperatorId>(i);
+        auto const op = to_operator(id);
+        auto const w = static_cast<Word>(op);
+        auto m = Memory{};
+        m[0x200] = static_cast<Byte>(w >> 8U);
+        m[0x201] = static_cast<Byte>(w);
+
+        auto c = BlockCache{};
+        INFO(get_name(op));
+        REQUIRE(c.compile(m, 0x200).size == (is_block_operator(id) ? 1 : 0));
+    }
+}
+
+TEST_CASE("BlockCache limits the size of blocks", "[machine][block_cache]")
+{
+    auto m = Memory{};
+    for (std::size_t a = 0; a < m.size(); a += 2) {
+        m[a] = 0x70; // ADD %V0, $01h
+        m[a + 1] = 0x01;
+    }
+
+    auto c = BlockCache{};
+    REQUIRE(c.compile(m, 0x000).size == Block::max_size);
+    REQUIRE(c.compile(m, 0xFFE).size == 1);
+    REQUIRE(c.compile(m, 0xFFF).size == 0);
+}
+
+TEST_CASE("BlockRegisters load and store the registers", "[machine][block_cache]")
+{
+    auto r = Registers{};
+    r.v0 = 0x01;
+    r.vf = 0x0F;
+    r.i = 0x123;
+    r.dt = 0x45;
+
+    auto b = BlockRegisters{r};
+    REQUIRE(b.v[0x0] == 0x01);
+    REQUIRE(b.v[0xF] == 0x0F);
+    REQUIRE(b.i == 0x123);
+
+    b.v[0x7] = 0x77;
+    b.i = 0x456;
+    b.store(r);
+    REQUIRE(r.v7 == 0x77);
+    REQUIRE(r.i == 0x456);
+    REQUIRE(r.dt == 0x45);
+}
+
+TEST_CASE("BlockCache invalidates the blocks that overlap a range", "[machine][block_cache]")
+{
+    auto m = Memory{};
+    load_into_memory<0x2FC>(
+        {
+            0x60, 0x01, // MOV %V0, $01h
+            0x60, 0x02, // MOV %V0, $02h
+            0x60, 0x03, // MOV %V0, $03h
+            0x00, 0xE0, // CLS
+        },
+        m);
+    load_into_memory<0x400>(
+        {
+            0x00, 0xE0, // CLS
+        },
+        m);
+
+    auto c = BlockCache{};
+    REQUIRE(c.compile(m, 0x2FC).size == 3);
+    REQUIRE(c.compile(m, 0x300).size == 1);
+    REQUIRE(c.compile(m, 0x400).size == 0);
+
+    c.invalidate(0x2FE, 0); // Empty ranges invalidate nothing
+    REQUIRE(c.is_compiled(0x2FC));
+
+    // Bytes next to a block, even on the same page, do not invalidate it.
+    c.invalidate(0x304, 0xFC);
+    c.invalidate(0x2F0, 0x0C);
+    REQUIRE(c.is_compiled(0x2FC));
+    REQUIRE(c.is_compiled(0x300));
+    REQUIRE(c.is_compiled(0x400));
+
+    // Only the blocks that overlap the range are invalidated.
+    c.invalidate(0x2FF, 1);
+    REQUIRE_FALSE(c.is_compiled(0x2FC));
+    REQUIRE(c.is_compiled(0x300));
+
+    m[0x300] = 0x00; // RET
+    m[0x301] = 0xEE;
+    c.invalidate(0x300, 2);
+    REQUIRE_FALSE(c.is_compiled(0x300));
+    REQUIRE(c.compile(m, 0x2FC).size == 2);
+
+    // The word that ends a block is part of the block.
+    c.invalidate(0x301, 1);
+    REQUIRE_FALSE(c.is_compiled(0x2FC));
+    REQUIRE(c.compile(m, 0x2FC).size == 2);
+    REQUIRE(c.is_compiled(0x400));
+
+    c.invalidate();
+    REQUIRE_FALSE(c.is_compiled(0x2FC));
+    REQUIRE_FALSE(c.is_compiled(0x400));
+}
@@ -0,0 +1,118 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Breakpoints.hpp>
+
+#include <libnpln/detail/cpp2b.hpp>
+
+#include <algorithm>
+#include <variant>
+
+namespace libnpln::machine {
+
+namespace {
+
+// The memory that an instruction reads or writes through the index register.
+struct MemoryAccess
+{
+    std::size_t count;
+    bool write;
+};
+
+auto get_memory_access(Instruction const& instr) noexcept -> std::optional<MemoryAccess>
+{
+    switch (instr.op) {
+    case Operator::drw_v_v_n: return MemoryAccess{std::get<VVNOperands>(instr.args).nibble, false};
+    case Operator::bcd_v: return MemoryAccess{3, true};
+    case Operator::mov_ii_v:
+        return MemoryAccess{
+            libnpln::detail::to_underlying(std::get<VOperands>(instr.args).vx) + std::size_t{1},
+            true};
+    case Operator::mov_v_ii:
+        return MemoryAccess{
+            libnpln::detail::to_underlying(std::get<VOperands>(instr.args).vx) + std::size_t{1},
+            false};
+    default: return std::nullopt;
+    }
+}
+
+} // namespace
+
+auto Breakpoints::set_breakpoint(Address const a, bool const armed) -> void
+{
+    set(breakpoints_, a, 1, armed);
+}
+
+auto Breakpoints::set_read_watchpoint(Address const first, std::size_t const count,
+    bool const armed) -> void
+{
+    set(reads_, first, count, armed);
+}
+
+auto Breakpoints::set_write_watchpoint(Address const first, std::size_t const count,
+    bool const armed) -> void
+{
+    set(writes_, first, count, armed);
+}
+
+auto Breakpoints::set_register_watchpoint(std::uint32_t const registers, bool const armed) -> void
+{
+    registers_ = armed ? registers_ | registers : registers_ & ~registers;
+    update_empty();
+}
+
+auto Breakpoints::clear() noexcept -> void
+{
+    breakpoints_.reset();
+    reads_.reset();
+    writes_.reset();
+    registers_ = 0;
+    empty_ = true;
+}
+
+auto Breakpoints::check(Instruction const& instr, Address const address, Address const index,
+    std::uint32_t const changed_registers) const noexcept -> std::optional<Hit>
+{
+    if (auto const access = get_memory_access(instr); access != std::nullopt) {
+        auto const& watched = access->write ? writes_ : reads_;
+        auto const last = std::min(index + access->count, memory_size);
+        for (std::size_t a = index; a < last; ++a) {
+            if (watched.test(a)) {
+                return Hit{access->write ? Hit::Type::write : Hit::Type::read,
+                    static_cast<Address>(a), 0};
+            }
+        }
+    }
+
+    if (auto const registers = changed_registers & registers_; registers != 0) {
+        return Hit{Hit::Type::register_change, address, registers};
+    }
+
+    return std::nullopt;
+}
+
+auto Breakpoints::set(Addresses& addresses, Address const first, std::size_t const count,
+    bool const armed) -> void
+{
+    if (first >= memory_size || count > memory_size - first) {
+        throw std::out_of_range{"Breakpoint or watchpoint outside of memory"};
+    }
+
+    for (auto a = std::size_t{first}; a < first + count; ++a) {
+        addresses.set(a, armed);
+    }
+    update_empty();
+}
+
+} // namespace libnpln::machine
@@ -0,0 +1,179 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_BREAKPOINTS_HPP
+#define LIBNPLN_MACHINE_BREAKPOINTS_HPP
+
+#include <libnpln/detail/cpp2b.hpp>
+#include <libnpln/machine/DataUnits.hpp>
+#include <libnpln/machine/Instruction.hpp>
+#include <libnpln/machine/Memory.hpp>
+#include <libnpln/machine/Register.hpp>
+
+#include <fmt/format.h>
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace libnpln::machine {
+
+// A breakpoint or watchpoint that stopped a run.
+struct Hit
+{
+    enum class Type
+    {
+        breakpoint,
+        read,
+        write,
+        register_change,
+    };
+
+    Type type;
+    // The address of the instruction that was about to execute or that executed, except for reads
+    // and writes, whose address is the first watched address that the instruction accessed.
+    Address address;
+    // The watched registers that the instruction changed, in the bits of
+    // TraceEntry::changed_registers.
+    std::uint32_t registers;
+};
+
+constexpr auto operator==(Hit const& lhs, Hit const& rhs) noexcept
+{
+    return lhs.type == rhs.type && lhs.address == rhs.address && lhs.registers == rhs.registers;
+}
+
+constexpr auto operator!=(Hit const& lhs, Hit const& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+constexpr auto get_name(Hit::Type const t) -> std::string_view
+{
+    switch (t) {
+    case Hit::Type::breakpoint: return "breakpoint";
+    case Hit::Type::read: return "read";
+    case Hit::Type::write: return "write";
+    case Hit::Type::register_change: return "register_change";
+    }
+
+    throw std::out_of_range("Unknown Hit::Type in get_name");
+}
+
+// The addresses that stop a run before the instruction there executes, and the memory and
+// registers that stop a run after an instruction accesses or changes them.  Addresses are kept in
+// bitmaps over the address space, so that checking one is a single bit test.
+class Breakpoints
+{
+public:
+    using Addresses = std::bitset<memory_size>;
+
+    // Whether nothing is armed, in which case runs are not affected at all.
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return empty_;
+    }
+
+    // Each of these arms or disarms the given addresses, and throws std::out_of_range if any of
+    // them are outside of memory.
+    auto set_breakpoint(Address a, bool armed = true) -> void;
+    auto set_read_watchpoint(Address first, std::size_t count, bool armed = true) -> void;
+    auto set_write_watchpoint(Address first, std::size_t count, bool armed = true) -> void;
+
+    // Arms or disarms the registers in the bits of TraceEntry::changed_registers.  A watched
+    // register stops a run when an instruction changes its value, but not when a timer ticks.
+    auto set_register_watchpoint(std::uint32_t registers, bool armed = true) -> void;
+    auto set_register_watchpoint(Register const r, bool const armed = true) -> void
+    {
+        set_register_watchpoint(1U << libnpln::detail::to_underlying(r), armed);
+    }
+
+    auto clear() noexcept -> void;
+
+    [[nodiscard]] auto breakpoints() const noexcept -> Addresses const&
+    {
+        return breakpoints_;
+    }
+    [[nodiscard]] auto read_watchpoints() const noexcept -> Addresses const&
+    {
+        return reads_;
+    }
+    [[nodiscard]] auto write_watchpoints() const noexcept -> Addresses const&
+    {
+        return writes_;
+    }
+    [[nodiscard]] auto register_watchpoints() const noexcept -> std::uint32_t
+    {
+        return registers_;
+    }
+
+    // Returns the watchpoint that an instruction hit, given the instruction, its address, the
+    // index register before it executed, and the registers that it changed.  Memory is checked
+    // before registers.
+    [[nodiscard]] auto check(Instruction const& instr, Address address, Address index,
+        std::uint32_t changed_registers) const noexcept -> std::optional<Hit>;
+
+private:
+    auto set(Addresses& addresses, Address first, std::size_t count, bool armed) -> void;
+
+    auto update_empty() noexcept -> void
+    {
+        empty_ = breakpoints_.none() && reads_.none() && writes_.none() && registers_ == 0;
+    }
+
+    Addresses breakpoints_;
+    Addresses reads_;
+    Addresses writes_;
+    std::uint32_t registers_ = 0;
+    bool empty_ = true;
+};
+
+} // namespace libnpln::machine
+
+template<>
+struct fmt::formatter<libnpln::machine::Hit::Type>
+{
+    template<typename ParseContext>
+    constexpr auto parse(ParseContext& context)
+    {
+        return context.begin();
+    }
+
+    template<typename FormatContext>
+    auto format(libnpln::machine::Hit::Type const& value, FormatContext& context)
+    {
+        return format_to(context.out(), "{}", libnpln::machine::get_name(value));
+    }
+};
+
+template<>
+struct fmt::formatter<libnpln::machine::Hit>
+{
+    template<typename ParseContext>
+    constexpr auto parse(ParseContext& context)
+    {
+        return context.begin();
+    }
+
+    template<typename FormatContext>
+    auto format(libnpln::machine::Hit const& value, FormatContext& context)
+    {
+        return format_to(context.out(), "{}@{:03X}h", value.type, value.address);
+    }
+};
+
+#endif
@@ -0,0 +1,196 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Breakpoints.hpp>
+
+#include <libnpln/machine/Machine.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+
+using namespace libnpln::machine;
+
+template<>
+struct Catch::StringMaker<Machine>
+{
+    static auto convert(Machine const& m)
+    {
+        return fmt::to_string(m);
+    }
+};
+
+template<>
+struct Catch::StringMaker<Hit>
+{
+    static auto convert(Hit const& h)
+    {
+        return fmt::to_string(h);
+    }
+};
+
+template<>
+struct Catch::StringMaker<RunResult>
+{
+    static auto convert(RunResult const& r)
+    {
+        return fmt::to_string(r);
+    }
+};
+
+namespace {
+
+auto create_machine(Backend const backend) -> Machine
+{
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x60, 0x05, // MOV %V0, $05h
+            0xA3, 0x00, // MOV %I, $300h
+            0xF0, 0x33, // BCD %V0
+            0xF2, 0x65, // MOV (%I), %V0..%V2
+            0x71, 0xFF, // ADD %V1, $FFh
+            0x12, 0x0A, // JMP 20Ah
+        },
+        m.memory());
+    return m;
+}
+
+} // namespace
+
+TEST_CASE("Breakpoints are armed and disarmed", "[machine][breakpoints]")
+{
+    Breakpoints b;
+    REQUIRE(b.empty());
+
+    b.set_breakpoint(0x200);
+    REQUIRE_FALSE(b.empty());
+    REQUIRE(b.breakpoints().test(0x200));
+    b.set_breakpoint(0x200, false);
+    REQUIRE(b.empty());
+
+    b.set_read_watchpoint(0x300, 4);
+    b.set_write_watchpoint(0xFFF, 1);
+    b.set_register_watchpoint(Register::v3);
+    REQUIRE(b.read_watchpoints().count() == 4);
+    REQUIRE(b.write_watchpoints().test(0xFFF));
+    REQUIRE(b.register_watchpoints() == 1U << 3U);
+
+    b.set_read_watchpoint(0x301, 2, false);
+    REQUIRE(b.read_watchpoints().count() == 2);
+    b.clear();
+    REQUIRE(b.empty());
+    REQUIRE(b.read_watchpoints().none());
+    REQUIRE(b.register_watchpoints() == 0);
+
+    REQUIRE_THROWS_AS(b.set_breakpoint(0x1000), std::out_of_range);
+    REQUIRE_THROWS_AS(b.set_write_watchpoint(0xFFF, 2), std::out_of_range);
+    REQUIRE(b.empty());
+}
+
+TEST_CASE("Hit formats its type and address", "[machine][breakpoints]")
+{
+    REQUIRE(fmt::format("{}", Hit{Hit::Type::breakpoint, 0x20A, 0}) == "breakpoint@20Ah");
+    REQUIRE(fmt::format("{}", Hit{Hit::Type::register_change, 0x208, 1U << 1U})
+        == "register_change@208h");
+    REQUIRE(get_name(Hit::Type::read) == "read");
+    REQUIRE(get_name(Hit::Type::write) == "write");
+}
+
+TEST_CASE("Machine stops before a breakpoint and resumes past it", "[machine][breakpoints]")
+{
+    for (auto const backend : backends) {
+        auto m = create_machine(backend);
+        m.breakpoints().set_breakpoint(0x20A);
+
+        REQUIRE(m.run(100) == RunResult{StopReason::breakpoint, 5});
+        REQUIRE(m.program_counter() == 0x20A);
+        REQUIRE(m.hit() == Hit{Hit::Type::breakpoint, 0x20A, 0});
+
+        // The jump returns to the breakpoint after resuming from it.
+        REQUIRE(m.run(100, no_stop_reasons) == RunResult{StopReason::breakpoint, 1});
+        REQUIRE(m.hit() == Hit{Hit::Type::breakpoint, 0x20A, 0});
+
+        m.breakpoints().clear();
+        REQUIRE(m.run(100, no_stop_reasons) == RunResult{StopReason::budget_exhausted, 100});
+        REQUIRE(m.hit() == std::nullopt);
+    }
+}
+
+TEST_CASE("Machine stops after an instruction hits a watchpoint", "[machine][breakpoints]")
+{
+    for (auto const backend : backends) {
+        SECTION("Write")
+        {
+            auto m = create_machine(backend);
+            m.breakpoints().set_write_watchpoint(0x302, 0x10);
+            m.breakpoints().set_read_watchpoint(0x300, 1);
+            REQUIRE(m.run(100) == RunResult{StopReason::watchpoint, 3});
+            REQUIRE(m.hit() == Hit{Hit::Type::write, 0x302, 0});
+            REQUIRE(m.memory()[0x302] == 5);
+
+            REQUIRE(m.run(100) == RunResult{StopReason::watchpoint, 1});
+            REQUIRE(m.hit() == Hit{Hit::Type::read, 0x300, 0});
+        }
+
+        SECTION("Read")
+        {
+            auto m = create_machine(backend);
+            m.breakpoints().set_read_watchpoint(0x301, 1);
+            REQUIRE(m.run(100) == RunResult{StopReason::watchpoint, 4});
+            REQUIRE(m.hit() == Hit{Hit::Type::read, 0x301, 0});
+            REQUIRE(m.registers().v2 == 5);
+        }
+
+        SECTION("Register")
+        {
+            auto m = create_machine(backend);
+            m.breakpoints().set_register_watchpoint(Register::v1);
+            m.breakpoints().set_register_watchpoint(TraceEntry::i_changed);
+            REQUIRE(m.run(100) == RunResult{StopReason::watchpoint, 2});
+            REQUIRE(m.hit() == Hit{Hit::Type::register_change, 0x202, TraceEntry::i_changed});
+
+            // The BCD is not a read, and the load only changes the other registers.
+            REQUIRE(m.run(100) == RunResult{StopReason::watchpoint, 3});
+            REQUIRE(m.hit() == Hit{Hit::Type::register_change, 0x208, 1U << 1U});
+            REQUIRE(m.registers().v1 == 0xFF);
+        }
+
+        SECTION("Timer")
+        {
+            // The delay timer ticks without stopping the run, as no instruction changes it.
+            auto m = create_machine(backend);
+            m.registers().dt = 10;
+            m.breakpoints().set_register_watchpoint(TraceEntry::dt_changed);
+            REQUIRE(m.run(100) == RunResult{StopReason::budget_exhausted, 100});
+            REQUIRE(m.registers().dt == 0);
+        }
+    }
+}
+
+TEST_CASE("Machine runs the same with breakpoints that are never hit", "[machine][breakpoints]")
+{
+    for (auto const backend : backends) {
+        auto expected = create_machine(backend);
+        REQUIRE(expected.run(1000, no_stop_reasons)
+            == RunResult{StopReason::budget_exhausted, 1000});
+
+        auto m = create_machine(backend);
+        m.breakpoints().set_breakpoint(0xF00);
+        m.breakpoints().set_read_watchpoint(0x400, 0x100);
+        m.breakpoints().set_register_watchpoint(Register::vf);
+        REQUIRE(m.run(1000, no_stop_reasons) == RunResult{StopReason::budget_exhausted, 1000});
+        REQUIRE(m == expected);
+    }
+}
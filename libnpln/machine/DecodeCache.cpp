@@ -0,0 +1,68 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/DecodeCache.hpp>
+
+#include <algorithm>
+
+namespace libnpln::machine {
+
+auto DecodeCache::is_decoded(Address const a) const -> bool
+{
+    return decoded_.test(a);
+}
+
+auto DecodeCache::invalidate(Address const first, std::size_t const count) noexcept -> void
+{
+    if (count == 0) {
+        return;
+    }
+
+    // The entry beginning one byte before the range was decoded from the first byte of the range.
+    auto const begin = first > 0 ? std::size_t{first} - 1 : std::size_t{0};
+    auto const end = std::min(std::size_t{first} + count, memory_size);
+    for (auto a = begin; a < end; ++a) {
+        decoded_[a] = false;
+    }
+
+    // Likewise for the handlers of fusions that extend into the range.
+    static constexpr auto fusion_bytes = max_fusion_length * Instruction::width;
+    auto const fused_begin = first >= fusion_bytes - 1 ? first - (fusion_bytes - 1) : 0;
+    for (std::size_t a = fused_begin; a < end; ++a) {
+        fused_[a] = false;
+    }
+}
+
+auto DecodeCache::invalidate() noexcept -> void
+{
+    decoded_.reset();
+    fused_.reset();
+}
+
+auto DecodeCache::fuse(Memory const& m, Address const a) -> void
+{
+    std::array<OperatorId, max_fusion_length> ids{};
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        auto const b = a + i * Instruction::width;
+        ids.at(i) = b + 1 < m.size() ? decode_id(m, static_cast<Address>(b)) : OperatorId::invalid;
+    }
+
+    auto const f = match_fusion(ids);
+    handlers_.at(a) = static_cast<std::uint8_t>(f == std::nullopt
+            ? static_cast<std::size_t>(ids[0])
+            : operator_id_count + static_cast<std::size_t>(*f));
+    fused_[a] = true;
+}
+
+} // namespace libnpln::machine
@@ -0,0 +1,106 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_DECODECACHE_HPP
+#define LIBNPLN_MACHINE_DECODECACHE_HPP
+
+#include <libnpln/machine/DataUnits.hpp>
+#include <libnpln/machine/Fusion.hpp>
+#include <libnpln/machine/Instruction.hpp>
+#include <libnpln/machine/Memory.hpp>
+#include <libnpln/machine/Operator.hpp>
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace libnpln::machine {
+
+// Caches the decoding of the instruction word at each address of a Memory.  An entry is decoded on
+// the first lookup of its address and is reused by every following lookup until it is invalidated.
+// The cache does not observe the memory that it decodes from; the owner of the memory must
+// invalidate the affected entries whenever it writes to that memory.
+class DecodeCache
+{
+public:
+    // Returns the decoding of the instruction word at the given address.  The address must be
+    // followed by at least one more byte of memory.
+    auto decode(Memory const& m, Address const a) -> std::optional<Instruction> const&
+    {
+        fill(m, a);
+        return instructions_[a];
+    }
+
+    // Returns the identifier of the operator of the instruction word at the given address, which is
+    // OperatorId::invalid if the word does not decode.  The address has the same precondition as in
+    // decode.
+    auto decode_id(Memory const& m, Address const a) -> OperatorId
+    {
+        fill(m, a);
+        return ids_[a];
+    }
+
+    // Returns the index of the handler for the instruction at the given address, which is either
+    // the underlying value of its OperatorId or, if a fusion begins with the instruction,
+    // operator_id_count plus the underlying value of that Fusion.  The address has the same
+    // precondition as in decode.
+    auto decode_handler(Memory const& m, Address const a) -> std::size_t
+    {
+        if (!fused_[a]) {
+            fuse(m, a);
+        }
+
+        return handlers_[a];
+    }
+
+    static constexpr std::size_t handler_count = operator_id_count + fusion_count;
+
+    [[nodiscard]] auto is_decoded(Address a) const -> bool;
+
+    // Invalidates every entry that was decoded or fused from at least one byte in the given range.
+    auto invalidate(Address first, std::size_t count) noexcept -> void;
+
+    // Invalidates every entry.
+    auto invalidate() noexcept -> void;
+
+private:
+    auto fill(Memory const& m, Address const a) -> void
+    {
+        // The operator[] accesses are bounded by the precondition on the address, which the
+        // machine checks before every fetch.
+        if (!decoded_[a]) {
+            instructions_[a] = Instruction::decode(make_word(m[a], m[a + 1])); // Big-endian
+            ids_[a] = instructions_[a] == std::nullopt ? OperatorId::invalid
+                                                       : to_operator_id(instructions_[a]->op);
+            decoded_[a] = true;
+        }
+    }
+
+    auto fuse(Memory const& m, Address a) -> void;
+
+    std::array<std::optional<Instruction>, memory_size> instructions_{};
+    std::array<OperatorId, memory_size> ids_{};
+    std::bitset<memory_size> decoded_;
+
+    // The handler indices depend on the instructions that follow their own, so they are tracked
+    // separately from the decodings.
+    std::array<std::uint8_t, memory_size> handlers_{};
+    std::bitset<memory_size> fused_;
+};
+
+} // namespace libnpln::machine
+
+#endif
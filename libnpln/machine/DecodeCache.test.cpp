@@ -0,0 +1,137 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/DecodeCache.hpp>
+
+#include <catch2/catch.hpp>
+
+using namespace libnpln::machine;
+
+TEST_CASE("DecodeCache decodes instructions on lookup", "[machine][decode_cache]")
+{
+    auto m = Memory{};
+    load_into_memory<0x200>(
+        {
+            0x00, 0xE0, // CLS
+            0x12, 0x00, // JMP 200h
+            0x00, 0x00, // Invalid
+        },
+        m);
+
+    auto c = DecodeCache{};
+    REQUIRE_FALSE(c.is_decoded(0x200));
+
+    REQUIRE(c.decode(m, 0x200) == Instruction::decode(0x00E0));
+    REQUIRE(c.is_decoded(0x200));
+    REQUIRE(c.decode(m, 0x202) == Instruction::decode(0x1200));
+    REQUIRE(c.decode(m, 0x204) == std::nullopt);
+    REQUIRE(c.is_decoded(0x204));
+}
+
+TEST_CASE("DecodeCache decodes operator identifiers on lookup", "[machine][decode_cache]")
+{
+    auto m = Memory{};
+    load_into_memory<0x200>(
+        {
+            0x00, 0xE0, // CLS
+            0xD1, 0x25, // DRW %V1, %V2, $5h
+            0x00, 0x00, // Invalid
+        },
+        m);
+
+    auto c = DecodeCache{};
+    REQUIRE(c.decode_id(m, 0x200) == OperatorId::cls);
+    REQUIRE(c.is_decoded(0x200));
+    REQUIRE(c.decode_id(m, 0x202) == OperatorId::drw_v_v_n);
+    REQUIRE(c.decode_id(m, 0x204) == OperatorId::invalid);
+
+    m[0x201] = 0xEE; // RET
+    c.invalidate(0x201, 1);
+    REQUIRE(c.decode_id(m, 0x200) == OperatorId::ret);
+    REQUIRE(c.decode(m, 0x200) == Instruction::decode(0x00EE));
+}
+
+TEST_CASE("DecodeCache decodes fused handlers on lookup", "[machine][decode_cache]")
+{
+    auto m = Memory{};
+    load_into_memory<0x200>(
+        {
+            0xA3, 0x00, // MOV %I, $300h
+            0xD1, 0x25, // DRW %V1, %V2, $5h
+            0x71, 0x01, // ADD %V1, $01h
+            0x41, 0x10, // SNE %V1, $10h
+            0x12, 0x04, // JMP 204h
+        },
+        m);
+
+    auto const fused = [](Fusion const f) {
+        return operator_id_count + static_cast<std::size_t>(f);
+    };
+
+    auto c = DecodeCache{};
+    REQUIRE(c.decode_handler(m, 0x200) == fused(Fusion::draw_sprite));
+    REQUIRE(c.decode_handler(m, 0x202) == static_cast<std::size_t>(OperatorId::drw_v_v_n));
+    REQUIRE(c.decode_handler(m, 0x204) == fused(Fusion::count_loop));
+    REQUIRE(c.decode_handler(m, 0x206) == static_cast<std::size_t>(OperatorId::sne_v_b));
+    REQUIRE(c.decode_handler(m, 0xFFE) == static_cast<std::size_t>(OperatorId::invalid));
+
+    // Writing to the final instruction of a fusion breaks it.
+    m[0x208] = 0xB2; // JMP %V0, 204h
+    c.invalidate(0x208, 1);
+    REQUIRE(c.decode_handler(m, 0x204) == static_cast<std::size_t>(OperatorId::add_v_b));
+    REQUIRE(c.decode_handler(m, 0x200) == fused(Fusion::draw_sprite));
+}
+
+TEST_CASE("DecodeCache reuses entries until they are invalidated", "[machine][decode_cache]")
+{
+    auto m = Memory{};
+    load_into_memory<0x200>(
+        {
+            0x00, 0xE0, // CLS
+        },
+        m);
+
+    auto c = DecodeCache{};
+    REQUIRE(c.decode(m, 0x200) == Instruction::decode(0x00E0));
+
+    m[0x201] = 0xEE; // RET
+    REQUIRE(c.decode(m, 0x200) == Instruction::decode(0x00E0));
+
+    c.invalidate(0x201, 1);
+    REQUIRE(c.decode(m, 0x200) == Instruction::decode(0x00EE));
+}
+
+TEST_CASE("DecodeCache invalidates entries overlapping a range", "[machine][decode_cache]")
+{
+    auto m = Memory{};
+    auto c = DecodeCache{};
+    for (Address a = 0x1FE; a < 0x206; ++a) {
+        c.decode(m, a);
+    }
+
+    c.invalidate(0x200, 3);
+    REQUIRE(c.is_decoded(0x1FE));
+    REQUIRE_FALSE(c.is_decoded(0x1FF)); // Overlaps the first byte of the range
+    REQUIRE_FALSE(c.is_decoded(0x200));
+    REQUIRE_FALSE(c.is_decoded(0x201));
+    REQUIRE_FALSE(c.is_decoded(0x202));
+    REQUIRE(c.is_decoded(0x203));
+    REQUIRE(c.is_decoded(0x204));
+
+    c.invalidate(0x000, 1);
+    c.invalidate(0xFFF, 16); // Clipped to the end of memory
+    c.invalidate();
+    REQUIRE_FALSE(c.is_decoded(0x1FE));
+    REQUIRE_FALSE(c.is_decoded(0x204));
+}
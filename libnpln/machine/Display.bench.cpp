@@ -0,0 +1,39 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Display.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace libnpln::machine;
+
+namespace {
+
+// Clears a display after filling the given number of its rows.
+auto BM_DisplayClear(benchmark::State& state) -> void
+{
+    auto const rows = static_cast<std::size_t>(state.range(0));
+    Display d;
+    for (auto _ : state) {
+        for (std::size_t y = 0; y < rows; ++y) {
+            d.set_row(y, ~Display::Row{0});
+        }
+        d.clear();
+        benchmark::ClobberMemory();
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_DisplayClear)->ArgName("rows")->Arg(0)->Arg(1)->Arg(Display::height);
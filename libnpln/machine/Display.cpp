@@ -14,69 +14,125 @@
 
 #include <libnpln/machine/Display.hpp>
 
-#include <gsl/gsl>
+#include <libnpln/utility/Fnv1a.hpp>
 
 #include <algorithm>
 
 namespace libnpln::machine {
 
-Display::Display() : pixels_(std::make_unique<Pixels>()) {}
-
-Display::Display(Display const& other) : pixels_(std::make_unique<Pixels>(*other.pixels_)) {}
+auto Display::operator==(Display const& rhs) const noexcept -> bool
+{
+    return rows_ == rhs.rows_;
+}
 
-Display::Display(Display&& other) noexcept : pixels_(std::move(other.pixels_)) {}
+auto Display::operator!=(Display const& rhs) const noexcept -> bool
+{
+    return !(*this == rhs);
+}
 
-auto Display::operator=(Display const& other) -> Display&
+auto Display::pixel(std::size_t const x, std::size_t const y) const -> ConstProxy
 {
-    if (this == &other) {
-        return *this;
+    if (x < width && y < height) {
+        return {rows_[y], mask(x)};
     }
 
-    *pixels_ = *other.pixels_;
-    return *this;
+    return nullptr;
 }
 
-auto Display::operator=(Display&& other) noexcept -> Display&
+auto Display::pixel(std::size_t const x, std::size_t const y) -> Proxy
 {
-    if (this == &other) {
-        return *this;
+    if (x < width && y < height) {
+        ++generation_;
+        dirty_rows_.set(y);
+        return {rows_[y], mask(x)};
     }
 
-    pixels_ = std::move(other.pixels_);
-    return *this;
+    return nullptr;
 }
 
-auto Display::operator==(Display const& rhs) const noexcept -> bool
+auto Display::set_row(std::size_t const y, Row const r) noexcept -> void
 {
-    return *pixels_ == *rhs.pixels_;
+    if (rows_[y] != r) {
+        rows_[y] = r;
+        dirty_rows_.set(y);
+        ++generation_;
+    }
 }
 
-auto Display::operator!=(Display const& rhs) const noexcept -> bool
+auto Display::draw_sprite(
+    std::size_t const x, std::size_t const y, gsl::span<Byte const> const sprite) noexcept -> bool
 {
-    return !(*this == rhs);
+    static constexpr std::size_t byte_bits = std::numeric_limits<Byte>::digits;
+    if (x >= width || y >= height) {
+        return false;
+    }
+
+    // Align each byte with the left edge of the display, then shift it right into place.  Bits
+    // that are shifted past the right edge are clipped.
+    auto const shift = width - byte_bits;
+    auto const rows = std::min(sprite.size(), height - y);
+    auto cleared = Row{0};
+    auto changed = false;
+    for (std::size_t i = 0; i < rows; ++i) {
+        auto const bits = (Row{sprite[i]} << shift) >> x;
+        if (bits == 0) {
+            continue;
+        }
+
+        auto& row = rows_[y + i];
+        cleared |= row & bits;
+        row ^= bits;
+        dirty_rows_.set(y + i);
+        changed = true;
+    }
+
+    if (changed) {
+        ++generation_;
+    }
+    return cleared != 0;
 }
 
-auto Display::pixel(std::size_t const x, std::size_t const y) const -> ConstProxy
+auto Display::clear() noexcept -> void
 {
-    if (auto const z = offset(x, y); z != std::nullopt) {
-        return &gsl::at(*pixels_, gsl::narrow<gsl::index>(*z));
+    auto changed = false;
+    for (std::size_t y = 0; y < height; ++y) {
+        if (rows_[y] != 0) {
+            rows_[y] = 0;
+            dirty_rows_.set(y);
+            changed = true;
+        }
     }
 
-    return nullptr;
+    if (changed) {
+        ++generation_;
+    }
 }
 
-auto Display::pixel(std::size_t const x, std::size_t const y) -> Proxy
+auto Display::hash() const noexcept -> std::uint64_t
 {
-    if (auto const z = offset(x, y); z != std::nullopt) {
-        return &gsl::at(*pixels_, gsl::narrow<gsl::index>(*z));
+    // Hash the bytes of each row from left to right, independently of the byte order.
+    utility::Fnv1a h;
+    for (auto const row : rows_) {
+        h.add_integer(row);
     }
 
-    return nullptr;
+    return h.value();
 }
 
-auto Display::clear() noexcept -> void
+auto Display::copy_pixels(Display const& other) noexcept -> void
 {
-    std::fill(std::begin(*pixels_), std::end(*pixels_), false);
+    auto changed = false;
+    for (std::size_t y = 0; y < height; ++y) {
+        if (rows_[y] != other.rows_[y]) {
+            rows_[y] = other.rows_[y];
+            dirty_rows_.set(y);
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        ++generation_;
+    }
 }
 
 } // namespace libnpln::machine
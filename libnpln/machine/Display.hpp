@@ -15,13 +15,17 @@
 #ifndef LIBNPLN_MACHINE_DISPLAY_HPP
 #define LIBNPLN_MACHINE_DISPLAY_HPP
 
+#include <libnpln/machine/DataUnits.hpp>
+
 #include <fmt/format.h>
+#include <gsl/span>
 
 #include <array>
+#include <bitset>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
-#include <memory>
-#include <optional>
+#include <limits>
 
 namespace libnpln::machine {
 
@@ -30,38 +34,148 @@ class Display
 public:
     using Pixel = bool;
 
-    using Proxy = Pixel*;
-    using ConstProxy = Pixel const*;
+    // Each row of pixels is packed into the bits of an integer, with the leftmost pixel in the most
+    // significant bit, so that a row of sprite data is drawn onto it by a shift and an XOR.
+    using Row = std::uint64_t;
+
+    // A reference to a single pixel of a packed row, which converts to and from Pixel.
+    template<typename RowType>
+    class BasicReference
+    {
+    public:
+        constexpr BasicReference(RowType& row, Row const mask) noexcept : row_{&row}, mask_{mask} {}
+        constexpr BasicReference(BasicReference const& other) noexcept = default;
+        ~BasicReference() = default;
+
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        constexpr operator Pixel() const noexcept
+        {
+            return (*row_ & mask_) != 0;
+        }
+
+        // Only available for references to mutable rows.
+        constexpr auto operator=(Pixel const p) const noexcept -> BasicReference const&
+        {
+            *row_ = p ? *row_ | mask_ : *row_ & ~mask_;
+            return *this;
+        }
+
+        // Assigns the referenced pixel rather than rebinding the reference.
+        constexpr auto operator=(BasicReference const& other) const noexcept
+            -> BasicReference const&
+        {
+            return *this = static_cast<Pixel>(other);
+        }
+
+    private:
+        RowType* row_;
+        Row mask_;
+    };
+
+    // A pointer-like handle to a single pixel, which is null if the pixel is out of range.  It
+    // preserves the interface that was used when every pixel was stored separately.
+    template<typename RowType>
+    class BasicProxy
+    {
+    public:
+        constexpr BasicProxy(std::nullptr_t) noexcept {} // NOLINT(google-explicit-constructor)
+        constexpr BasicProxy(RowType& row, Row const mask) noexcept : row_{&row}, mask_{mask} {}
+
+        constexpr explicit operator bool() const noexcept
+        {
+            return row_ != nullptr;
+        }
+
+        constexpr auto operator*() const noexcept -> BasicReference<RowType>
+        {
+            return {*row_, mask_};
+        }
+
+        constexpr auto operator==(std::nullptr_t) const noexcept -> bool
+        {
+            return row_ == nullptr;
+        }
+        constexpr auto operator!=(std::nullptr_t) const noexcept -> bool
+        {
+            return row_ != nullptr;
+        }
+
+    private:
+        RowType* row_ = nullptr;
+        Row mask_ = 0;
+    };
+
+    using Proxy = BasicProxy<Row>;
+    using ConstProxy = BasicProxy<Row const>;
 
-    Display();
-    Display(Display const& other);
-    Display(Display&& other) noexcept;
-    ~Display() = default;
+    using Generation = std::uint64_t;
 
-    auto operator=(Display const& other) -> Display&;
-    auto operator=(Display&& other) noexcept -> Display&;
+    static constexpr std::size_t width = std::numeric_limits<Row>::digits;
+    static constexpr std::size_t height = 32;
+
+    using DirtyRows = std::bitset<height>;
 
+    // Displays are equal if their pixels are equal, regardless of how they changed.
     auto operator==(Display const& rhs) const noexcept -> bool;
     auto operator!=(Display const& rhs) const noexcept -> bool;
 
     [[nodiscard]] auto pixel(std::size_t x, std::size_t y) const -> ConstProxy;
+
+    // The pixel may be changed through the returned proxy, so its row is marked as changed.
     auto pixel(std::size_t x, std::size_t y) -> Proxy;
 
+    // Returns the packed row of pixels at the given y coordinate, which must be less than height.
+    [[nodiscard]] auto row(std::size_t const y) const noexcept -> Row
+    {
+        return rows_[y];
+    }
+
+    // Replaces the packed row of pixels at the given y coordinate, which must be less than height,
+    // marking it as changed if it differs.
+    auto set_row(std::size_t y, Row r) noexcept -> void;
+
+    // Draws each byte of the sprite onto its own row by XOR, beginning at the given coordinates,
+    // with the most significant bit of each byte leftmost.  Pixels that would be drawn outside of
+    // the display are clipped.  Returns whether any pixel was cleared.
+    auto draw_sprite(std::size_t x, std::size_t y, gsl::span<Byte const> sprite) noexcept -> bool;
+
     auto clear() noexcept -> void;
 
-    static constexpr std::size_t width = 64;
-    static constexpr std::size_t height = 32;
+    // Copies the pixels of the other display, marking the rows that differ as changed.  Unlike
+    // assignment, this keeps the generation and dirty rows of this display meaningful to its
+    // consumers.
+    auto copy_pixels(Display const& other) noexcept -> void;
 
-private:
-    using Pixels = std::array<Pixel, width * height>;
+    // Returns a 64-bit FNV-1a hash of the pixels, which is stable across platforms and runs.
+    [[nodiscard]] auto hash() const noexcept -> std::uint64_t;
 
-    static constexpr auto offset(std::size_t const x, std::size_t const y)
-        -> std::optional<std::size_t>
+    // Returns a counter that increases whenever the pixels change, so that consumers can skip the
+    // display if it is unchanged since they last saw it.
+    [[nodiscard]] auto generation() const noexcept -> Generation
+    {
+        return generation_;
+    }
+
+    // Returns the rows that have changed since the dirty rows were last cleared.
+    [[nodiscard]] auto dirty_rows() const noexcept -> DirtyRows const&
+    {
+        return dirty_rows_;
+    }
+
+    auto clear_dirty_rows() noexcept -> void
+    {
+        dirty_rows_.reset();
+    }
+
+private:
+    static constexpr auto mask(std::size_t const x) noexcept -> Row
     {
-        return x < width && y < height ? std::optional{y * width + x} : std::nullopt;
+        return Row{1} << (width - 1 - x);
     }
 
-    std::unique_ptr<Pixels> pixels_;
+    std::array<Row, height> rows_{};
+    Generation generation_ = 0;
+    DirtyRows dirty_rows_;
 };
 
 } // namespace libnpln::machine
@@ -16,6 +16,8 @@
 
 #include <catch2/catch.hpp>
 
+#include <array>
+
 using namespace libnpln::machine;
 
 SCENARIO("Display pixels can be get and set", "[machine][display]")
@@ -31,7 +33,7 @@ SCENARIO("Display pixels can be get and set", "[machine][display]")
             {
                 for (auto x = 0U; x < decltype(d)::width; x++) {
                     for (auto y = 0U; y < decltype(d)::height; y++) {
-                        auto* p = d.pixel(x, y);
+                        auto p = d.pixel(x, y);
                         REQUIRE(p);
                         REQUIRE_FALSE(*p);
                     }
@@ -43,13 +45,13 @@ SCENARIO("Display pixels can be get and set", "[machine][display]")
         {
             auto const x = 0;
             auto const y = 0;
-            auto* p = d.pixel(x, y);
+            auto p = d.pixel(x, y);
             REQUIRE(p);
             *p = true;
 
             THEN("its value can be read back")
             {
-                auto const* p_const = d_const.pixel(x, y);
+                auto const p_const = d_const.pixel(x, y);
                 REQUIRE(p_const);
                 REQUIRE(*p);
             }
@@ -59,13 +61,13 @@ SCENARIO("Display pixels can be get and set", "[machine][display]")
         {
             auto const x = decltype(d)::width - 1;
             auto const y = 0;
-            auto* p = d.pixel(x, y);
+            auto p = d.pixel(x, y);
             REQUIRE(p);
             *p = true;
 
             THEN("its value can be read back")
             {
-                auto const* p_const = d_const.pixel(x, y);
+                auto const p_const = d_const.pixel(x, y);
                 REQUIRE(p_const);
                 REQUIRE(*p);
             }
@@ -75,13 +77,13 @@ SCENARIO("Display pixels can be get and set", "[machine][display]")
         {
             auto const x = 0;
             auto const y = decltype(d)::height - 1;
-            auto* p = d.pixel(x, y);
+            auto p = d.pixel(x, y);
             REQUIRE(p);
             *p = true;
 
             THEN("its value can be read back")
             {
-                auto const* p_const = d_const.pixel(x, y);
+                auto const p_const = d_const.pixel(x, y);
                 REQUIRE(p_const);
                 REQUIRE(*p);
             }
@@ -91,13 +93,13 @@ SCENARIO("Display pixels can be get and set", "[machine][display]")
         {
             auto const x = decltype(d)::width - 1;
             auto const y = decltype(d)::height - 1;
-            auto* p = d.pixel(x, y);
+            auto p = d.pixel(x, y);
             REQUIRE(p);
             *p = true;
 
             THEN("its value can be read back")
             {
-                auto const* p_const = d_const.pixel(x, y);
+                auto const p_const = d_const.pixel(x, y);
                 REQUIRE(p_const);
                 REQUIRE(*p);
             }
@@ -122,7 +124,7 @@ SCENARIO("Display can be cleared", "[machine][display]")
         auto d = Display{};
         for (auto x = 0U; x < decltype(d)::width; x++) {
             for (auto y = 0U; y < decltype(d)::height; y++) {
-                auto* p = d.pixel(x, y);
+                auto p = d.pixel(x, y);
                 REQUIRE(p);
                 *p = true;
             }
@@ -136,7 +138,7 @@ SCENARIO("Display can be cleared", "[machine][display]")
             {
                 for (auto x = 0U; x < decltype(d)::width; x++) {
                     for (auto y = 0U; y < decltype(d)::height; y++) {
-                        auto* p = d.pixel(x, y);
+                        auto p = d.pixel(x, y);
                         REQUIRE(p);
                         REQUIRE_FALSE(*p);
                     }
@@ -145,3 +147,239 @@ SCENARIO("Display can be cleared", "[machine][display]")
         }
     }
 }
+
+SCENARIO("Display pixels are packed into rows", "[machine][display]")
+{
+    GIVEN("An empty display")
+    {
+        auto d = Display{};
+
+        WHEN("pixels are set")
+        {
+            *d.pixel(0, 1) = true;
+            *d.pixel(decltype(d)::width - 1, 1) = true;
+            *d.pixel(1, 2) = *d.pixel(0, 1);
+
+            THEN("the leftmost pixel is the most significant bit of its row")
+            {
+                REQUIRE(d.row(0) == 0x0000000000000000);
+                REQUIRE(d.row(1) == 0x8000000000000001);
+                REQUIRE(d.row(2) == 0x4000000000000000);
+            }
+
+            AND_WHEN("one is unset")
+            {
+                *d.pixel(0, 1) = false;
+
+                THEN("only its bit is cleared")
+                {
+                    REQUIRE(d.row(1) == 0x0000000000000001);
+                    REQUIRE(d.row(2) == 0x4000000000000000);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Display draws sprites", "[machine][display]")
+{
+    GIVEN("An empty display")
+    {
+        auto d = Display{};
+        auto const sprite = std::array<Byte, 3>{0xF0, 0x90, 0xFF};
+
+        WHEN("a sprite is drawn")
+        {
+            auto const cleared = d.draw_sprite(4, 1, sprite);
+
+            THEN("its rows are drawn without clearing any pixels")
+            {
+                REQUIRE_FALSE(cleared);
+                REQUIRE(d.row(0) == 0x0000000000000000);
+                REQUIRE(d.row(1) == 0x0F00000000000000);
+                REQUIRE(d.row(2) == 0x0900000000000000);
+                REQUIRE(d.row(3) == 0x0FF0000000000000);
+                REQUIRE(d.row(4) == 0x0000000000000000);
+            }
+
+            AND_WHEN("it is drawn again")
+            {
+                auto const cleared_again = d.draw_sprite(4, 1, sprite);
+
+                THEN("it is erased and the pixels are cleared")
+                {
+                    REQUIRE(cleared_again);
+                    REQUIRE(d == Display{});
+                }
+            }
+        }
+
+        WHEN("a sprite is drawn across the bottom-right corner")
+        {
+            auto const cleared =
+                d.draw_sprite(decltype(d)::width - 4, decltype(d)::height - 2, sprite);
+
+            THEN("it is clipped")
+            {
+                REQUIRE_FALSE(cleared);
+                REQUIRE(d.row(decltype(d)::height - 2) == 0x000000000000000F);
+                REQUIRE(d.row(decltype(d)::height - 1) == 0x0000000000000009);
+                REQUIRE(d.row(0) == 0x0000000000000000);
+            }
+        }
+
+        WHEN("a sprite is drawn outside of the display")
+        {
+            auto const cleared_right = d.draw_sprite(decltype(d)::width, 0, sprite);
+            auto const cleared_below = d.draw_sprite(0, decltype(d)::height, sprite);
+
+            THEN("nothing is drawn")
+            {
+                REQUIRE_FALSE(cleared_right);
+                REQUIRE_FALSE(cleared_below);
+                REQUIRE(d == Display{});
+            }
+        }
+    }
+}
+
+SCENARIO("Display tracks the rows that change", "[machine][display]")
+{
+    GIVEN("An empty display")
+    {
+        auto d = Display{};
+        auto const sprite = std::array<Byte, 2>{0x80, 0x00};
+        auto const initial_generation = d.generation();
+        REQUIRE(d.dirty_rows().none());
+
+        WHEN("a sprite is drawn")
+        {
+            d.draw_sprite(0, 3, sprite);
+
+            THEN("the generation increases and only the changed rows are dirty")
+            {
+                REQUIRE(d.generation() > initial_generation);
+                REQUIRE(d.dirty_rows() == Display::DirtyRows{}.set(3));
+            }
+
+            AND_WHEN("the dirty rows are cleared and the display is cleared")
+            {
+                auto const drawn_generation = d.generation();
+                d.clear_dirty_rows();
+                d.clear();
+
+                THEN("the generation increases and the formerly set rows are dirty")
+                {
+                    REQUIRE(d.generation() > drawn_generation);
+                    REQUIRE(d.dirty_rows() == Display::DirtyRows{}.set(3));
+                }
+            }
+        }
+
+        WHEN("the display is cleared or drawn without change")
+        {
+            d.clear();
+            d.draw_sprite(0, 0, gsl::span<Byte const>{sprite}.subspan(1));
+            d.draw_sprite(Display::width, 0, sprite);
+
+            THEN("the generation and the dirty rows are unchanged")
+            {
+                REQUIRE(d.generation() == initial_generation);
+                REQUIRE(d.dirty_rows().none());
+            }
+        }
+
+        WHEN("a pixel is taken for writing")
+        {
+            *d.pixel(5, 7) = true;
+
+            THEN("its row is dirty")
+            {
+                REQUIRE(d.generation() > initial_generation);
+                REQUIRE(d.dirty_rows() == Display::DirtyRows{}.set(7));
+            }
+        }
+
+        WHEN("a row is replaced")
+        {
+            d.set_row(3, 0x00FF00FF00FF00FF);
+
+            THEN("its pixels are replaced and it is dirty")
+            {
+                REQUIRE(d.row(3) == 0x00FF00FF00FF00FF);
+                REQUIRE(d.generation() > initial_generation);
+                REQUIRE(d.dirty_rows() == Display::DirtyRows{}.set(3));
+            }
+
+            AND_WHEN("it is replaced with the same pixels")
+            {
+                auto const replaced_generation = d.generation();
+                d.clear_dirty_rows();
+                d.set_row(3, 0x00FF00FF00FF00FF);
+
+                THEN("the generation and the dirty rows are unchanged")
+                {
+                    REQUIRE(d.generation() == replaced_generation);
+                    REQUIRE(d.dirty_rows().none());
+                }
+            }
+        }
+
+        WHEN("the pixels of another display are copied")
+        {
+            auto other = Display{};
+            other.draw_sprite(0, 9, sprite);
+            d.copy_pixels(other);
+
+            THEN("the displays are equal and only the copied rows are dirty")
+            {
+                REQUIRE(d == other);
+                REQUIRE(d.generation() > initial_generation);
+                REQUIRE(d.dirty_rows() == Display::DirtyRows{}.set(9));
+            }
+
+            AND_WHEN("they are copied again")
+            {
+                auto const copied_generation = d.generation();
+                d.clear_dirty_rows();
+                d.copy_pixels(other);
+
+                THEN("the generation and the dirty rows are unchanged")
+                {
+                    REQUIRE(d.generation() == copied_generation);
+                    REQUIRE(d.dirty_rows().none());
+                }
+            }
+        }
+
+        WHEN("a pixel is read")
+        {
+            auto const& d_const = d;
+            REQUIRE_FALSE(*d_const.pixel(5, 7));
+
+            THEN("the generation and the dirty rows are unchanged")
+            {
+                REQUIRE(d.generation() == initial_generation);
+                REQUIRE(d.dirty_rows().none());
+            }
+        }
+    }
+}
+
+TEST_CASE("Display hashes depend only on the pixels", "[machine][display]")
+{
+    auto d = Display{};
+    REQUIRE(d.hash() == 0xD80AC658736BB725);
+
+    auto const sprite = std::array<Byte, 1>{0x80};
+    d.draw_sprite(0, 0, sprite);
+    auto const drawn_hash = d.hash();
+    REQUIRE(drawn_hash != Display{}.hash());
+
+    auto other = Display{};
+    other.draw_sprite(1, 0, sprite);
+    REQUIRE(other.hash() != drawn_hash);
+    other.clear();
+    other.draw_sprite(0, 0, sprite);
+    REQUIRE(other.hash() == drawn_hash);
+}
@@ -0,0 +1,126 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_FUSION_HPP
+#define LIBNPLN_MACHINE_FUSION_HPP
+
+#include <libnpln/machine/Operator.hpp>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace libnpln::machine {
+
+// Sequences of instructions that common programs spend most of their time in, which the threaded
+// backend executes as single operations.  The instructions of a sequence are executed in order at
+// consecutive addresses, and the sequence ends early when an instruction does not fall through to
+// the next one, such as a skip that skips the final jump.
+enum class Fusion : std::uint8_t
+{
+    // MOV addr, %I; DRW %Vx, %Vy, n
+    draw_sprite,
+    // MOV %DT, %Vx; SEQ %Vx, $byte; JMP addr
+    wait_delay,
+    // ADD $byte, %Vx; SNE %Vx, $byte; JMP addr
+    count_loop,
+};
+
+constexpr std::size_t fusion_count = static_cast<std::size_t>(Fusion::count_loop) + 1;
+constexpr std::size_t max_fusion_length = 3;
+
+// The number of times that each fusion has been executed, indexed by the underlying value of the
+// Fusion.
+using FusionCounts = std::array<std::size_t, fusion_count>;
+
+constexpr auto get_length(Fusion const f) -> std::size_t
+{
+    switch (f) {
+    case Fusion::draw_sprite: return 2;
+    case Fusion::wait_delay: return 3;
+    case Fusion::count_loop: return 3;
+    }
+
+    throw std::out_of_range("Unknown Fusion in get_length");
+}
+
+// Returns the operators of the instructions of the fusion, followed by OperatorId::invalid for each
+// instruction that the fusion is shorter than max_fusion_length by.
+constexpr auto get_operators(Fusion const f) -> std::array<OperatorId, max_fusion_length>
+{
+    switch (f) {
+    case Fusion::draw_sprite:
+        return {OperatorId::mov_i_a, OperatorId::drw_v_v_n, OperatorId::invalid};
+    case Fusion::wait_delay: return {OperatorId::mov_v_dt, OperatorId::seq_v_b, OperatorId::jmp_a};
+    case Fusion::count_loop: return {OperatorId::add_v_b, OperatorId::sne_v_b, OperatorId::jmp_a};
+    }
+
+    throw std::out_of_range("Unknown Fusion in get_operators");
+}
+
+// Returns the fusion that begins with the given sequence of operators, if any.  The sequence is
+// padded with OperatorId::invalid where it would extend past the end of memory.
+constexpr auto match_fusion(std::array<OperatorId, max_fusion_length> const& ids) noexcept
+    -> std::optional<Fusion>
+{
+    for (std::size_t i = 0; i < fusion_count; ++i) {
+        auto const f = static_cast<Fusion>(i);
+        auto const ops = get_operators(f);
+        auto matches = true;
+        for (std::size_t j = 0; j < get_length(f); ++j) {
+            matches = matches && ops[j] == ids[j];
+        }
+        if (matches) {
+            return f;
+        }
+    }
+
+    return std::nullopt;
+}
+
+constexpr auto get_name(Fusion const f) -> std::string_view
+{
+    switch (f) {
+    case Fusion::draw_sprite: return "draw_sprite";
+    case Fusion::wait_delay: return "wait_delay";
+    case Fusion::count_loop: return "count_loop";
+    }
+
+    throw std::out_of_range("Unknown Fusion in get_name");
+}
+
+} // namespace libnpln::machine
+
+template<>
+struct fmt::formatter<libnpln::machine::Fusion>
+{
+    template<typename ParseContext>
+    constexpr auto parse(ParseContext& context)
+    {
+        return context.begin();
+    }
+
+    template<typename FormatContext>
+    auto format(libnpln::machine::Fusion const& value, FormatContext& context)
+    {
+        return format_to(context.out(), "{}", libnpln::machine::get_name(value));
+    }
+};
+
+#endif
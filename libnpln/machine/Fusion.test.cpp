@@ -0,0 +1,79 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Fusion.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace libnpln::machine;
+
+TEST_CASE("Fusions define names", "[machine][fusion]")
+{
+    REQUIRE(get_name(Fusion::draw_sprite) == "draw_sprite");
+    REQUIRE(get_name(Fusion::wait_delay) == "wait_delay");
+    REQUIRE(get_name(Fusion::count_loop) == "count_loop");
+}
+
+TEST_CASE("Unknown Fusions do not define names, lengths, or operators", "[machine][fusion]")
+{
+    auto const invalid_fusion =
+        static_cast<Fusion>(std::numeric_limits<std::underlying_type_t<Fusion>>::max());
+    REQUIRE_THROWS_AS(get_name(invalid_fusion), std::out_of_range);
+    REQUIRE_THROWS_AS(get_length(invalid_fusion), std::out_of_range);
+    REQUIRE_THROWS_AS(get_operators(invalid_fusion), std::out_of_range);
+}
+
+TEST_CASE("Fusion returns its name when formatted", "[machine][fusion]")
+{
+    REQUIRE(fmt::format("{}", Fusion::draw_sprite) == get_name(Fusion::draw_sprite));
+    REQUIRE(fmt::format("{}", Fusion::wait_delay) == get_name(Fusion::wait_delay));
+    REQUIRE(fmt::format("{}", Fusion::count_loop) == get_name(Fusion::count_loop));
+}
+
+TEST_CASE("Fusions are padded to the maximum length", "[machine][fusion]")
+{
+    auto const f = GENERATE(Fusion::draw_sprite, Fusion::wait_delay, Fusion::count_loop);
+    auto const ops = get_operators(f);
+    for (std::size_t i = 0; i < max_fusion_length; ++i) {
+        REQUIRE((ops.at(i) == OperatorId::invalid) == (i >= get_length(f)));
+    }
+}
+
+TEST_CASE("Fusions are matched by their operators", "[machine][fusion]")
+{
+    auto const f = GENERATE(Fusion::draw_sprite, Fusion::wait_delay, Fusion::count_loop);
+    REQUIRE(match_fusion(get_operators(f)) == f);
+}
+
+TEST_CASE("Fusions are matched regardless of the operators that follow them", "[machine][fusion]")
+{
+    REQUIRE(match_fusion({OperatorId::mov_i_a, OperatorId::drw_v_v_n, OperatorId::cls})
+        == Fusion::draw_sprite);
+}
+
+TEST_CASE("Fusions are not matched by partial sequences", "[machine][fusion]")
+{
+    REQUIRE(match_fusion({OperatorId::mov_i_a, OperatorId::cls, OperatorId::drw_v_v_n})
+        == std::nullopt);
+    REQUIRE(match_fusion({OperatorId::mov_v_dt, OperatorId::seq_v_b, OperatorId::invalid})
+        == std::nullopt);
+    REQUIRE(match_fusion({OperatorId::add_v_b, OperatorId::sne_v_b, OperatorId::jmp_v0_a})
+        == std::nullopt);
+    REQUIRE(match_fusion({OperatorId::invalid, OperatorId::invalid, OperatorId::invalid})
+        == std::nullopt);
+}
@@ -0,0 +1,106 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/InputScript.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace libnpln::machine {
+
+namespace {
+
+auto parse_key(std::string const& s) -> std::optional<Key>
+{
+    if (s.size() != 1 || std::isxdigit(static_cast<unsigned char>(s[0])) == 0) {
+        return std::nullopt;
+    }
+
+    return static_cast<Key>(std::stoul(s, nullptr, 16));
+}
+
+auto parse_pressed(std::string const& s) -> std::optional<bool>
+{
+    if (s == "down") {
+        return true;
+    }
+    if (s == "up") {
+        return false;
+    }
+
+    return std::nullopt;
+}
+
+} // namespace
+
+auto parse_input_script(std::istream& s) -> std::optional<InputScript>
+{
+    InputScript script;
+    std::string line;
+    while (std::getline(s, line)) {
+        auto fields = std::istringstream{line};
+        std::string first;
+        if (!(fields >> first) || first.front() == '#') {
+            continue;
+        }
+
+        // Reject signs and other prefixes that the stream would otherwise accept.
+        if (!std::all_of(first.begin(), first.end(), [](char const c) {
+                return std::isdigit(static_cast<unsigned char>(c)) != 0;
+            })) {
+            return std::nullopt;
+        }
+
+        std::string key;
+        std::string pressed;
+        std::string rest;
+        if (!(fields >> key >> pressed) || fields >> rest) {
+            return std::nullopt;
+        }
+
+        auto const k = parse_key(key);
+        auto const p = parse_pressed(pressed);
+        if (k == std::nullopt || p == std::nullopt) {
+            return std::nullopt;
+        }
+
+        try {
+            script.push_back(KeyEvent{std::stoull(first), *k, *p});
+        }
+        catch (std::out_of_range const&) {
+            return std::nullopt;
+        }
+    }
+
+    if (s.bad()) {
+        return std::nullopt;
+    }
+
+    std::stable_sort(script.begin(), script.end(), [](KeyEvent const& a, KeyEvent const& b) {
+        return a.cycle < b.cycle;
+    });
+    return script;
+}
+
+auto parse_input_script(std::filesystem::path const& p) -> std::optional<InputScript>
+{
+    auto s = std::ifstream{p};
+    return s ? parse_input_script(s) : std::nullopt;
+}
+
+} // namespace libnpln::machine
@@ -0,0 +1,62 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_INPUTSCRIPT_HPP
+#define LIBNPLN_MACHINE_INPUTSCRIPT_HPP
+
+#include <libnpln/machine/Key.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <vector>
+
+namespace libnpln::machine {
+
+struct KeyEvent
+{
+    constexpr auto operator==(KeyEvent const& rhs) const noexcept
+    {
+        return cycle == rhs.cycle && key == rhs.key && pressed == rhs.pressed;
+    }
+    constexpr auto operator!=(KeyEvent const& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    // The number of cycles that the machine has run before the key changes.
+    std::size_t cycle;
+    Key key;
+    bool pressed;
+};
+
+// Key events in the order of their cycles, with events of the same cycle in their original order.
+using InputScript = std::vector<KeyEvent>;
+
+// Parses an input script, which has one event per line consisting of the cycle as a decimal
+// number, the key as a hexadecimal digit, and either "down" or "up":
+//
+//     # Press 5 for the first 600 cycles
+//     0 5 down
+//     600 5 up
+//
+// Blank lines and lines beginning with '#' are ignored.  Returns std::nullopt if any other line
+// is not an event.
+auto parse_input_script(std::istream& s) -> std::optional<InputScript>;
+auto parse_input_script(std::filesystem::path const& p) -> std::optional<InputScript>;
+
+} // namespace libnpln::machine
+
+#endif
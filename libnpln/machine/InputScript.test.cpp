@@ -0,0 +1,70 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/InputScript.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+
+using namespace libnpln::machine;
+
+TEST_CASE("InputScript can be parsed from a stream", "[machine][input_script]")
+{
+    auto s = std::istringstream{
+        "# Comments and blank lines are ignored\n"
+        "\n"
+        "600 5 up\n"
+        "0 5 down\n"
+        "  600   a   down  \n"
+        "1200 A up"};
+
+    REQUIRE(parse_input_script(s)
+        == InputScript{
+            KeyEvent{0, Key::k5, true},
+            KeyEvent{600, Key::k5, false},
+            KeyEvent{600, Key::ka, true},
+            KeyEvent{1200, Key::ka, false},
+        });
+}
+
+TEST_CASE("InputScript can be empty", "[machine][input_script]")
+{
+    auto s = std::istringstream{""};
+    REQUIRE(parse_input_script(s) == InputScript{});
+}
+
+TEST_CASE("InputScript cannot be parsed from invalid events", "[machine][input_script]")
+{
+    auto const line = GENERATE(as<std::string>{},
+        "0 5",
+        "0 5 pressed",
+        "0 10 down",
+        "0 g down",
+        "-1 5 down",
+        "+1 5 down",
+        "x 5 down",
+        "0 5 down extra",
+        "99999999999999999999999 5 down");
+
+    auto s = std::istringstream{line};
+    REQUIRE(parse_input_script(s) == std::nullopt);
+}
+
+TEST_CASE("InputScript cannot be parsed from a missing file", "[machine][input_script]")
+{
+    REQUIRE(parse_input_script(std::filesystem::path{"input-script-test-missing-file"})
+        == std::nullopt);
+}
@@ -0,0 +1,39 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Instruction.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <limits>
+
+using namespace libnpln::machine;
+
+namespace {
+
+auto BM_InstructionDecode(benchmark::State& state) -> void
+{
+    constexpr std::uint32_t word_count = std::numeric_limits<Word>::max() + 1U;
+    for (auto _ : state) {
+        for (std::uint32_t w = 0; w < word_count; ++w) {
+            benchmark::DoNotOptimize(Instruction::decode(static_cast<Word>(w)));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * word_count));
+}
+
+} // namespace
+
+BENCHMARK(BM_InstructionDecode);
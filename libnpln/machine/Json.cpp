@@ -0,0 +1,92 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Json.hpp>
+
+#include <libnpln/machine/Register.hpp>
+
+#include <fmt/format.h>
+#include <gsl/gsl>
+
+#include <iterator>
+
+namespace libnpln::machine {
+
+auto to_json(std::string_view const s) -> std::string
+{
+    std::string out;
+    out.reserve(s.size() + 2);
+    out += '"';
+    for (auto const c : s) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned>(c));
+            }
+            else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+    return out;
+}
+
+auto to_json(Machine const& m) -> std::string
+{
+    std::string out;
+    auto it = std::back_inserter(out);
+    auto const& r = m.registers();
+    it = fmt::format_to(
+        it, R"({{"program_counter": {}, "i": {}, "v": [)", m.program_counter(), r.i);
+    for (std::size_t x = 0; x <= static_cast<std::size_t>(Register::vf); ++x) {
+        it = fmt::format_to(it, "{}{}", x > 0 ? ", " : "", r[static_cast<Register>(x)]);
+    }
+    it = fmt::format_to(it, R"(], "dt": {}, "st": {}, "stack": [)", r.dt, r.st);
+    for (auto a = std::begin(m.stack()); a != std::end(m.stack()); ++a) {
+        it = fmt::format_to(it, "{}{}", a != std::begin(m.stack()) ? ", " : "", *a);
+    }
+    it = fmt::format_to(it, R"(], "fault": )");
+    if (auto const& f = m.fault(); f != std::nullopt) {
+        it = fmt::format_to(
+            it, R"({{"type": "{}", "address": {}}})", get_name(f->type), f->address);
+    }
+    else {
+        it = fmt::format_to(it, "null");
+    }
+    fmt::format_to(it, R"(, "display_hash": "{:016x}"}})", m.display().hash());
+    return out;
+}
+
+auto to_json(FusionCounts const& counts) -> std::string
+{
+    std::string out;
+    auto it = std::back_inserter(out);
+    it = fmt::format_to(it, "{{");
+    for (std::size_t f = 0; f < fusion_count; ++f) {
+        it = fmt::format_to(it, R"({}"{}": {})", f > 0 ? ", " : "", static_cast<Fusion>(f),
+            gsl::at(counts, static_cast<gsl::index>(f)));
+    }
+    fmt::format_to(it, "}}");
+    return out;
+}
+
+} // namespace libnpln::machine
@@ -0,0 +1,46 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_JSON_HPP
+#define LIBNPLN_MACHINE_JSON_HPP
+
+#include <libnpln/machine/Fusion.hpp>
+#include <libnpln/machine/Machine.hpp>
+
+#include <string>
+#include <string_view>
+
+namespace libnpln::machine {
+
+// Formats the string as a JSON string, escaping the characters that JSON requires.
+auto to_json(std::string_view s) -> std::string;
+
+// Formats the state of the machine that a program can observe as a JSON object, with the display
+// summarized by its hash:
+//
+//     {"program_counter": 512, "i": 0, "v": [0, ..., 0], "dt": 0, "st": 0, "stack": [],
+//      "fault": null, "display_hash": "cbf29ce484222325"}
+//
+// A fault is an object of its type and address.
+auto to_json(Machine const& m) -> std::string;
+
+// Formats the number of times that each fusion was executed as a JSON object keyed by the names of
+// the fusions:
+//
+//     {"draw_sprite": 0, "wait_delay": 0, "count_loop": 0}
+auto to_json(FusionCounts const& counts) -> std::string;
+
+} // namespace libnpln::machine
+
+#endif
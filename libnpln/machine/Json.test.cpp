@@ -0,0 +1,56 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Json.hpp>
+
+#include <catch2/catch.hpp>
+
+using namespace libnpln::machine;
+
+TEST_CASE("Strings are escaped when formatted as JSON", "[machine][json]")
+{
+    REQUIRE(to_json("") == R"("")");
+    REQUIRE(to_json("roms/PONG") == R"("roms/PONG")");
+    REQUIRE(to_json("a\"b\\c") == R"("a\"b\\c")");
+    REQUIRE(to_json("\n\t\x01") == R"("\n\t\u0001")");
+}
+
+TEST_CASE("Machine state is formatted as JSON", "[machine][json]")
+{
+    auto m = Machine{};
+    m.program_counter() = 0x202;
+    m.registers().i = 0x300;
+    m.registers().v1 = 0x12;
+    m.registers().vf = 0xFF;
+    m.registers().dt = 3;
+    m.stack().push(0x204);
+    m.stack().push(0x206);
+
+    REQUIRE(to_json(m)
+        == R"({"program_counter": 514, "i": 768, "v": [0, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, )"
+           R"(0, 0, 255], "dt": 3, "st": 0, "stack": [516, 518], "fault": null, )"
+           R"("display_hash": ")"
+            + fmt::format("{:016x}", m.display().hash()) + R"("})");
+
+    m.fault() = Fault{Fault::Type::invalid_instruction, 0x202};
+    REQUIRE_THAT(to_json(m),
+        Catch::Contains(R"("fault": {"type": "invalid_instruction", "address": 514})"));
+}
+
+TEST_CASE("Fusion counts are formatted as JSON", "[machine][json]")
+{
+    REQUIRE(to_json(FusionCounts{}) == R"({"draw_sprite": 0, "wait_delay": 0, "count_loop": 0})");
+    REQUIRE(to_json(FusionCounts{3, 0, 12})
+        == R"({"draw_sprite": 3, "wait_delay": 0, "count_loop": 12})");
+}
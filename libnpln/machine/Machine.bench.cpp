@@ -0,0 +1,199 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Machine.hpp>
+
+#include <libnpln/detail/Overload.hpp>
+#include <libnpln/libnpln.bench.hpp>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <string_view>
+#include <variant>
+
+using namespace libnpln;
+using namespace libnpln::machine;
+
+namespace {
+
+constexpr std::size_t block_length = 64;
+constexpr std::size_t run_cycles = 4096;
+
+// Returns an instruction of the operator that executes without faulting at the given address.
+// Jumps go to the next instruction, and the index is kept within the font.
+auto make_instruction_word(Operator const op, Address const address) -> Word
+{
+    auto const next = static_cast<Address>(address + Instruction::width);
+    auto const args = std::visit(
+        libnpln::detail::overload{
+            [](NullaryOperands const& a) -> Operands { return a; },
+            [&](AOperands const&) -> Operands {
+                return AOperands{op == Operator::mov_i_a ? Machine::font_address : next};
+            },
+            [](VOperands const&) -> Operands { return VOperands{Register::v1}; },
+            [](VBOperands const&) -> Operands { return VBOperands{Register::v1, 0x0F}; },
+            [](VVOperands const&) -> Operands { return VVOperands{Register::v1, Register::v2}; },
+            [](VVNOperands const&) -> Operands {
+                return VVNOperands{Register::v1, Register::v2, 5};
+            },
+        },
+        Instruction::decode(static_cast<Word>(op))->args);
+    return Instruction{op, args}.encode();
+}
+
+auto store_word(Memory& memory, Address const a, Word const w) -> void
+{
+    memory[a] = static_cast<Byte>(w >> 8U);
+    memory[a + 1] = static_cast<Byte>(w);
+}
+
+// Loads copies of an instruction followed by two jumps back to the first of them, so that a skip
+// of the last copy also returns.  CALL and RET are loaded as a subroutine call instead, as
+// neither can be repeated on its own without faulting.
+auto create_machine(Operator const op) -> Machine
+{
+    Machine m{Backend::switched};
+    m.registers().i = Machine::font_address;
+    m.keys().set(0);
+
+    auto& memory = m.memory();
+    auto const jump_back =
+        Instruction{Operator::jmp_a, AOperands{Machine::program_address}}.encode();
+    auto a = Machine::program_address;
+    if (op == Operator::call_a || op == Operator::ret) {
+        auto const subroutine = static_cast<Address>(a + 2 * Instruction::width);
+        store_word(memory, a, Instruction{Operator::call_a, AOperands{subroutine}}.encode());
+        store_word(memory, a + Instruction::width, jump_back);
+        store_word(memory, subroutine, make_instruction_word(Operator::ret, subroutine));
+        return m;
+    }
+
+    for (std::size_t i = 0; i < block_length; ++i, a += Instruction::width) {
+        store_word(memory, a, make_instruction_word(op, a));
+    }
+    store_word(memory, a, jump_back);
+    store_word(memory, a + Instruction::width, jump_back);
+    return m;
+}
+
+// Runs the instructions loaded for an operator by the switched backend, which executes each of
+// them by its execute_* handler.
+auto BM_Execute(benchmark::State& state, Operator const op) -> void
+{
+    auto m = create_machine(op);
+    std::size_t cycles = 0;
+    for (auto _ : state) {
+        cycles += m.run(run_cycles, no_stop_reasons).cycles;
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(cycles));
+    if (m.fault() != std::nullopt) {
+        state.SkipWithError(fmt::format("Faulted with {}", *m.fault()).c_str());
+    }
+}
+
+// Draws sprites of the given height, either within the display or clipped by its bottom right
+// corner.
+auto BM_ExecuteDraw(benchmark::State& state) -> void
+{
+    auto const height = static_cast<Nibble>(state.range(0));
+    auto const clipped = state.range(1) != 0;
+
+    auto m = create_machine(Operator::drw_v_v_n);
+    for (Address a = Machine::program_address;
+         a < Machine::program_address + block_length * Instruction::width;
+         a += Instruction::width) {
+        store_word(m.memory(), a,
+            Instruction{Operator::drw_v_v_n, VVNOperands{Register::v1, Register::v2, height}}
+                .encode());
+    }
+    m.registers().v1 = clipped ? Display::width - 4 : 8;
+    // A clipped sprite keeps its upper half, and at least one row, on the display.
+    m.registers().v2 = clipped ? Display::height - (height + 1) / 2 : 8;
+
+    std::size_t cycles = 0;
+    for (auto _ : state) {
+        cycles += m.run(run_cycles, no_stop_reasons).cycles;
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(cycles));
+}
+
+// Whether a machine has halted by jumping to itself, which ends many ROMs.
+auto halted(Machine const& m) -> bool
+{
+    auto const pc = m.program_counter();
+    auto const& memory = m.memory();
+    return std::size_t{pc} + 1 < memory_size
+        && make_word(memory[pc], memory[pc + 1])
+        == Instruction{Operator::jmp_a, AOperands{pc}}.encode();
+}
+
+// Runs a ROM from its beginning, reporting the millions of instructions per second that were
+// executed, including those skipped by idle loops.  Every other run holds a different key, so that
+// the ROM does not wait for a key forever, and the ROM restarts if it faults or halts, so that it
+// does not spend the benchmark skipping its final loop.
+auto BM_Rom(benchmark::State& state, bench::Rom const& rom, Backend const backend) -> void
+{
+    Machine initial{backend};
+    load_into_memory(std::begin(rom.program), std::end(rom.program), initial.memory(),
+        Machine::program_address);
+
+    auto m = initial;
+    std::size_t cycles = 0;
+    std::size_t press = 0;
+    for (auto _ : state) {
+        m.keys().reset();
+        if (press % 2 == 0) {
+            m.keys().set(press / 2 % m.keys().size());
+        }
+        ++press;
+        auto const r = m.run(run_cycles, no_stop_reasons);
+        cycles += r.cycles;
+        if (r.reason == StopReason::fault || halted(m)) {
+            m = initial;
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(cycles));
+    state.counters["MIPS"] =
+        benchmark::Counter(static_cast<double>(cycles) / 1e6, benchmark::Counter::kIsRate);
+}
+
+auto register_benchmarks() -> bool
+{
+    for (std::size_t id = 0; id + 1 < operator_id_count; ++id) {
+        auto const op = to_operator(static_cast<OperatorId>(id));
+        if (op == Operator::ret) {
+            continue; // Executed with call_a
+        }
+        auto const name = op == Operator::call_a ? std::string_view{"call_a,ret"} : get_name(op);
+        benchmark::RegisterBenchmark(fmt::format("BM_Execute/{}", name).c_str(), BM_Execute, op);
+    }
+
+    for (auto const& rom : bench::get_roms()) {
+        for (auto const backend : backends) {
+            benchmark::RegisterBenchmark(
+                fmt::format("BM_Rom/{}/{}", rom.name, backend).c_str(), BM_Rom, rom, backend);
+        }
+    }
+    return true;
+}
+
+[[maybe_unused]] auto const registered = register_benchmarks();
+
+} // namespace
+
+BENCHMARK(BM_ExecuteDraw)
+    ->ArgNames({"height", "clipped"})
+    ->ArgsProduct({{1, 5, 10, 15}, {0, 1}});
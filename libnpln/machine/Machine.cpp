@@ -14,17 +14,30 @@
 
 #include <libnpln/machine/Machine.hpp>
 
+#include <libnpln/detail/cpp2b.hpp>
 #include <libnpln/machine/Font.hpp>
 #include <libnpln/machine/RegisterRange.hpp>
+#include <libnpln/utility/Fnv1a.hpp>
 #include <libnpln/utility/Numeric.hpp>
 
 #include <gsl/gsl>
 
+#include <algorithm>
+#include <iterator>
 #include <stdexcept>
+#include <utility>
+#include <variant>
 
 namespace libnpln::machine {
 
-Machine::Machine() : memory_(std::make_unique<Memory>())
+Machine::Machine() : Machine(Backend::switched) {}
+
+Machine::Machine(Backend const backend)
+    : memory_(std::make_unique<Memory>())
+    , written_pages_(~std::bitset<page_count>{})
+    , decode_cache_(std::make_unique<DecodeCache>())
+    , block_cache_(std::make_unique<BlockCache>())
+    , backend_(backend)
 {
     if (!load_font_into_memory(*memory_, font_address)) {
         throw std::logic_error{"Unable to load font into machine memory"};
@@ -37,13 +50,28 @@ Machine::Machine(Machine const& other)
     , registers_(other.registers_)
     , stack_(other.stack_)
     , memory_(std::make_unique<Memory>(*other.memory_))
+    , pages_(other.pages_)
+    , written_pages_(other.written_pages_)
+    , hashes_(other.hashes_)
     , keys_(other.keys_)
     , display_(other.display_)
+    , decode_cache_(std::make_unique<DecodeCache>(*other.decode_cache_))
+    , block_cache_(std::make_unique<BlockCache>()) // Recompiled on demand
+    , backend_(other.backend_)
+    , fusion_counts_(other.fusion_counts_)
     , master_clock_rate_(other.master_clock_rate_)
     , delay_cycles(other.delay_cycles)
     , sound_cycles(other.sound_cycles)
-    , random_engine(other.random_engine)
-{}
+    , timer_periods_clock_rate_(other.timer_periods_clock_rate_)
+    , delay_period_(other.delay_period_)
+    , sound_period_(other.sound_period_)
+    , random_(other.random_)
+    , profile_(other.profile_)
+    , breakpoints_(other.breakpoints_)
+    , hit_(other.hit_)
+{
+    // The trace is not shared with the copy, as it may only be recorded by one machine.
+}
 
 Machine::Machine(Machine&& other) noexcept
     : fault_(other.fault_)
@@ -51,12 +79,26 @@ Machine::Machine(Machine&& other) noexcept
     , registers_(other.registers_)
     , stack_(other.stack_)
     , memory_(std::move(other.memory_))
+    , pages_(std::move(other.pages_))
+    , written_pages_(other.written_pages_)
+    , hashes_(other.hashes_)
     , keys_(other.keys_)
     , display_(std::move(other.display_))
+    , decode_cache_(std::move(other.decode_cache_))
+    , block_cache_(std::move(other.block_cache_))
+    , backend_(other.backend_)
+    , fusion_counts_(other.fusion_counts_)
     , master_clock_rate_(other.master_clock_rate_)
     , delay_cycles(other.delay_cycles)
     , sound_cycles(other.sound_cycles)
-    , random_engine(other.random_engine)
+    , timer_periods_clock_rate_(other.timer_periods_clock_rate_)
+    , delay_period_(other.delay_period_)
+    , sound_period_(other.sound_period_)
+    , random_(other.random_)
+    , profile_(std::move(other.profile_))
+    , trace_(std::move(other.trace_))
+    , breakpoints_(other.breakpoints_)
+    , hit_(other.hit_)
 {}
 
 auto Machine::operator=(Machine const& other) -> Machine&
@@ -70,11 +112,26 @@ auto Machine::operator=(Machine const& other) -> Machine&
     registers_ = other.registers_;
     stack_ = other.stack_;
     *memory_ = *other.memory_;
+    pages_ = other.pages_;
+    written_pages_ = other.written_pages_;
+    hashes_ = other.hashes_;
     keys_ = other.keys_;
     display_ = other.display_;
+    *decode_cache_ = *other.decode_cache_;
+    block_cache_->invalidate(); // Recompiled on demand
+    backend_ = other.backend_;
+    fusion_counts_ = other.fusion_counts_;
     master_clock_rate_ = other.master_clock_rate_;
     delay_cycles = other.delay_cycles;
-    sound_cycles = other.delay_cycles;
+    sound_cycles = other.sound_cycles;
+    timer_periods_clock_rate_ = other.timer_periods_clock_rate_;
+    delay_period_ = other.delay_period_;
+    sound_period_ = other.sound_period_;
+    random_ = other.random_;
+    profile_ = other.profile_;
+    // The trace is kept, as it may only be recorded by one machine.
+    breakpoints_ = other.breakpoints_;
+    hit_ = other.hit_;
     return *this;
 }
 
@@ -89,66 +146,687 @@ auto Machine::operator=(Machine&& other) noexcept -> Machine&
     registers_ = other.registers_;
     stack_ = other.stack_;
     memory_ = std::move(other.memory_);
+    pages_ = std::move(other.pages_);
+    written_pages_ = other.written_pages_;
+    hashes_ = other.hashes_;
     keys_ = other.keys_;
     display_ = std::move(other.display_);
+    decode_cache_ = std::move(other.decode_cache_);
+    block_cache_ = std::move(other.block_cache_);
+    backend_ = other.backend_;
+    fusion_counts_ = other.fusion_counts_;
     master_clock_rate_ = other.master_clock_rate_;
     delay_cycles = other.delay_cycles;
-    sound_cycles = other.delay_cycles;
+    sound_cycles = other.sound_cycles;
+    timer_periods_clock_rate_ = other.timer_periods_clock_rate_;
+    delay_period_ = other.delay_period_;
+    sound_period_ = other.sound_period_;
+    random_ = other.random_;
+    profile_ = std::move(other.profile_);
+    trace_ = std::move(other.trace_);
+    breakpoints_ = other.breakpoints_;
+    hit_ = other.hit_;
     return *this;
 }
 
+Machine::Hashes::Hashes(Hashes const& other) noexcept
+{
+    *this = other;
+}
+
+auto Machine::Hashes::operator=(Hashes const& other) noexcept -> Hashes&
+{
+    for (std::size_t p = 0; p < page_count; ++p) {
+        gsl::at(pages, static_cast<gsl::index>(p))
+            .store(gsl::at(other.pages, static_cast<gsl::index>(p)).load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+    }
+    unhashed_pages.store(
+        other.unhashed_pages.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    display.store(other.display.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    display_generation.store(
+        other.display_generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    display_hashed.store(
+        other.display_hashed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+auto Machine::hash() const noexcept -> std::uint64_t
+{
+    // The hashes of the pages that were written are stored before they are marked current.
+    std::array<std::uint64_t, page_count> pages{};
+    auto const unhashed = hashes_.unhashed_pages.load(std::memory_order_acquire);
+    for (std::size_t p = 0; p < page_count; ++p) {
+        auto& page = gsl::at(hashes_.pages, static_cast<gsl::index>(p));
+        auto& h = gsl::at(pages, static_cast<gsl::index>(p));
+        if ((unhashed & (Hashes::PageMask{1} << p)) == 0) {
+            h = page.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        utility::Fnv1a page_hash;
+        auto const* const data = memory_->data() + p * page_size;
+        std::for_each(data, data + page_size, [&page_hash](Byte const b) { page_hash.add(b); });
+        h = page_hash.value();
+        page.store(h, std::memory_order_relaxed);
+    }
+    if (unhashed != 0) {
+        hashes_.unhashed_pages.fetch_and(~unhashed, std::memory_order_release);
+    }
+
+    auto display_hash = std::uint64_t{0};
+    if (hashes_.display_hashed.load(std::memory_order_acquire)
+        && hashes_.display_generation.load(std::memory_order_acquire) == display_.generation()) {
+        display_hash = hashes_.display.load(std::memory_order_relaxed);
+    } else {
+        display_hash = display_.hash();
+        hashes_.display.store(display_hash, std::memory_order_relaxed);
+        hashes_.display_generation.store(display_.generation(), std::memory_order_release);
+        hashes_.display_hashed.store(true, std::memory_order_release);
+    }
+
+    // Only the elements of the stack below its size are hashed, as the elements above it cannot
+    // differ between equal stacks.
+    utility::Fnv1a h;
+    h.add(static_cast<Byte>(fault_ != std::nullopt));
+    if (fault_ != std::nullopt) {
+        h.add(static_cast<Byte>(fault_->type));
+        h.add_integer(fault_->address);
+    }
+    h.add_integer(program_counter_);
+    for (auto r = Byte{0}; r <= libnpln::detail::to_underlying(Register::vf); ++r) {
+        h.add(registers_[static_cast<Register>(r)]);
+    }
+    h.add(registers_.dt);
+    h.add(registers_.st);
+    h.add_integer(registers_.i);
+    h.add(static_cast<Byte>(stack_.size()));
+    for (auto const a : stack_) {
+        h.add_integer(a);
+    }
+    h.add_integer(static_cast<std::uint16_t>(keys_.to_ulong()));
+    h.add_integer(display_hash);
+    for (auto const page : pages) {
+        h.add_integer(page);
+    }
+    return h.value();
+}
+
 auto Machine::cycle() -> bool
 {
+    return run(1).reason != StopReason::fault;
+}
+
+auto Machine::run(std::size_t const cycle_budget, flags::flags<StopReason> const stop_reasons)
+    -> RunResult
+{
+    auto const hit = std::exchange(hit_, std::nullopt);
     if (fault_ != std::nullopt) {
-        return false;
+        return {StopReason::fault, 0};
     }
 
-    auto const iw = fetch();
-    if (iw == std::nullopt) {
-        fault_ = Fault{Fault::Type::invalid_address, program_counter_};
-        return false;
+    update_timer_periods();
+
+    // Instrumented runs use the switched backend without skipping idle loops, so that every
+    // instruction is counted and checked.
+    auto const profiled = profile_ != std::nullopt;
+    auto const traced = tracing_enabled && trace_ != nullptr;
+    auto const debugged = !breakpoints_.empty();
+    if (profiled || traced || debugged) {
+        auto const resuming = hit != std::nullopt && hit->type == Hit::Type::breakpoint
+            && hit->address == program_counter_;
+        return run_instrumented(
+            cycle_budget, stop_reasons, profiled, traced, debugged, resuming);
     }
 
-    auto const i = Instruction::decode(*iw);
-    if (i == std::nullopt) {
-        fault_ = Fault{Fault::Type::invalid_instruction, program_counter_};
-        return false;
+    switch (backend_) {
+    case Backend::switched:
+        return run_switched<false, false, false>(cycle_budget, stop_reasons, false);
+    case Backend::threaded: return run_threaded<false>(cycle_budget, stop_reasons);
+    case Backend::compiled: return run_threaded<true>(cycle_budget, stop_reasons);
     }
 
-    auto const ft = execute(*i);
-    if (ft != std::nullopt) {
-        fault_ = Fault{*ft, program_counter_};
-        return false;
+    throw std::out_of_range("Unknown Backend in Machine::run");
+}
+
+auto Machine::snapshot() -> Snapshot
+{
+    // A written page is only copied if it was changed, as writes through memory() are not known
+    // to change anything.
+    for (std::size_t p = 0; p < page_count; ++p) {
+        if (!written_pages_.test(p)) {
+            continue;
+        }
+
+        auto const* const data = memory_->data() + p * page_size;
+        auto& page = gsl::at(pages_, static_cast<gsl::index>(p));
+        if (page == nullptr || !std::equal(data, data + page_size, std::begin(*page))) {
+            auto copy = std::make_shared<Page>();
+            std::copy(data, data + page_size, std::begin(*copy));
+            page = std::move(copy);
+        }
     }
+    written_pages_.reset();
+
+    Snapshot s;
+    s.fault_ = fault_;
+    s.program_counter_ = program_counter_;
+    s.registers_ = registers_;
+    s.stack_ = stack_;
+    s.pages_ = pages_;
+    s.keys_ = keys_;
+    s.display_ = display_;
+    s.master_clock_rate_ = master_clock_rate_;
+    s.delay_cycles_ = delay_cycles;
+    s.sound_cycles_ = sound_cycles;
+    s.timer_periods_clock_rate_ = timer_periods_clock_rate_;
+    s.delay_period_ = delay_period_;
+    s.sound_period_ = sound_period_;
+    s.random_ = random_;
+    return s;
+}
 
-    ++delay_cycles;
-    if (master_clock_rate_ / delay_cycles <= delay_clock_rate) {
-        delay_cycles = 0;
-        if (registers_.dt > 0) {
-            --registers_.dt;
+auto Machine::restore(Snapshot const& s) -> void
+{
+    // A page that is shared with the snapshot and was not written since is already in memory.
+    for (std::size_t p = 0; p < page_count; ++p) {
+        auto const& page = gsl::at(s.pages_, static_cast<gsl::index>(p));
+        if (page == gsl::at(pages_, static_cast<gsl::index>(p)) && !written_pages_.test(p)) {
+            continue;
         }
+
+        std::copy(std::begin(*page), std::end(*page), memory_->data() + p * page_size);
+        invalidate_code(static_cast<Address>(p * page_size), page_size);
+        hashes_.unhash_pages(Hashes::PageMask{1} << p);
     }
+    pages_ = s.pages_;
+    written_pages_.reset();
+
+    fault_ = s.fault_;
+    program_counter_ = s.program_counter_;
+    registers_ = s.registers_;
+    stack_ = s.stack_;
+    keys_ = s.keys_;
+    display_.copy_pixels(s.display_); // Keeps the changes meaningful to observers of the display
+    master_clock_rate_ = s.master_clock_rate_;
+    delay_cycles = s.delay_cycles_;
+    sound_cycles = s.sound_cycles_;
+    timer_periods_clock_rate_ = s.timer_periods_clock_rate_;
+    delay_period_ = s.delay_period_;
+    sound_period_ = s.sound_period_;
+    random_ = s.random_;
+}
 
-    ++sound_cycles;
-    if (master_clock_rate_ / sound_cycles <= sound_clock_rate) {
-        sound_cycles = 0;
-        if (registers_.st > 0) {
-            --registers_.st;
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+auto Machine::run_instrumented(std::size_t const cycle_budget,
+    flags::flags<StopReason> const stop_reasons, bool const profiled, bool const traced,
+    bool const debugged, bool const resuming) -> RunResult
+{
+    auto const instruments = static_cast<unsigned>(profiled) | static_cast<unsigned>(traced) << 1U
+        | static_cast<unsigned>(debugged) << 2U;
+    switch (instruments) {
+    case 0b001U: return run_switched<true, false, false>(cycle_budget, stop_reasons, resuming);
+    case 0b010U: return run_switched<false, true, false>(cycle_budget, stop_reasons, resuming);
+    case 0b011U: return run_switched<true, true, false>(cycle_budget, stop_reasons, resuming);
+    case 0b100U: return run_switched<false, false, true>(cycle_budget, stop_reasons, resuming);
+    case 0b101U: return run_switched<true, false, true>(cycle_budget, stop_reasons, resuming);
+    case 0b110U: return run_switched<false, true, true>(cycle_budget, stop_reasons, resuming);
+    case 0b111U: return run_switched<true, true, true>(cycle_budget, stop_reasons, resuming);
+    default: return run_switched<false, false, false>(cycle_budget, stop_reasons, resuming);
+    }
+}
+
+template<bool Profiled, bool Traced, bool Debugged>
+auto Machine::run_switched(std::size_t const cycle_budget,
+    flags::flags<StopReason> const stop_reasons, [[maybe_unused]] bool const resuming) -> RunResult
+{
+    // The trace is never recorded if tracing was compiled out.
+    constexpr auto traced = Traced && tracing_enabled;
+
+    auto const stop_on_wait_for_key = static_cast<bool>(stop_reasons & StopReason::wait_for_key);
+    auto const stop_on_display_changed =
+        static_cast<bool>(stop_reasons & StopReason::display_changed);
+
+    [[maybe_unused]] auto changes = RegisterChanges{registers_};
+
+    std::size_t cycles = 0;
+    while (cycles < cycle_budget) {
+        if (std::size_t{program_counter_} + 1 >= memory_->size()) {
+            fault_ = Fault{Fault::Type::invalid_address, program_counter_};
+            return {StopReason::fault, cycles};
+        }
+
+        if constexpr (Debugged) {
+            if (breakpoints_.breakpoints()[program_counter_] && !(resuming && cycles == 0)) {
+                hit_ = Hit{Hit::Type::breakpoint, program_counter_, 0};
+                return {StopReason::breakpoint, cycles};
+            }
+        }
+
+        auto const& i = decode_cache_->decode(*memory_, program_counter_);
+        if (i == std::nullopt) {
+            fault_ = Fault{Fault::Type::invalid_instruction, program_counter_};
+            return {StopReason::fault, cycles};
+        }
+
+        [[maybe_unused]] auto const address = program_counter_;
+        [[maybe_unused]] auto const index = registers_.i;
+        // The word is read before execution, which may write over it.
+        [[maybe_unused]] Word word = 0;
+        if constexpr (traced) {
+            word = make_word((*memory_)[address], (*memory_)[address + 1]);
+        }
+        auto const ft = execute(*i);
+        if (ft != std::nullopt) {
+            fault_ = Fault{*ft, program_counter_};
+            return {StopReason::fault, cycles};
+        }
+        [[maybe_unused]] std::uint32_t changed_registers = 0;
+        if constexpr (traced || Debugged) {
+            changed_registers = changes.update(registers_);
+        }
+        if constexpr (Profiled) {
+            profile_->record(address, i->op, program_counter_);
+        }
+        if constexpr (traced) {
+            trace_->record(address, word, changed_registers);
+        }
+
+        tick_timers();
+        if constexpr (traced || Debugged) {
+            changes.tick(registers_);
+        }
+        ++cycles;
+
+        if constexpr (Debugged) {
+            hit_ = breakpoints_.check(*i, address, index, changed_registers);
+            if (hit_ != std::nullopt) {
+                return {StopReason::watchpoint, cycles};
+            }
+        }
+
+        // The decoding remains intact even if execution invalidated it.
+        if (stop_on_display_changed
+            && (i->op == Operator::cls || i->op == Operator::drw_v_v_n)) {
+            return {StopReason::display_changed, cycles};
+        }
+        if (stop_on_wait_for_key && i->op == Operator::wkp_v && keys_.none()) {
+            return {StopReason::wait_for_key, cycles};
+        }
+
+        // Only jumps and key waits can enter an idle loop.
+        if constexpr (!Profiled && !Traced && !Debugged) {
+            if (i->op == Operator::jmp_a || i->op == Operator::wkp_v) {
+                cycles += skip_idle(cycle_budget - cycles);
+            }
         }
     }
 
-    return true;
+    return {StopReason::budget_exhausted, cycles};
 }
 
-auto Machine::fetch() noexcept -> std::optional<Word>
+// The handler of each operator, in the order of OperatorId, as pairs of the identifier and the
+// expression that executes the instruction word w on the machine m.  The invalid identifier is
+// handled by faulting, as the switched backend does for a word that does not decode.
+#define LIBNPLN_MACHINE_HANDLERS(X)                                                                \
+    X(cls, m.execute_cls())                                                                        \
+    X(ret, m.execute_ret())                                                                        \
+    X(jmp_a, m.execute_jmp_a(AOperands::decode(w)))                                                \
+    X(call_a, m.execute_call_a(AOperands::decode(w)))                                              \
+    X(seq_v_b, m.execute_seq_v_b(VBOperands::decode(w)))                                           \
+    X(sne_v_b, m.execute_sne_v_b(VBOperands::decode(w)))                                           \
+    X(seq_v_v, m.execute_seq_v_v(VVOperands::decode(w)))                                           \
+    X(mov_v_b, m.execute_mov_v_b(VBOperands::decode(w)))                                           \
+    X(add_v_b, m.execute_add_v_b(VBOperands::decode(w)))                                           \
+    X(mov_v_v, m.execute_mov_v_v(VVOperands::decode(w)))                                           \
+    X(or_v_v, m.execute_or_v_v(VVOperands::decode(w)))                                             \
+    X(and_v_v, m.execute_and_v_v(VVOperands::decode(w)))                                           \
+    X(xor_v_v, m.execute_xor_v_v(VVOperands::decode(w)))                                           \
+    X(add_v_v, m.execute_add_v_v(VVOperands::decode(w)))                                           \
+    X(sub_v_v, m.execute_sub_v_v(VVOperands::decode(w)))                                           \
+    X(shr_v, m.execute_shr_v(VOperands::decode(w)))                                                \
+    X(subn_v_v, m.execute_subn_v_v(VVOperands::decode(w)))                                         \
+    X(shl_v, m.execute_shl_v(VOperands::decode(w)))                                                \
+    X(sne_v_v, m.execute_sne_v_v(VVOperands::decode(w)))                                           \
+    X(mov_i_a, m.execute_mov_i_a(AOperands::decode(w)))                                            \
+    X(jmp_v0_a, m.execute_jmp_v0_a(AOperands::decode(w)))                                          \
+    X(rnd_v_b, m.execute_rnd_v_b(VBOperands::decode(w)))                                           \
+    X(drw_v_v_n, m.execute_drw_v_v_n(VVNOperands::decode(w)))                                      \
+    X(skp_v, m.execute_skp_v(VOperands::decode(w)))                                                \
+    X(sknp_v, m.execute_sknp_v(VOperands::decode(w)))                                              \
+    X(mov_v_dt, m.execute_mov_v_dt(VOperands::decode(w)))                                          \
+    X(wkp_v, m.execute_wkp_v(VOperands::decode(w)))                                                \
+    X(mov_dt_v, m.execute_mov_dt_v(VOperands::decode(w)))                                          \
+    X(mov_st_v, m.execute_mov_st_v(VOperands::decode(w)))                                          \
+    X(add_i_v, m.execute_add_i_v(VOperands::decode(w)))                                            \
+    X(font_v, m.execute_font_v(VOperands::decode(w)))                                              \
+    X(bcd_v, m.execute_bcd_v(VOperands::decode(w)))                                                \
+    X(mov_ii_v, m.execute_mov_ii_v(VOperands::decode(w)))                                          \
+    X(mov_v_ii, m.execute_mov_v_ii(VOperands::decode(w)))                                          \
+    X(invalid, Result{Fault::Type::invalid_instruction})
+
+// Loads the word of the instruction at the program counter into w.
+#define LIBNPLN_MACHINE_LOAD()                                                                     \
+    w = make_word(memory[program_counter_], memory[program_counter_ + 1]) // Big-endian
+
+// Fetches the word of the next instruction into w, or stops if the cycle budget is exhausted or the
+// program counter is out of bounds.
+#define LIBNPLN_MACHINE_FETCH()                                                                    \
+    if (cycles == cycle_budget) {                                                                  \
+        return {StopReason::budget_exhausted, cycles};                                             \
+    }                                                                                              \
+    if (std::size_t{program_counter_} + 1 >= memory.size()) {                                      \
+        fault_ = Fault{Fault::Type::invalid_address, program_counter_};                            \
+        return {StopReason::fault, cycles};                                                        \
+    }                                                                                              \
+    LIBNPLN_MACHINE_LOAD()
+
+// Completes the cycle of the instruction executed with result ft, or stops if it faulted or if it
+// meets a requested stop reason.  Then skips the idle loop that the instruction entered, if any.
+#define LIBNPLN_MACHINE_RETIRE(id)                                                                 \
+    if (ft != std::nullopt) {                                                                      \
+        fault_ = Fault{*ft, program_counter_};                                                     \
+        return {StopReason::fault, cycles};                                                        \
+    }                                                                                              \
+    tick_timers();                                                                                 \
+    ++cycles;                                                                                      \
+    if (stop_on_display_changed && changes_display(id)) {                                          \
+        return {StopReason::display_changed, cycles};                                              \
+    }                                                                                              \
+    if (stop_on_wait_for_key && (id) == OperatorId::wkp_v && keys_.none()) {                       \
+        return {StopReason::wait_for_key, cycles};                                                 \
+    }                                                                                              \
+    if ((id) == OperatorId::jmp_a || (id) == OperatorId::wkp_v) {                                  \
+        cycles += skip_idle(cycle_budget - cycles);                                                \
+    }
+
+template<bool CompileBlocks>
+auto Machine::run_threaded(
+    std::size_t const cycle_budget, flags::flags<StopReason> const stop_reasons) -> RunResult
 {
-    if (program_counter_ + 1 >= memory_->size()) {
-        return std::nullopt;
+    auto const stop_on_wait_for_key = static_cast<bool>(stop_reasons & StopReason::wait_for_key);
+    auto const stop_on_display_changed =
+        static_cast<bool>(stop_reasons & StopReason::display_changed);
+    constexpr auto changes_display = [](OperatorId const id) {
+        return id == OperatorId::cls || id == OperatorId::drw_v_v_n;
+    };
+
+    auto const& memory = *memory_;
+    std::size_t cycles = 0;
+    Word w = 0;
+    Result ft;
+
+    // The address that the current instruction of a fusion falls through to.
+    Address fall_through = 0;
+
+#if defined(__GNUC__) && !defined(LIBNPLN_NO_COMPUTED_GOTO)
+    // Each handler ends with its own copy of the dispatch to the next handler, so that the indirect
+    // branch of every handler is predicted separately.  The retirement checks for a handler's
+    // operator are constant and fold away in every other handler.
+    auto& m = *this;
+
+#    define LIBNPLN_MACHINE_LABEL(id, execution) &&handle_##id,
+    static void* const labels[] = {
+        LIBNPLN_MACHINE_HANDLERS(LIBNPLN_MACHINE_LABEL) // Indexed by OperatorId
+        &&fuse_draw_sprite, // Indexed by Fusion
+        &&fuse_wait_delay,
+        &&fuse_count_loop,
+    };
+#    undef LIBNPLN_MACHINE_LABEL
+    static_assert(std::size(labels) == DecodeCache::handler_count);
+
+#    define LIBNPLN_MACHINE_DISPATCH()                                                             \
+        LIBNPLN_MACHINE_FETCH();                                                                   \
+        goto* labels[decode_cache_->decode_handler(memory, program_counter_)]
+
+    LIBNPLN_MACHINE_DISPATCH();
+
+    // The handlers of the block operators first run the compiled block at the program counter, if
+    // blocks are compiled and it is worth running, so that no other instruction pays to look it up.
+#    define LIBNPLN_MACHINE_HANDLE(id, execution)                                                  \
+        handle_##id:                                                                               \
+        if constexpr (CompileBlocks && is_block_operator(OperatorId::id)) {                        \
+            if (auto const size = run_block(cycle_budget - cycles); size != 0) {                   \
+                cycles += size;                                                                    \
+                LIBNPLN_MACHINE_DISPATCH();                                                        \
+            }                                                                                      \
+        }                                                                                          \
+        ft = (execution);                                                                          \
+        LIBNPLN_MACHINE_RETIRE(OperatorId::id)                                                     \
+        LIBNPLN_MACHINE_DISPATCH();
+    LIBNPLN_MACHINE_HANDLERS(LIBNPLN_MACHINE_HANDLE)
+#    undef LIBNPLN_MACHINE_HANDLE
+
+    // A fused handler executes the instructions of its fusion without fetching or dispatching
+    // between them, and ends in the handler of the final instruction.  A fusion that does not fit
+    // in the remaining budget is executed as separate instructions instead.
+#    define LIBNPLN_MACHINE_ENTER(fusion, first_id)                                                \
+        if (cycle_budget - cycles < get_length(Fusion::fusion)) {                                  \
+            goto handle_##first_id;                                                                \
+        }                                                                                          \
+        ++fusion_counts_[static_cast<std::size_t>(Fusion::fusion)]
+
+fuse_draw_sprite:
+    LIBNPLN_MACHINE_ENTER(draw_sprite, mov_i_a);
+    ft = execute_mov_i_a(AOperands::decode(w));
+    LIBNPLN_MACHINE_RETIRE(OperatorId::mov_i_a)
+    LIBNPLN_MACHINE_LOAD();
+    goto handle_drw_v_v_n;
+
+fuse_wait_delay:
+    LIBNPLN_MACHINE_ENTER(wait_delay, mov_v_dt);
+    ft = execute_mov_v_dt(VOperands::decode(w));
+    LIBNPLN_MACHINE_RETIRE(OperatorId::mov_v_dt)
+    LIBNPLN_MACHINE_LOAD();
+    fall_through = program_counter_ + Instruction::width;
+    ft = execute_seq_v_b(VBOperands::decode(w));
+    LIBNPLN_MACHINE_RETIRE(OperatorId::seq_v_b)
+    if (program_counter_ != fall_through) {
+        LIBNPLN_MACHINE_DISPATCH();
+    }
+    LIBNPLN_MACHINE_LOAD();
+    goto handle_jmp_a;
+
+fuse_count_loop:
+    LIBNPLN_MACHINE_ENTER(count_loop, add_v_b);
+    ft = execute_add_v_b(VBOperands::decode(w));
+    LIBNPLN_MACHINE_RETIRE(OperatorId::add_v_b)
+    LIBNPLN_MACHINE_LOAD();
+    fall_through = program_counter_ + Instruction::width;
+    ft = execute_sne_v_b(VBOperands::decode(w));
+    LIBNPLN_MACHINE_RETIRE(OperatorId::sne_v_b)
+    if (program_counter_ != fall_through) {
+        LIBNPLN_MACHINE_DISPATCH();
     }
+    LIBNPLN_MACHINE_LOAD();
+    goto handle_jmp_a;
+
+#    undef LIBNPLN_MACHINE_ENTER
+#    undef LIBNPLN_MACHINE_DISPATCH
+#else
+    // Without computed goto, the handlers are called through a table of function pointers from a
+    // single dispatch loop.
+    using Handler = auto (*)(Machine & m, Word w) -> Result;
+
+#    define LIBNPLN_MACHINE_HANDLER(id, execution)                                                 \
+        +[]([[maybe_unused]] Machine& m, [[maybe_unused]] Word const w) -> Result {                \
+            return execution;                                                                      \
+        },
+    static constexpr Handler handlers[] = {LIBNPLN_MACHINE_HANDLERS(LIBNPLN_MACHINE_HANDLER)};
+#    undef LIBNPLN_MACHINE_HANDLER
+    static_assert(std::size(handlers) == operator_id_count);
+
+    for (;;) {
+        LIBNPLN_MACHINE_FETCH();
+        auto const handler = decode_cache_->decode_handler(memory, program_counter_);
+        if constexpr (CompileBlocks) {
+            auto const is_block = handler < operator_id_count
+                && is_block_operator(static_cast<OperatorId>(handler));
+            if (is_block) {
+                if (auto const size = run_block(cycle_budget - cycles); size != 0) {
+                    cycles += size;
+                    continue;
+                }
+            }
+        }
+        if (handler < operator_id_count) {
+            ft = handlers[handler](*this, w);
+            LIBNPLN_MACHINE_RETIRE(static_cast<OperatorId>(handler))
+            continue;
+        }
+
+        // The instructions of a fusion are executed by an inner loop that neither fetches nor
+        // dispatches between them.  A fusion that does not fit in the remaining budget is executed
+        // as separate instructions instead.
+        auto const f = static_cast<Fusion>(handler - operator_id_count);
+        auto const ids = get_operators(f);
+        auto length = get_length(f);
+        if (cycle_budget - cycles < length) {
+            length = 1;
+        }
+        else {
+            ++fusion_counts_[static_cast<std::size_t>(f)];
+        }
 
-    auto const high = gsl::at(*memory_, program_counter_ + 0);
-    auto const low = gsl::at(*memory_, program_counter_ + 1);
-    return make_word(high, low); // Big-endian
+        for (std::size_t i = 0; i < length; ++i) {
+            if (i > 0) {
+                if (program_counter_ != fall_through) {
+                    break;
+                }
+                LIBNPLN_MACHINE_LOAD();
+            }
+
+            fall_through = program_counter_ + Instruction::width;
+            auto const id = ids[i];
+            ft = handlers[libnpln::detail::to_underlying(id)](*this, w);
+            LIBNPLN_MACHINE_RETIRE(id)
+        }
+    }
+#endif
+}
+
+#undef LIBNPLN_MACHINE_RETIRE
+#undef LIBNPLN_MACHINE_FETCH
+#undef LIBNPLN_MACHINE_LOAD
+#undef LIBNPLN_MACHINE_HANDLERS
+
+auto Machine::run_block(Block const& block) noexcept -> std::size_t
+{
+    BlockRegisters r{registers_};
+    block.run(r);
+    r.store(registers_);
+
+    // No operation of a block reads or writes the timers, so they may lag behind until the end of
+    // the block.
+    program_counter_ += block.size * Instruction::width;
+    advance_timers(block.size);
+    return block.size;
+}
+
+// Fast-forwards through the idle loop at the program counter, if any, for at most the given number
+// of cycles.  An idle loop has no effect other than reading the delay timer or the keys, so only
+// the timers and the registers that it reads them into need to be advanced.  Returns the number of
+// cycles that were skipped.
+auto Machine::skip_idle(std::size_t const cycle_budget) -> std::size_t
+{
+    auto const& memory = *memory_;
+    if (cycle_budget == 0 || std::size_t{program_counter_} + 1 >= memory.size()) {
+        return 0;
+    }
+
+    auto const& i = decode_cache_->decode(memory, program_counter_);
+    if (i == std::nullopt) {
+        return 0;
+    }
+
+    // Neither a key wait without a pressed key nor a jump to itself ever ends within a run.
+    auto const waits_for_key = i->op == Operator::wkp_v && keys_.none();
+    auto const jumps_to_itself =
+        i->op == Operator::jmp_a && std::get<AOperands>(i->args).address == program_counter_;
+    if (waits_for_key || jumps_to_itself) {
+        advance_timers(cycle_budget);
+        return cycle_budget;
+    }
+
+    // A delay loop reads the delay timer into a register until it reads the awaited value, then
+    // skips the jump back to its beginning.
+    static constexpr auto wait_delay =
+        operator_id_count + static_cast<std::size_t>(Fusion::wait_delay);
+    if (decode_cache_->decode_handler(memory, program_counter_) != wait_delay) {
+        return 0;
+    }
+
+    auto const vx = std::get<VOperands>(i->args).vx;
+    auto const compare = std::get<VBOperands>(
+        decode_cache_->decode(memory, program_counter_ + Instruction::width)->args);
+    auto const jump = std::get<AOperands>(
+        decode_cache_->decode(memory, program_counter_ + 2 * Instruction::width)->args);
+    if (compare.vx != vx || jump.address != program_counter_
+        || registers_.dt == compare.byte) {
+        return 0;
+    }
+
+    static constexpr auto loop_cycles = get_length(Fusion::wait_delay);
+    auto const delay_after = [this](std::size_t const cycles) {
+        auto const ticks = (delay_cycles + cycles) / delay_period_;
+        return ticks < registers_.dt ? static_cast<Byte>(registers_.dt - ticks) : Byte{0};
+    };
+
+    // The delay timer only counts down, so the loop never ends if the timer is already below the
+    // awaited value, or if it passes the value between two reads.
+    auto iterations = cycle_budget / loop_cycles;
+    if (registers_.dt > compare.byte) {
+        auto const until_awaited =
+            (registers_.dt - compare.byte) * delay_period_ - delay_cycles;
+        auto const last = (until_awaited + loop_cycles - 1) / loop_cycles;
+        if (delay_after(last * loop_cycles) == compare.byte) {
+            iterations = std::min(iterations, last);
+        }
+    }
+    if (iterations == 0) {
+        return 0;
+    }
+
+    registers_[vx] = delay_after((iterations - 1) * loop_cycles);
+    advance_timers(iterations * loop_cycles);
+    return iterations * loop_cycles;
+}
+
+auto Machine::update_timer_periods() -> void
+{
+    if (timer_periods_clock_rate_ == master_clock_rate_) {
+        return;
+    }
+
+    // A timer register is decremented after the least number of master cycles over which the
+    // master clock rate no longer exceeds the timer clock rate.
+    auto const period = [this](frequencypp::hertz const timer_clock_rate) {
+        auto const elapsed = [&](std::size_t const n) {
+            return master_clock_rate_ / n <= timer_clock_rate;
+        };
+
+        std::size_t high = 1;
+        while (!elapsed(high)) {
+            high *= 2;
+        }
+
+        auto low = high / 2;
+        while (high - low > 1) {
+            auto const middle = low + (high - low) / 2;
+            (elapsed(middle) ? high : low) = middle;
+        }
+
+        return high;
+    };
+
+    delay_period_ = period(delay_clock_rate);
+    sound_period_ = period(sound_clock_rate);
+
+    // A counter that reached a shorter period decrements its timer on the next cycle, as it does
+    // when it counts up to the period.
+    delay_cycles = std::min(delay_cycles, delay_period_ - 1);
+    sound_cycles = std::min(sound_cycles, sound_period_ - 1);
+    timer_periods_clock_rate_ = master_clock_rate_;
 }
 
 auto Machine::execute(Instruction const& instr) -> Result
@@ -402,12 +1080,7 @@ auto Machine::execute_jmp_v0_a(AOperands const& args) -> Result
 
 auto Machine::execute_rnd_v_b(VBOperands const& args) -> Result
 {
-    static std::uniform_int_distribution<std::size_t> byte_dist{
-        std::numeric_limits<Byte>::min(),
-        std::numeric_limits<Byte>::max(),
-    };
-
-    registers_[args.vx] = static_cast<Byte>(byte_dist(random_engine) & args.byte);
+    registers_[args.vx] = static_cast<Byte>(random_() & args.byte);
 
     program_counter_ += Instruction::width;
     return std::nullopt;
@@ -425,28 +1098,9 @@ auto Machine::execute_drw_v_v_n(VVNOperands const& args) -> Result
 
     // Each byte of sprite data is drawn on its own row.
     // Each bit of sprite row data is a pixel.
-    static constexpr auto row_bits = std::numeric_limits<Byte>::digits;
-    auto const x0 = registers_[args.vx];
-    auto const y0 = registers_[args.vy];
-    registers_.vf = 0U; // Pixel cleared
-    for (std::size_t i = 0; i < args.nibble; ++i) {
-        auto const y = y0 + i;
-        auto const a = registers_.i + i;
-        auto const row = gsl::at(*memory_, static_cast<gsl::index>(a));
-        for (std::size_t j = 0; j < row_bits; ++j) {
-            auto const x = x0 + j;
-            auto* p = display_.pixel(x, y);
-            if (p == nullptr) {
-                break; // Prevent drawing outside of the display_
-            }
-
-            auto const bit = (row & (1U << (row_bits - j - 1))) != 0;
-            if (*p && bit) {
-                registers_.vf = 1U; // Pixel cleared
-            }
-            *p = bit != *p;
-        }
-    }
+    auto const sprite = gsl::span<Byte const>{memory_->data() + registers_.i, args.nibble};
+    auto const cleared = display_.draw_sprite(registers_[args.vx], registers_[args.vy], sprite);
+    registers_.vf = cleared ? 1U : 0U; // Pixel cleared
 
     program_counter_ += Instruction::width;
     return std::nullopt;
@@ -551,6 +1205,7 @@ auto Machine::execute_bcd_v(VOperands const& args) -> Result
     gsl::at(*memory_, registers_.i + 0) = x / 100;
     gsl::at(*memory_, registers_.i + 1) = (x % 100) / 10;
     gsl::at(*memory_, registers_.i + 2) = ((x % 100) % 10) / 1;
+    mark_written(registers_.i, 3);
 
     program_counter_ += Instruction::width;
     return std::nullopt;
@@ -567,6 +1222,7 @@ auto Machine::execute_mov_ii_v(VOperands const& args) -> Result
 
     std::transform(std::begin(rs), std::end(rs), std::next(std::begin(*memory_), registers_.i),
         [this](Register const r) { return registers_[r]; });
+    mark_written(registers_.i, static_cast<std::size_t>(d));
 
     program_counter_ += Instruction::width;
     return std::nullopt;
@@ -15,22 +15,37 @@
 #ifndef LIBNPLN_MACHINE_MACHINE_HPP
 #define LIBNPLN_MACHINE_MACHINE_HPP
 
+#include <libnpln/machine/Backend.hpp>
+#include <libnpln/machine/BlockCache.hpp>
+#include <libnpln/machine/Breakpoints.hpp>
 #include <libnpln/machine/DataUnits.hpp>
+#include <libnpln/machine/DecodeCache.hpp>
 #include <libnpln/machine/Display.hpp>
 #include <libnpln/machine/Fault.hpp>
+#include <libnpln/machine/Fusion.hpp>
 #include <libnpln/machine/Instruction.hpp>
 #include <libnpln/machine/Keys.hpp>
 #include <libnpln/machine/Memory.hpp>
+#include <libnpln/machine/Profile.hpp>
+#include <libnpln/machine/Random.hpp>
 #include <libnpln/machine/Registers.hpp>
+#include <libnpln/machine/RunResult.hpp>
+#include <libnpln/machine/Snapshot.hpp>
 #include <libnpln/machine/Stack.hpp>
+#include <libnpln/machine/Trace.hpp>
 #include <libnpln/utility/HexDump.hpp>
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 #include <frequencypp/frequency.hpp>
 
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
-#include <random>
 
 namespace libnpln::machine {
 
@@ -38,6 +53,7 @@ class Machine
 {
 public:
     Machine();
+    explicit Machine(Backend backend);
     Machine(Machine const& other);
     Machine(Machine&& other) noexcept;
     ~Machine() = default;
@@ -47,10 +63,11 @@ public:
 
     auto operator==(Machine const& rhs) const noexcept
     {
-        // Compare display and memory last because they are expensive to compare.
+        // Compare display and memory last because they are expensive to compare, and only if the
+        // hashes match, which is cheap once they have been computed.
         return fault_ == rhs.fault_ && program_counter_ == rhs.program_counter_
             && registers_ == rhs.registers_ && stack_ == rhs.stack_ && keys_ == rhs.keys_
-            && display_ == rhs.display_ && *memory_ == *rhs.memory_;
+            && hash() == rhs.hash() && display_ == rhs.display_ && *memory_ == *rhs.memory_;
     }
 
     auto operator!=(Machine const& rhs) const noexcept
@@ -58,8 +75,29 @@ public:
         return !(*this == rhs);
     }
 
+    // Returns a 64-bit hash of the state that operator== compares.  The hashes of each page of
+    // memory and of the display are kept until they are written, so hashing a machine again only
+    // hashes what changed.  A machine may be hashed or compared by several threads at once, as long
+    // as none of them modifies it; the kept hashes are updated atomically, and threads that race to
+    // hash the same page each hash it.
+    [[nodiscard]] auto hash() const noexcept -> std::uint64_t;
+
     auto cycle() -> bool;
 
+    // Executes up to cycle_budget cycles, stopping early after a cycle that meets any of the given
+    // stop reasons.  Running always stops when the budget is exhausted, a fault occurs, or an armed
+    // breakpoint or watchpoint is hit.
+    auto run(std::size_t cycle_budget, flags::flags<StopReason> stop_reasons = all_stop_reasons)
+        -> RunResult;
+
+    // Captures the state of the machine, sharing the pages of memory that were not written since
+    // the previous snapshot.
+    auto snapshot() -> Snapshot;
+
+    // Restores the state captured in a snapshot of this or any other machine.  Only the pages of
+    // memory that differ from the snapshot are copied.  The backend is not part of the state.
+    auto restore(Snapshot const& s) -> void;
+
     auto fault() noexcept -> std::optional<Fault>&
     {
         return fault_;
@@ -92,8 +130,14 @@ public:
     {
         return stack_;
     }
+    // The memory may be modified through the returned reference, so every cached decoding and
+    // compiled block is invalidated and every page is considered written.  The reference must not
+    // be used to modify the memory after the next cycle or snapshot.
     auto memory() noexcept -> Memory&
     {
+        invalidate_code();
+        written_pages_.set();
+        hashes_.unhash_pages(Hashes::all_pages);
         return *memory_;
     }
     [[nodiscard]] auto memory() const noexcept -> Memory const&
@@ -108,8 +152,11 @@ public:
     {
         return keys_;
     }
+    // The display may be replaced through the returned reference, so its hash is recomputed.  The
+    // reference must not be used to replace the display after the next hash.
     auto display() noexcept -> Display&
     {
+        hashes_.display_hashed.store(false, std::memory_order_relaxed);
         return display_;
     }
     [[nodiscard]] auto display() const noexcept -> Display const&
@@ -117,6 +164,81 @@ public:
         return display_;
     }
 
+    auto backend() noexcept -> Backend&
+    {
+        return backend_;
+    }
+    [[nodiscard]] auto backend() const noexcept -> Backend const&
+    {
+        return backend_;
+    }
+
+    // The number of times that the threaded and compiled backends have executed each fusion.
+    auto fusion_counts() noexcept -> FusionCounts&
+    {
+        return fusion_counts_;
+    }
+    [[nodiscard]] auto fusion_counts() const noexcept -> FusionCounts const&
+    {
+        return fusion_counts_;
+    }
+
+    // The source of the RND instruction, which may be replaced by one with a known seed so that a
+    // run can be reproduced.
+    auto random() noexcept -> Random&
+    {
+        return random_;
+    }
+    [[nodiscard]] auto random() const noexcept -> Random const&
+    {
+        return random_;
+    }
+
+    // While the machine has a profile, every instruction is run by the switched backend without
+    // skipping idle loops, so that the profile counts each of them.  Without one, runs are not
+    // affected by profiling at all.
+    auto profile() noexcept -> std::optional<Profile>&
+    {
+        return profile_;
+    }
+    [[nodiscard]] auto profile() const noexcept -> std::optional<Profile> const&
+    {
+        return profile_;
+    }
+
+    // While the machine has a trace, every instruction is run by the switched backend without
+    // skipping idle loops and recorded in the trace, which another thread may take them from as
+    // they are recorded.  The trace is not shared with copies of the machine, as only one machine
+    // may record it.  If tracing was compiled out, the trace is ignored.
+    auto trace() noexcept -> std::shared_ptr<Trace>&
+    {
+        return trace_;
+    }
+    [[nodiscard]] auto trace() const noexcept -> std::shared_ptr<Trace> const&
+    {
+        return trace_;
+    }
+
+    // While any breakpoint or watchpoint is armed, every instruction is run by the switched backend
+    // without skipping idle loops, so that none of them are missed.  A run stops before executing
+    // an instruction at a breakpoint, except for the first instruction of a run that resumes from
+    // the breakpoint that stopped the previous run, and after executing an instruction that hit a
+    // watchpoint.  With nothing armed, runs are not affected at all.
+    auto breakpoints() noexcept -> Breakpoints&
+    {
+        return breakpoints_;
+    }
+    [[nodiscard]] auto breakpoints() const noexcept -> Breakpoints const&
+    {
+        return breakpoints_;
+    }
+
+    // The breakpoint or watchpoint that stopped the last run, if any.
+    [[nodiscard]] auto hit() const noexcept -> std::optional<Hit> const&
+    {
+        return hit_;
+    }
+
     auto master_clock_rate() noexcept -> frequencypp::hertz&
     {
         return master_clock_rate_;
@@ -133,9 +255,100 @@ public:
     static constexpr Address program_address = 0x200;
 
 private:
+    // Batch converts machines to and from its lanes, including the state of their timers.
+    friend class Batch;
+
     using Result = std::optional<Fault::Type>;
 
-    auto fetch() noexcept -> std::optional<Word>;
+    // Each combination of instruments has its own instantiation of the switched backend, so that
+    // those that are not in use cost nothing.
+    auto run_instrumented(std::size_t cycle_budget, flags::flags<StopReason> stop_reasons,
+        bool profiled, bool traced, bool debugged, bool resuming) -> RunResult;
+    template<bool Profiled, bool Traced, bool Debugged>
+    auto run_switched(std::size_t cycle_budget, flags::flags<StopReason> stop_reasons,
+        bool resuming) -> RunResult;
+    template<bool CompileBlocks>
+    auto run_threaded(std::size_t cycle_budget, flags::flags<StopReason> stop_reasons)
+        -> RunResult;
+
+    // Runs the compiled block at the program counter, which must be within bounds as it is after
+    // every fetch, if it is worth running.  Returns the number of cycles that were run.  The check
+    // is inline, as most instructions of the block operators do not begin a block worth running.
+    auto run_block(std::size_t const cycle_budget) -> std::size_t
+    {
+        // Running a block costs about as much as interpreting a few instructions, so shorter
+        // blocks are interpreted instead.  So is every block that does not fit in the budget.
+        static constexpr std::size_t min_size = 2;
+        auto const block = block_cache_->compile(*memory_, program_counter_);
+        return block.size < min_size || block.size > cycle_budget ? 0 : run_block(block);
+    }
+
+    auto run_block(Block const& block) noexcept -> std::size_t;
+    auto skip_idle(std::size_t cycle_budget) -> std::size_t;
+
+    auto invalidate_code(Address const first, std::size_t const count) noexcept -> void
+    {
+        decode_cache_->invalidate(first, count);
+        block_cache_->invalidate(first, count);
+    }
+
+    auto invalidate_code() noexcept -> void
+    {
+        decode_cache_->invalidate();
+        block_cache_->invalidate();
+    }
+
+    // Must be called after the program writes to memory.
+    auto mark_written(Address const first, std::size_t const count) noexcept -> void
+    {
+        invalidate_code(first, count);
+        auto pages = Hashes::PageMask{0};
+        for (auto p = first / page_size; p <= (first + count - 1) / page_size; ++p) {
+            written_pages_.set(p);
+            pages |= Hashes::PageMask{1} << p;
+        }
+        hashes_.unhash_pages(pages);
+    }
+
+    auto update_timer_periods() -> void;
+
+    // Equivalent to calling tick_timers the given number of times.
+    auto advance_timers(std::size_t const cycles) noexcept -> void
+    {
+        // The counters are always less than the periods, as ensured by update_timer_periods.  Most
+        // advances are shorter than a period, which needs no division.
+        delay_cycles += cycles;
+        if (delay_cycles >= delay_period_) {
+            auto const delay_ticks = delay_cycles / delay_period_;
+            delay_cycles %= delay_period_;
+            registers_.dt = delay_ticks < registers_.dt ? registers_.dt - delay_ticks : 0;
+        }
+
+        sound_cycles += cycles;
+        if (sound_cycles >= sound_period_) {
+            auto const sound_ticks = sound_cycles / sound_period_;
+            sound_cycles %= sound_period_;
+            registers_.st = sound_ticks < registers_.st ? registers_.st - sound_ticks : 0;
+        }
+    }
+
+    auto tick_timers() noexcept -> void
+    {
+        if (++delay_cycles >= delay_period_) {
+            delay_cycles = 0;
+            if (registers_.dt > 0) {
+                --registers_.dt;
+            }
+        }
+
+        if (++sound_cycles >= sound_period_) {
+            sound_cycles = 0;
+            if (registers_.st > 0) {
+                --registers_.st;
+            }
+        }
+    }
+
     auto execute(Instruction const& instr) -> Result;
     auto execute_cls() -> Result;
     auto execute_ret() -> Result;
@@ -177,9 +390,51 @@ private:
     Registers registers_;
     Stack stack_;
     std::unique_ptr<Memory> memory_;
+    // The pages of memory as of the last snapshot, and which of them have been written since.
+    Pages pages_;
+    std::bitset<page_count> written_pages_;
+
+    // The hashes of the pages of memory and of the display as of the last hash, and which of them
+    // have been written since.  A hash is stored before it is marked current, so a thread that
+    // finds it current also finds it stored.
+    struct Hashes
+    {
+        using PageMask = std::uint32_t;
+        static_assert(page_count <= 32);
+        static constexpr auto all_pages =
+            static_cast<PageMask>((std::uint64_t{1} << page_count) - 1);
+
+        Hashes() = default;
+        Hashes(Hashes const& other) noexcept;
+        ~Hashes() = default;
+
+        auto operator=(Hashes const& other) noexcept -> Hashes&;
+
+        // Marks pages as written.  Must not be called while the machine is being hashed.
+        auto unhash_pages(PageMask const pages) noexcept -> void
+        {
+            unhashed_pages.store(
+                unhashed_pages.load(std::memory_order_relaxed) | pages, std::memory_order_relaxed);
+        }
+
+        std::array<std::atomic<std::uint64_t>, page_count> pages{};
+        std::atomic<PageMask> unhashed_pages{all_pages};
+        std::atomic<std::uint64_t> display{0};
+        std::atomic<Display::Generation> display_generation{0};
+        std::atomic<bool> display_hashed{false};
+    };
+    mutable Hashes hashes_;
+
     Keys keys_;
     Display display_;
 
+    // Decodings of the instructions in memory_, which must be invalidated on every write to it.
+    std::unique_ptr<DecodeCache> decode_cache_;
+    // Blocks compiled from memory_ for the compiled backend, with the same invalidation rules.
+    std::unique_ptr<BlockCache> block_cache_;
+
+    Backend backend_ = Backend::switched;
+    FusionCounts fusion_counts_{};
     frequencypp::hertz master_clock_rate_{120};
 
     // These counters represent the number of master cycles since the last decrement of the
@@ -187,11 +442,30 @@ private:
     std::size_t delay_cycles = 0;
     std::size_t sound_cycles = 0;
 
-    std::default_random_engine random_engine{std::random_device{}()};
+    // These periods represent the number of master cycles between decrements of the respective
+    // timer register at the master clock rate that they were last computed for.
+    std::optional<frequencypp::hertz> timer_periods_clock_rate_;
+    std::size_t delay_period_ = 1;
+    std::size_t sound_period_ = 1;
+
+    Random random_;
+    std::optional<Profile> profile_;
+    std::shared_ptr<Trace> trace_;
+    Breakpoints breakpoints_;
+    std::optional<Hit> hit_;
 };
 
 } // namespace libnpln::machine
 
+template<>
+struct std::hash<libnpln::machine::Machine>
+{
+    auto operator()(libnpln::machine::Machine const& m) const noexcept -> std::size_t
+    {
+        return static_cast<std::size_t>(m.hash());
+    }
+};
+
 template<>
 struct fmt::formatter<libnpln::machine::Machine>
 {
@@ -19,7 +19,11 @@
 #include <catch2/catch.hpp>
 #include <gsl/gsl>
 
+#include <algorithm>
+#include <thread>
 #include <type_traits>
+#include <unordered_set>
+#include <vector>
 
 using namespace libnpln::machine;
 
@@ -48,11 +52,14 @@ auto create_checkerboard() -> Display
 } // namespace
 
 // By inspecting the entire state of the machine after each cycle, we verify that no instruction
-// has an unintended side-effect.
+// has an unintended side-effect.  Every test is repeated for each backend to verify that they are
+// equivalent.
 
 TEST_CASE("Cycles fail after a fault", "[machine][cycle]")
 {
-    Machine m;
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    Machine m{backend};
     m.fault() = Fault{Fault::Type::invalid_instruction, m.program_counter()};
 
     auto m_expect = m;
@@ -63,7 +70,9 @@ TEST_CASE("Cycles fail after a fault", "[machine][cycle]")
 
 TEST_CASE("Cycles can resume after clearing a fault", "[machine][cycle]")
 {
-    Machine m;
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    Machine m{backend};
     m.fault() = Fault{Fault::Type::invalid_address, 0x000};
     load_into_memory<Machine::program_address>(
         {
@@ -89,7 +98,9 @@ TEST_CASE("Cycles can resume after clearing a fault", "[machine][cycle]")
 
 TEST_CASE("Invalid addresses trigger a fault", "[machine][cycle]")
 {
-    Machine m;
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    Machine m{backend};
     m.program_counter() = 0x1000;
 
     auto m_expect = m;
@@ -101,7 +112,9 @@ TEST_CASE("Invalid addresses trigger a fault", "[machine][cycle]")
 
 TEST_CASE("Invalid instructions trigger a fault", "[machine][cycle]")
 {
-    Machine m;
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    Machine m{backend};
     load_into_memory<Machine::program_address>(
         {
             0x00,
@@ -119,9 +132,11 @@ TEST_CASE("Invalid instructions trigger a fault", "[machine][cycle]")
 // NOLINTNEXTLINE(readability-function-size, hicpp-function-size)
 TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 {
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
     SECTION("cls")
     {
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x00, 0xE0, // CLS
@@ -141,7 +156,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("with an empty stack")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x00, 0xEE, // RET
@@ -157,7 +172,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with a non-empty stack")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x00, 0xEE, // RET
@@ -175,7 +190,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
     SECTION("jmp_a")
     {
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x1F, 0x00, // JMP F00h
@@ -193,7 +208,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("with a full stack")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x2E, 0xEE, // CALL EEEh
@@ -212,7 +227,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with an empty stack")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x2E, 0xEE, // CALL EEEh
@@ -229,7 +244,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with an almost-full stack")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x2E, 0xEE, // CALL EEEh
@@ -252,7 +267,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("when equal")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x3A, 0xEE, // SEQ %VA, $EEh
@@ -269,7 +284,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when not equal")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x3A, 0xEE, // SEQ %VA, $EEh
@@ -289,7 +304,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("when not equal")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x4A, 0xEE, // SNE %VA, $EEh
@@ -306,7 +321,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when equal")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x4A, 0xEE, // SNE %VA, $EEh
@@ -326,7 +341,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("when equal")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x51, 0xE0, // SEQ %V1, %VE
@@ -344,7 +359,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when not equal")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x54, 0x00, // SEQ %V4, %V0
@@ -363,7 +378,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
     SECTION("mov_v_b")
     {
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x6C, 0x7F, // MOV %VC, $7Fh
@@ -382,7 +397,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("with overflow")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x7C, 0xFF, // ADD %VC, $FFh
@@ -400,7 +415,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("without overflow")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x78, 0x20, // ADD %V8, $FFh
@@ -419,7 +434,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
     SECTION("mov_v_v")
     {
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x8A, 0xB0, // MOV %VA, %VB
@@ -438,7 +453,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
     SECTION("or_v_v")
     {
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x80, 0x11, // OR %V0, %V1
@@ -457,7 +472,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
     SECTION("and_v_v")
     {
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x82, 0xE2, // AND %V2, %VE
@@ -476,7 +491,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
     SECTION("xor_v_v")
     {
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x87, 0x33, // XOR %V7, %V3
@@ -497,7 +512,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("without overflow")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x8A, 0xC4, // ADD %VA, %VC
@@ -518,7 +533,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with overflow")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x80, 0x14, // ADD %V0, %V1
@@ -539,7 +554,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("into %VF")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x8F, 0x04, // ADD %VF, %V0
@@ -558,7 +573,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("from %VF")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x87, 0xF4, // ADD %V7, %VF
@@ -581,7 +596,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("without underflow")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x8A, 0xC5, // SUB %VA, %VC
@@ -602,7 +617,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with underflow")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x80, 0x15, // SUB %V0, %V1
@@ -623,7 +638,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("into %VF")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x8F, 0x05, // SUB %VF, %V0
@@ -642,7 +657,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("from %VF")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x87, 0xF5, // SUB %V7, %VF
@@ -665,7 +680,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("without lsb")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x8A, 0x06, // SHR %VA
@@ -685,7 +700,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with lsb")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x80, 0x06, // SHR %V0
@@ -705,7 +720,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("into %VF")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x8F, 0x06, // SHR %VF
@@ -726,7 +741,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("without underflow")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x8A, 0xC7, // SUBN %VA, %VC
@@ -747,7 +762,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with underflow")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x80, 0x17, // SUBN %V0, %V1
@@ -768,7 +783,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("into %VF")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x8F, 0x07, // SUBN %VF, %V0
@@ -787,7 +802,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("from %VF")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x87, 0xF7, // SUBN %V7, %VF
@@ -810,7 +825,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("without msb")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x8A, 0x0E, // SHL %VA
@@ -830,7 +845,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with msb")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x80, 0x0E, // SHL %V0
@@ -850,7 +865,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("into %VF")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x8F, 0x0E, // SHL %VF
@@ -871,7 +886,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("when not equal")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x9A, 0xE0, // SNE %VA, %VE
@@ -889,7 +904,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when equal")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0x9A, 0xE0, // SNE %VA, %VE
@@ -908,7 +923,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
     SECTION("mov_i_a")
     {
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0xAE, 0xEE, // MOV %I, $EEEh
@@ -925,7 +940,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
     SECTION("jmp_v0_a")
     {
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0xBA, 0xAA, // JMP AAAh(%V0)
@@ -944,7 +959,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("with an empty mask")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xCA, 0x00, // RND %VA, $00h
@@ -963,7 +978,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with a partial mask")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xCA, 0xA5, // RND %VA, $A5h
@@ -982,7 +997,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with a full mask")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xCA, 0xFF, // RND %VA, $FFh
@@ -1004,7 +1019,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("with %VF as X register")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xDF, 0x21, // DRW %VF, %V2, $1h
@@ -1036,7 +1051,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with %VF as Y register")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xD1, 0xF1, // DRW %V1, %VF, $1h
@@ -1068,7 +1083,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with %VF as X & Y registers")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xDF, 0xF1, // DRW %VF, %VF, $1h
@@ -1099,7 +1114,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with zero rows")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xD0, 0x10, // DRW %V0, %V1, $0h
@@ -1122,7 +1137,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with one row")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xD1, 0x21, // DRW %V1, %V2, $1h
@@ -1155,7 +1170,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("without clearing pixels")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xD0, 0x11, // DRW %V0, %V1, $1h
@@ -1180,7 +1195,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
         {
             // Draw an 8x15 sprite at the bottom-right corner of the screen
             // such that only one-quarter of the sprite is visible.
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xD0, 0x1F, // DRW %V0, %V1, $Fh
@@ -1253,7 +1268,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("when only that key is pressed")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xE0, 0x9E, // SKP %V0
@@ -1271,7 +1286,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when pressed among other keys")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xEA, 0x9E, // SKP %VA
@@ -1290,7 +1305,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when only other keys are pressed")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xE1, 0x9E, // SKP %V1
@@ -1309,7 +1324,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when no key is pressed")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xE2, 0x9E, // SKP %V2
@@ -1326,7 +1341,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when the key is out of bounds")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xE3, 0x9E, // SKP %V3
@@ -1346,7 +1361,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("when only that key is pressed")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xE0, 0xA1, // SKNP %V0
@@ -1364,7 +1379,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when pressed among other keys")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xEA, 0xA1, // SKNP %VA
@@ -1383,7 +1398,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when only other keys are pressed")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xE1, 0xA1, // SKNP %V1
@@ -1402,7 +1417,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when no key is pressed")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xE2, 0xA1, // SKNP %V2
@@ -1419,7 +1434,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when the key is out of bounds")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xE3, 0xA1, // SKNP %V3
@@ -1437,7 +1452,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
     SECTION("mov_v_dt")
     {
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0xFC, 0x07, // MOV %VC, %DT
@@ -1458,7 +1473,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("when no key is pressed within 100 cycles")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xF1, 0x0A, // WKP %V1
@@ -1476,7 +1491,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when one key is pressed on the second cycle")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xF2, 0x0A, // WKP %V2
@@ -1501,7 +1516,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when one key is pressed on the first cycle")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xFA, 0x0A, // WKP %VA
@@ -1520,7 +1535,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("when multiple keys are pressed on the first cycle")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xFF, 0x0A, // WKP %VF
@@ -1541,7 +1556,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
     SECTION("mov_dt_v")
     {
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0xFD, 0x15, // MOV %DT, %VD
@@ -1560,7 +1575,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
     SECTION("mov_st_v")
     {
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0xF7, 0x18, // MOV %ST, %V7
@@ -1581,7 +1596,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("without overflow")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xF5, 0x1E, // ADD %I, %V5
@@ -1600,7 +1615,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with overflow")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xF0, 0x1E, // ADD %I, %V0
@@ -1623,7 +1638,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
         SECTION("with known values")
         {
             for (Nibble digit = 0; digit <= max_nibble; ++digit) {
-                Machine m;
+                Machine m{backend};
                 load_into_memory<Machine::program_address>(
                     {
                         0xF1, 0x29, // FONT %V1
@@ -1648,7 +1663,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with an unknown value")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xFC, 0x29, // FONT %VC
@@ -1669,7 +1684,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("inside memory bounds")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xF3, 0x33, // BCD %V3
@@ -1690,7 +1705,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("outside memory bounds")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xF3, 0x33, // BCD %V3
@@ -1711,7 +1726,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("inside memory bounds")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xF5, 0x55, // MOV (%I), %V0..%V5
@@ -1740,7 +1755,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("outside memory bounds")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xFF, 0x55, // MOV (%I), %V0..%VF
@@ -1757,7 +1772,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with all registers")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xFF, 0x55, // MOV (%I), %V0..%VF
@@ -1809,7 +1824,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
     {
         SECTION("inside memory bounds")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xF5, 0x65, // MOV %V0..%V5, (%I)
@@ -1854,7 +1869,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("outside memory bounds")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xFF, 0x65, // MOV %V0..%VF, (%I)
@@ -1871,7 +1886,7 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
         SECTION("with all registers")
         {
-            Machine m;
+            Machine m{backend};
             load_into_memory<Machine::program_address>(
                 {
                     0xFF, 0x65, // MOV %V0..%VF, (%I)
@@ -1938,13 +1953,15 @@ TEST_CASE("Individual instructions execute correctly", "[machine][cycle]")
 
 TEST_CASE("Delay timer counts down correctly", "[machine][cycle]")
 {
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
     using namespace frequencypp::literals;
 
     SECTION("when the master clock rate is the delay clock rate")
     {
         Byte const ticks = 0xFF;
 
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x12, 0x00, // JMP 200h
@@ -1969,7 +1986,7 @@ TEST_CASE("Delay timer counts down correctly", "[machine][cycle]")
     {
         Byte const ticks = 0xFF;
 
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x12, 0x00, // JMP 200h
@@ -1994,7 +2011,7 @@ TEST_CASE("Delay timer counts down correctly", "[machine][cycle]")
     {
         Byte const ticks = 0xFF;
 
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x12, 0x00, // JMP 200h
@@ -2020,7 +2037,7 @@ TEST_CASE("Delay timer counts down correctly", "[machine][cycle]")
         Byte const ticks = 0xFF;
         std::size_t const multiplier = 4;
 
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x12, 0x00, // JMP 200h
@@ -2044,13 +2061,15 @@ TEST_CASE("Delay timer counts down correctly", "[machine][cycle]")
 
 TEST_CASE("Sound timer counts down correctly", "[machine][cycle]")
 {
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
     using namespace frequencypp::literals;
 
     SECTION("when the master clock rate is the sound clock rate")
     {
         Byte const ticks = 0xFF;
 
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x12, 0x00, // JMP 200h
@@ -2075,7 +2094,7 @@ TEST_CASE("Sound timer counts down correctly", "[machine][cycle]")
     {
         Byte const ticks = 0xFF;
 
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x12, 0x00, // JMP 200h
@@ -2100,7 +2119,7 @@ TEST_CASE("Sound timer counts down correctly", "[machine][cycle]")
     {
         Byte const ticks = 0xFF;
 
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x12, 0x00, // JMP 200h
@@ -2126,7 +2145,7 @@ TEST_CASE("Sound timer counts down correctly", "[machine][cycle]")
         Byte const ticks = 0xFF;
         std::size_t const multiplier = 4;
 
-        Machine m;
+        Machine m{backend};
         load_into_memory<Machine::program_address>(
             {
                 0x12, 0x00, // JMP 200h
@@ -2147,3 +2166,604 @@ TEST_CASE("Sound timer counts down correctly", "[machine][cycle]")
         REQUIRE(m.registers().st == 0);
     }
 }
+
+TEST_CASE("Cycles execute instructions written by the program", "[machine][cycle]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    SECTION("with bcd_v")
+    {
+        Machine m{backend};
+        load_into_memory<Machine::program_address>(
+            {
+                0x12, 0x04, // JMP 204h
+                0xF0, 0x33, // BCD %V0
+                0x12, 0x02, // JMP 202h
+            },
+            m.memory());
+        m.registers().v0 = 18;
+        m.registers().i = 0x204;
+
+        REQUIRE(m.cycle());
+        REQUIRE(m.cycle());
+        REQUIRE(m.cycle());
+        REQUIRE_FALSE(m.cycle()); // Decodes 0001h from 204h
+        REQUIRE(m.fault() == Fault{Fault::Type::invalid_instruction, 0x204});
+    }
+
+    SECTION("with mov_ii_v")
+    {
+        Machine m{backend};
+        load_into_memory<Machine::program_address>(
+            {
+                0x12, 0x04, // JMP 204h
+                0xF1, 0x55, // MOV %V0..%V1, (%I)
+                0x12, 0x02, // JMP 202h
+            },
+            m.memory());
+        m.registers().v0 = 0x1F;
+        m.registers().v1 = 0x00;
+        m.registers().i = 0x204;
+
+        REQUIRE(m.cycle());
+        REQUIRE(m.cycle());
+        REQUIRE(m.cycle());
+        REQUIRE(m.cycle()); // Decodes JMP F00h from 204h
+        REQUIRE(m.program_counter() == 0xF00);
+    }
+}
+
+TEST_CASE("Cycles execute instructions written by the host", "[machine][cycle]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x12, 0x00, // JMP 200h
+        },
+        m.memory());
+
+    REQUIRE(m.cycle());
+    REQUIRE(m.program_counter() == Machine::program_address);
+
+    m.memory()[Machine::program_address + 1] = 0x40; // JMP 240h
+
+    REQUIRE(m.cycle());
+    REQUIRE(m.program_counter() == 0x240);
+}
+
+TEST_CASE("Runs stop when the cycle budget is exhausted", "[machine][run]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x70, 0x01, // ADD %V0, $01h
+            0x12, 0x00, // JMP 200h
+        },
+        m.memory());
+
+    REQUIRE(m.run(0) == RunResult{StopReason::budget_exhausted, 0});
+    REQUIRE(m.program_counter() == Machine::program_address);
+
+    REQUIRE(m.run(9) == RunResult{StopReason::budget_exhausted, 9});
+    REQUIRE(m.registers().v0 == 5);
+    REQUIRE(m.program_counter() == 0x202);
+}
+
+TEST_CASE("Runs stop on faults", "[machine][run]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x70, 0x01, // ADD %V0, $01h
+            0x00, 0xEE, // RET
+        },
+        m.memory());
+
+    REQUIRE(m.run(10, no_stop_reasons) == RunResult{StopReason::fault, 1});
+    REQUIRE(m.fault() == Fault{Fault::Type::empty_stack, 0x202});
+
+    REQUIRE(m.run(10) == RunResult{StopReason::fault, 0});
+    REQUIRE(m.registers().v0 == 1);
+}
+
+TEST_CASE("Runs stop while waiting for a key", "[machine][run]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x70, 0x01, // ADD %V0, $01h
+            0xF1, 0x0A, // WKP %V1
+            0x12, 0x00, // JMP 200h
+        },
+        m.memory());
+
+    SECTION("when requested")
+    {
+        REQUIRE(m.run(10) == RunResult{StopReason::wait_for_key, 2});
+        REQUIRE(m.program_counter() == 0x202);
+
+        REQUIRE(m.run(10) == RunResult{StopReason::wait_for_key, 1});
+        REQUIRE(m.program_counter() == 0x202);
+
+        m.keys().set(0x7);
+
+        REQUIRE(m.run(4) == RunResult{StopReason::budget_exhausted, 4});
+        REQUIRE(m.registers().v0 == 2);
+        REQUIRE(m.registers().v1 == 0x7);
+    }
+
+    SECTION("unless not requested")
+    {
+        REQUIRE(m.run(10, no_stop_reasons) == RunResult{StopReason::budget_exhausted, 10});
+        REQUIRE(m.program_counter() == 0x202);
+    }
+}
+
+TEST_CASE("Runs stop when the display changes", "[machine][run]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x70, 0x01, // ADD %V0, $01h
+            0x00, 0xE0, // CLS
+            0xD0, 0x05, // DRW %V0, %V0, $5h
+            0x12, 0x00, // JMP 200h
+        },
+        m.memory());
+
+    SECTION("when requested")
+    {
+        REQUIRE(m.run(10) == RunResult{StopReason::display_changed, 2});
+        REQUIRE(m.program_counter() == 0x204);
+
+        REQUIRE(m.run(10) == RunResult{StopReason::display_changed, 1});
+        REQUIRE(m.program_counter() == 0x206);
+
+        REQUIRE(m.run(10, StopReason::wait_for_key) == RunResult{StopReason::budget_exhausted, 10});
+    }
+
+    SECTION("unless not requested")
+    {
+        REQUIRE(m.run(8, no_stop_reasons) == RunResult{StopReason::budget_exhausted, 8});
+        REQUIRE(m.registers().v0 == 2);
+    }
+}
+
+TEST_CASE("Runs are equivalent to cycles", "[machine][run]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    using namespace frequencypp::literals;
+
+    auto const master_clock_rate = GENERATE(1_Hz, 59_Hz, 60_Hz, 61_Hz, 97_Hz, 120_Hz, 1000_Hz);
+    auto const budget = GENERATE(std::size_t{1}, std::size_t{7}, std::size_t{100});
+
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x60, 0xFF, // MOV %V0, $FFh
+            0xF0, 0x15, // MOV %DT, %V0
+            0xF0, 0x18, // MOV %ST, %V0
+            0x71, 0x01, // ADD %V1, $01h
+            0x12, 0x06, // JMP 206h
+        },
+        m.memory());
+    m.master_clock_rate() = master_clock_rate;
+
+    auto m_expect = m;
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        REQUIRE(m.run(budget) == RunResult{StopReason::budget_exhausted, budget});
+        for (std::size_t j = 0; j < budget; ++j) {
+            REQUIRE(m_expect.cycle());
+        }
+
+        REQUIRE(m == m_expect);
+    }
+
+    // Changing the clock rate between runs must take effect on the next run.
+    m.master_clock_rate() = 2_Hz;
+    m_expect.master_clock_rate() = 2_Hz;
+
+    REQUIRE(m.run(budget) == RunResult{StopReason::budget_exhausted, budget});
+    for (std::size_t j = 0; j < budget; ++j) {
+        REQUIRE(m_expect.cycle());
+    }
+    REQUIRE(m == m_expect);
+}
+
+TEST_CASE("Runs execute instructions written by the program", "[machine][run]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x71, 0x01, // ADD %V1, $01h
+            0x71, 0x01, // ADD %V1, $01h
+            0xF0, 0x55, // MOV %V0..%V0, (%I)
+            0x12, 0x00, // JMP 200h
+        },
+        m.memory());
+    m.registers().v0 = 0x02;
+    m.registers().i = 0x201;
+
+    REQUIRE(m.run(6) == RunResult{StopReason::budget_exhausted, 6});
+    REQUIRE(m.registers().v1 == 0x05); // Adds 01h twice, then 02h and 01h
+}
+
+TEST_CASE("Runs of fused instructions are equivalent to cycles", "[machine][run]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+    auto const budget = GENERATE(range(std::size_t{1}, std::size_t{8}), std::size_t{100});
+    auto const stop_reasons = GENERATE(all_stop_reasons, no_stop_reasons);
+
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x60, 0x03, // MOV %V0, $03h
+            0xF0, 0x15, // MOV %DT, %V0
+            0xA3, 0x00, // MOV %I, $300h
+            0xD0, 0x15, // DRW %V0, %V1, $5h
+            0x72, 0x01, // ADD %V2, $01h
+            0x42, 0x03, // SNE %V2, $03h
+            0x12, 0x08, // JMP 208h
+            0xF3, 0x07, // MOV %V3, %DT
+            0x33, 0x00, // SEQ %V3, $00h
+            0x12, 0x0E, // JMP 20Eh
+            0x12, 0x00, // JMP 200h
+        },
+        m.memory());
+    m.memory()[0x300] = 0xF0;
+
+    auto m_expect = m;
+    m_expect.backend() = Backend::switched;
+
+    for (std::size_t i = 0; i < 50; ++i) {
+        auto const result = m.run(budget, stop_reasons);
+        REQUIRE(m_expect.run(budget, stop_reasons) == result);
+        REQUIRE(m == m_expect);
+    }
+
+    // Smaller budgets may never leave room for some of the fusions.
+    if (backend == Backend::threaded && budget == 100) {
+        for (auto const count : m.fusion_counts()) {
+            REQUIRE(count > 0);
+        }
+    }
+    for (auto const count : m_expect.fusion_counts()) {
+        REQUIRE(count == 0);
+    }
+}
+
+TEST_CASE("Runs fault inside fused instructions", "[machine][run]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0xAF, 0xFF, // MOV %I, $FFFh
+            0xD0, 0x15, // DRW %V0, %V1, $5h
+        },
+        m.memory());
+
+    REQUIRE(m.run(100) == RunResult{StopReason::fault, 1});
+    REQUIRE(m.program_counter() == Machine::program_address + Instruction::width);
+    REQUIRE(m.fault() != std::nullopt);
+}
+
+TEST_CASE("Runs of compiled blocks are equivalent to the switched backend", "[machine][run]")
+{
+    auto const budget = GENERATE(range(std::size_t{1}, std::size_t{8}), std::size_t{100});
+
+    // Each block operation runs in a block of many, with %VF both as a flag and as an operand.
+    Machine m{Backend::compiled};
+    load_into_memory<Machine::program_address>(
+        {
+            0x60, 0xF3, // MOV %V0, $F3h
+            0x61, 0x5A, // MOV %V1, $5Ah
+            0x82, 0x00, // MOV %V2, %V0
+            0x82, 0x11, // OR %V2, %V1
+            0x83, 0x00, // MOV %V3, %V0
+            0x83, 0x12, // AND %V3, %V1
+            0x84, 0x00, // MOV %V4, %V0
+            0x84, 0x13, // XOR %V4, %V1
+            0x85, 0x04, // ADD %V5, %V0
+            0x86, 0x15, // SUB %V6, %V1
+            0x87, 0x17, // SUBN %V7, %V1
+            0x88, 0x06, // SHR %V8
+            0x89, 0x0E, // SHL %V9
+            0x8A, 0xF4, // ADD %VA, %VF
+            0x8F, 0x14, // ADD %VF, %V1
+            0x8B, 0xF5, // SUB %VB, %VF
+            0x8F, 0x25, // SUB %VF, %V2
+            0x8C, 0xF7, // SUBN %VC, %VF
+            0x8F, 0x37, // SUBN %VF, %V3
+            0x8F, 0x06, // SHR %VF
+            0x8D, 0xF0, // MOV %VD, %VF
+            0x8F, 0x0E, // SHL %VF
+            0x8E, 0xF1, // OR %VE, %VF
+            0xA3, 0x00, // MOV %I, $300h
+            0xFF, 0x1E, // ADD %I, %VF
+            0x75, 0x01, // ADD %V5, $01h
+            0x78, 0x81, // ADD %V8, $81h
+            0x79, 0x7F, // ADD %V9, $7Fh
+            0x12, 0x04, // JMP 204h
+        },
+        m.memory());
+
+    auto m_expect = m;
+    m_expect.backend() = Backend::switched;
+
+    for (std::size_t i = 0; i < 50; ++i) {
+        auto const result = m.run(budget);
+        REQUIRE(m_expect.run(budget) == result);
+        REQUIRE(m == m_expect);
+    }
+}
+
+TEST_CASE("Runs of idle loops are equivalent to cycles", "[machine][run]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    using namespace frequencypp::literals;
+
+    auto const master_clock_rate = GENERATE(1_Hz, 60_Hz, 61_Hz, 97_Hz, 120_Hz, 1000_Hz);
+    auto const budget = GENERATE(range(std::size_t{1}, std::size_t{10}), std::size_t{100});
+    auto const delay = GENERATE(Byte{0x00}, Byte{0x01}, Byte{0x05});
+    auto const awaited = GENERATE(Byte{0x00}, Byte{0x02}, Byte{0x10});
+
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x60, delay, // MOV %V0, delay
+            0xF0, 0x15, // MOV %DT, %V0
+            0xF0, 0x18, // MOV %ST, %V0
+            0xF1, 0x07, // MOV %V1, %DT
+            0x31, awaited, // SEQ %V1, awaited
+            0x12, 0x06, // JMP 206h
+            0xF2, 0x0A, // WKP %V2
+            0x12, 0x0E, // JMP 20Eh
+        },
+        m.memory());
+    m.master_clock_rate() = master_clock_rate;
+
+    auto m_expect = m;
+
+    for (std::size_t i = 0; i < 5; ++i) {
+        REQUIRE(m.run(budget, no_stop_reasons) == RunResult{StopReason::budget_exhausted, budget});
+        for (std::size_t j = 0; j < budget; ++j) {
+            REQUIRE(m_expect.cycle());
+        }
+
+        REQUIRE(m == m_expect);
+    }
+}
+
+TEST_CASE("Runs skip idle loops", "[machine][run]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+    auto const loop = GENERATE(as<std::vector<Byte>>{},
+        std::vector<Byte>{
+            0x12, 0x04, // JMP 204h
+        },
+        std::vector<Byte>{
+            0xF2, 0x0A, // WKP %V2
+        },
+        std::vector<Byte>{
+            0xF1, 0x07, // MOV %V1, %DT
+            0x31, 0x00, // SEQ %V1, $00h
+            0x12, 0x04, // JMP 204h
+            0x12, 0x0A, // JMP 20Ah
+        });
+
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x60, 0xFF, // MOV %V0, $FFh
+            0xF0, 0x15, // MOV %DT, %V0
+        },
+        m.memory());
+    std::copy(loop.begin(), loop.end(), m.memory().begin() + Machine::program_address + 4);
+
+    // Far more cycles than would run in any reasonable time.
+    static constexpr std::size_t budget = std::size_t{1} << 40U;
+    REQUIRE(m.run(budget, no_stop_reasons) == RunResult{StopReason::budget_exhausted, budget});
+    REQUIRE(m.registers().dt == 0x00);
+}
+
+TEST_CASE("Backends can be switched between runs", "[machine][run]")
+{
+    Machine m{Backend::threaded};
+    REQUIRE(m.backend() == Backend::threaded);
+    REQUIRE(Machine{}.backend() == Backend::switched);
+
+    load_into_memory<Machine::program_address>(
+        {
+            0x70, 0x01, // ADD %V0, $01h
+            0x12, 0x00, // JMP 200h
+        },
+        m.memory());
+
+    REQUIRE(m.run(3) == RunResult{StopReason::budget_exhausted, 3});
+    m.backend() = Backend::switched;
+    REQUIRE(m.run(3) == RunResult{StopReason::budget_exhausted, 3});
+    REQUIRE(m.registers().v0 == 3);
+    REQUIRE(m.program_counter() == Machine::program_address);
+
+    auto const copy = m;
+    REQUIRE(copy.backend() == Backend::switched);
+}
+
+TEST_CASE("Copies of machines run identically", "[machine][run]")
+{
+    Machine m;
+    load_into_memory<Machine::program_address>(
+        {
+            0xC0, 0xFF, // RND %V0, $FFh
+            0xF0, 0x15, // MOV %DT, %V0
+            0x12, 0x00, // JMP 200h
+        },
+        m.memory());
+    REQUIRE(m.run(5) == RunResult{StopReason::budget_exhausted, 5});
+
+    auto constructed = m;
+    Machine assigned;
+    assigned = m;
+    REQUIRE(m.run(100) == RunResult{StopReason::budget_exhausted, 100});
+    REQUIRE(constructed.run(100) == RunResult{StopReason::budget_exhausted, 100});
+    REQUIRE(assigned.run(100) == RunResult{StopReason::budget_exhausted, 100});
+    REQUIRE(constructed == m);
+    REQUIRE(assigned == m);
+}
+
+namespace {
+
+// Builds a machine with the compared state of the given machine from scratch, so that none of the
+// hashes kept by the given machine are reused.
+auto rebuild(Machine const& m) -> Machine
+{
+    Machine r;
+    r.fault() = m.fault();
+    r.program_counter() = m.program_counter();
+    r.registers() = m.registers();
+    r.stack() = m.stack();
+    r.memory() = m.memory();
+    r.keys() = m.keys();
+    r.display().copy_pixels(m.display());
+    return r;
+}
+
+} // namespace
+
+TEST_CASE("Machine hashes follow every change to the state", "[machine][hash]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0xA3, 0x00, // MOV %I, $300h
+            0x70, 0x07, // ADD %V0, $07h
+            0xF0, 0x33, // BCD %V0
+            0xF1, 0x29, // FONT %V1
+            0xD1, 0x15, // DRW %V1, %V1, $5h
+            0x00, 0xE0, // CLS
+            0x22, 0x02, // CALL 202h
+        },
+        m.memory());
+
+    // Hashing after every cycle keeps the hashes of the pages and display between cycles.
+    auto hashes = std::unordered_set<std::uint64_t>{};
+    for (std::size_t c = 0; c < 32; ++c) {
+        auto const h = m.hash();
+        REQUIRE(h == rebuild(m).hash());
+        REQUIRE(h == std::hash<Machine>{}(m));
+        hashes.insert(h);
+        REQUIRE(m.cycle());
+    }
+    REQUIRE(hashes.size() > 8);
+
+    auto const s = m.snapshot();
+    auto const h = m.hash();
+    REQUIRE(m.run(10, no_stop_reasons).cycles == 10);
+    REQUIRE(m.hash() != h);
+    m.restore(s);
+    REQUIRE(m.hash() == h);
+    REQUIRE(m == rebuild(m));
+}
+
+TEST_CASE("Machines can be hashed by several threads at once", "[machine][hash]")
+{
+    Machine m;
+    m.memory()[0x300] = 0xAA;
+    m.display().set_row(0, 1);
+    Machine const& c = m;
+
+    // Every thread finds the pages and display unhashed, so they race to hash them.
+    std::vector<std::uint64_t> hashes(4);
+    std::vector<std::thread> threads;
+    for (auto& h : hashes) {
+        threads.emplace_back([&c, &h]() { h = c.hash(); });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    auto const h = rebuild(m).hash();
+    REQUIRE(std::all_of(
+        std::begin(hashes), std::end(hashes), [h](auto const x) { return x == h; }));
+    REQUIRE(m.hash() == h);
+}
+
+TEST_CASE("Machine hashes distinguish each part of the state", "[machine][hash]")
+{
+    Machine const m;
+    auto const h = m.hash();
+    REQUIRE(Machine{}.hash() == h);
+
+    auto changed = m;
+    SECTION("fault")
+    {
+        changed.fault() = Fault{Fault::Type::empty_stack, 0x200};
+    }
+    SECTION("program counter")
+    {
+        ++changed.program_counter();
+    }
+    SECTION("registers")
+    {
+        changed.registers().vf = 1;
+    }
+    SECTION("stack")
+    {
+        changed.stack().push(0x200);
+    }
+    SECTION("memory")
+    {
+        changed.memory()[0xFFF] = 1;
+    }
+    SECTION("keys")
+    {
+        changed.keys().set(to_index(Key::kf));
+    }
+    SECTION("display")
+    {
+        changed.display().set_row(31, 1);
+    }
+
+    REQUIRE(changed.hash() != h);
+    REQUIRE(changed != m);
+}
+
+TEST_CASE("Machines can be deduplicated in hash sets", "[machine][hash]")
+{
+    Machine m;
+    load_into_memory<Machine::program_address>(
+        {
+            0x70, 0x01, // ADD %V0, $01h
+            0x30, 0x04, // SEQ %V0, $04h
+            0x12, 0x00, // JMP 200h
+            0x60, 0x00, // MOV %V0, $00h
+            0x12, 0x00, // JMP 200h
+        },
+        m.memory());
+
+    // The program loops through the same states every four additions.
+    auto visited = std::unordered_set<Machine>{};
+    for (std::size_t c = 0; c < 100; ++c) {
+        visited.insert(m);
+        REQUIRE(m.cycle());
+    }
+    REQUIRE(visited.size() == 13);
+}
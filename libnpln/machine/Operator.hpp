@@ -19,6 +19,8 @@
 
 #include <fmt/format.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <string_view>
 
@@ -62,6 +64,177 @@ enum class Operator : Word
     mov_v_ii = 0xF065,
 };
 
+// Dense identifiers of the operators, in the order that the operators are declared, which index
+// tables of per-operator data.  The invalid identifier follows every operator's identifier and
+// stands for a word that does not decode to any instruction.
+enum class OperatorId : std::uint8_t
+{
+    cls,
+    ret,
+    jmp_a,
+    call_a,
+    seq_v_b,
+    sne_v_b,
+    seq_v_v,
+    mov_v_b,
+    add_v_b,
+    mov_v_v,
+    or_v_v,
+    and_v_v,
+    xor_v_v,
+    add_v_v,
+    sub_v_v,
+    shr_v,
+    subn_v_v,
+    shl_v,
+    sne_v_v,
+    mov_i_a,
+    jmp_v0_a,
+    rnd_v_b,
+    drw_v_v_n,
+    skp_v,
+    sknp_v,
+    mov_v_dt,
+    wkp_v,
+    mov_dt_v,
+    mov_st_v,
+    add_i_v,
+    font_v,
+    bcd_v,
+    mov_ii_v,
+    mov_v_ii,
+    invalid,
+};
+
+constexpr std::size_t operator_id_count = static_cast<std::size_t>(OperatorId::invalid) + 1;
+
+constexpr auto to_operator_id(Operator const op) -> OperatorId
+{
+    switch (op) {
+    case Operator::cls: return OperatorId::cls;
+    case Operator::ret: return OperatorId::ret;
+    case Operator::jmp_a: return OperatorId::jmp_a;
+    case Operator::call_a: return OperatorId::call_a;
+    case Operator::seq_v_b: return OperatorId::seq_v_b;
+    case Operator::sne_v_b: return OperatorId::sne_v_b;
+    case Operator::seq_v_v: return OperatorId::seq_v_v;
+    case Operator::mov_v_b: return OperatorId::mov_v_b;
+    case Operator::add_v_b: return OperatorId::add_v_b;
+    case Operator::mov_v_v: return OperatorId::mov_v_v;
+    case Operator::or_v_v: return OperatorId::or_v_v;
+    case Operator::and_v_v: return OperatorId::and_v_v;
+    case Operator::xor_v_v: return OperatorId::xor_v_v;
+    case Operator::add_v_v: return OperatorId::add_v_v;
+    case Operator::sub_v_v: return OperatorId::sub_v_v;
+    case Operator::shr_v: return OperatorId::shr_v;
+    case Operator::subn_v_v: return OperatorId::subn_v_v;
+    case Operator::shl_v: return OperatorId::shl_v;
+    case Operator::sne_v_v: return OperatorId::sne_v_v;
+    case Operator::mov_i_a: return OperatorId::mov_i_a;
+    case Operator::jmp_v0_a: return OperatorId::jmp_v0_a;
+    case Operator::rnd_v_b: return OperatorId::rnd_v_b;
+    case Operator::drw_v_v_n: return OperatorId::drw_v_v_n;
+    case Operator::skp_v: return OperatorId::skp_v;
+    case Operator::sknp_v: return OperatorId::sknp_v;
+    case Operator::mov_v_dt: return OperatorId::mov_v_dt;
+    case Operator::wkp_v: return OperatorId::wkp_v;
+    case Operator::mov_dt_v: return OperatorId::mov_dt_v;
+    case Operator::mov_st_v: return OperatorId::mov_st_v;
+    case Operator::add_i_v: return OperatorId::add_i_v;
+    case Operator::font_v: return OperatorId::font_v;
+    case Operator::bcd_v: return OperatorId::bcd_v;
+    case Operator::mov_ii_v: return OperatorId::mov_ii_v;
+    case Operator::mov_v_ii: return OperatorId::mov_v_ii;
+    }
+
+    throw std::out_of_range("Unknown Operator in to_operator_id");
+}
+
+constexpr auto to_operator(OperatorId const id) -> Operator
+{
+    switch (id) {
+    case OperatorId::cls: return Operator::cls;
+    case OperatorId::ret: return Operator::ret;
+    case OperatorId::jmp_a: return Operator::jmp_a;
+    case OperatorId::call_a: return Operator::call_a;
+    case OperatorId::seq_v_b: return Operator::seq_v_b;
+    case OperatorId::sne_v_b: return Operator::sne_v_b;
+    case OperatorId::seq_v_v: return Operator::seq_v_v;
+    case OperatorId::mov_v_b: return Operator::mov_v_b;
+    case OperatorId::add_v_b: return Operator::add_v_b;
+    case OperatorId::mov_v_v: return Operator::mov_v_v;
+    case OperatorId::or_v_v: return Operator::or_v_v;
+    case OperatorId::and_v_v: return Operator::and_v_v;
+    case OperatorId::xor_v_v: return Operator::xor_v_v;
+    case OperatorId::add_v_v: return Operator::add_v_v;
+    case OperatorId::sub_v_v: return Operator::sub_v_v;
+    case OperatorId::shr_v: return Operator::shr_v;
+    case OperatorId::subn_v_v: return Operator::subn_v_v;
+    case OperatorId::shl_v: return Operator::shl_v;
+    case OperatorId::sne_v_v: return Operator::sne_v_v;
+    case OperatorId::mov_i_a: return Operator::mov_i_a;
+    case OperatorId::jmp_v0_a: return Operator::jmp_v0_a;
+    case OperatorId::rnd_v_b: return Operator::rnd_v_b;
+    case OperatorId::drw_v_v_n: return Operator::drw_v_v_n;
+    case OperatorId::skp_v: return Operator::skp_v;
+    case OperatorId::sknp_v: return Operator::sknp_v;
+    case OperatorId::mov_v_dt: return Operator::mov_v_dt;
+    case OperatorId::wkp_v: return Operator::wkp_v;
+    case OperatorId::mov_dt_v: return Operator::mov_dt_v;
+    case OperatorId::mov_st_v: return Operator::mov_st_v;
+    case OperatorId::add_i_v: return Operator::add_i_v;
+    case OperatorId::font_v: return Operator::font_v;
+    case OperatorId::bcd_v: return Operator::bcd_v;
+    case OperatorId::mov_ii_v: return Operator::mov_ii_v;
+    case OperatorId::mov_v_ii: return Operator::mov_v_ii;
+    case OperatorId::invalid: break;
+    }
+
+    throw std::out_of_range("Invalid OperatorId in to_operator");
+}
+
+constexpr auto get_name(Operator const op) -> std::string_view
+{
+    switch (op) {
+    case Operator::cls: return "cls";
+    case Operator::ret: return "ret";
+    case Operator::jmp_a: return "jmp_a";
+    case Operator::call_a: return "call_a";
+    case Operator::seq_v_b: return "seq_v_b";
+    case Operator::sne_v_b: return "sne_v_b";
+    case Operator::seq_v_v: return "seq_v_v";
+    case Operator::mov_v_b: return "mov_v_b";
+    case Operator::add_v_b: return "add_v_b";
+    case Operator::mov_v_v: return "mov_v_v";
+    case Operator::or_v_v: return "or_v_v";
+    case Operator::and_v_v: return "and_v_v";
+    case Operator::xor_v_v: return "xor_v_v";
+    case Operator::add_v_v: return "add_v_v";
+    case Operator::sub_v_v: return "sub_v_v";
+    case Operator::shr_v: return "shr_v";
+    case Operator::subn_v_v: return "subn_v_v";
+    case Operator::shl_v: return "shl_v";
+    case Operator::sne_v_v: return "sne_v_v";
+    case Operator::mov_i_a: return "mov_i_a";
+    case Operator::jmp_v0_a: return "jmp_v0_a";
+    case Operator::rnd_v_b: return "rnd_v_b";
+    case Operator::drw_v_v_n: return "drw_v_v_n";
+    case Operator::skp_v: return "skp_v";
+    case Operator::sknp_v: return "sknp_v";
+    case Operator::mov_v_dt: return "mov_v_dt";
+    case Operator::wkp_v: return "wkp_v";
+    case Operator::mov_dt_v: return "mov_dt_v";
+    case Operator::mov_st_v: return "mov_st_v";
+    case Operator::add_i_v: return "add_i_v";
+    case Operator::font_v: return "font_v";
+    case Operator::bcd_v: return "bcd_v";
+    case Operator::mov_ii_v: return "mov_ii_v";
+    case Operator::mov_v_ii: return "mov_v_ii";
+    }
+
+    throw std::out_of_range("Unknown Operator in get_name");
+}
+
 constexpr auto get_format_string(Operator const op) -> std::string_view
 {
     switch (op) {
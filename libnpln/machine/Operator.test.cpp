@@ -18,7 +18,9 @@
 #include <catch2/catch.hpp>
 
 #include <limits>
+#include <set>
 #include <stdexcept>
+#include <string_view>
 #include <type_traits>
 
 using namespace libnpln;
@@ -62,6 +64,34 @@ TEST_CASE("Operators meet CHIP-8 specifications", "[machine][operator]")
     REQUIRE(detail::to_underlying(Operator::mov_v_ii) == 0xF065);
 }
 
+TEST_CASE("Operator identifiers are dense", "[machine][operator]")
+{
+    for (std::size_t i = 0; i < operator_id_count; ++i) {
+        REQUIRE(detail::to_underlying(static_cast<OperatorId>(i)) == i);
+    }
+    REQUIRE(detail::to_underlying(OperatorId::invalid) == operator_id_count - 1);
+}
+
+TEST_CASE("Operator identifiers round-trip", "[machine][operator]")
+{
+    for (std::size_t i = 0; i + 1 < operator_id_count; ++i) {
+        auto const id = static_cast<OperatorId>(i);
+        REQUIRE(to_operator_id(to_operator(id)) == id);
+    }
+    REQUIRE(to_operator_id(Operator::cls) == OperatorId::cls);
+    REQUIRE(to_operator_id(Operator::drw_v_v_n) == OperatorId::drw_v_v_n);
+    REQUIRE(to_operator_id(Operator::mov_v_ii) == OperatorId::mov_v_ii);
+}
+
+TEST_CASE("Invalid operator identifiers do not define operators", "[machine][operator]")
+{
+    REQUIRE_THROWS_AS(to_operator(OperatorId::invalid), std::out_of_range);
+
+    auto const invalid_operator =
+        static_cast<Operator>(std::numeric_limits<std::underlying_type_t<Operator>>::max());
+    REQUIRE_THROWS_AS(to_operator_id(invalid_operator), std::out_of_range);
+}
+
 TEST_CASE("Operators define format strings", "[machine][operator]")
 {
     REQUIRE(get_format_string(Operator::cls) == "CLS");
@@ -144,3 +174,16 @@ TEST_CASE("Operators return a format string when formatted", "[machine][operator
     REQUIRE(fmt::format("{}", Operator::mov_ii_v) == get_format_string(Operator::mov_ii_v));
     REQUIRE(fmt::format("{}", Operator::mov_v_ii) == get_format_string(Operator::mov_v_ii));
 }
+
+TEST_CASE("Operators have distinct names", "[machine][operator]")
+{
+    REQUIRE(get_name(Operator::cls) == "cls");
+    REQUIRE(get_name(Operator::drw_v_v_n) == "drw_v_v_n");
+    REQUIRE(get_name(Operator::mov_v_ii) == "mov_v_ii");
+
+    std::set<std::string_view> names;
+    for (std::size_t i = 0; i + 1 < operator_id_count; ++i) {
+        names.insert(get_name(to_operator(static_cast<OperatorId>(i))));
+    }
+    REQUIRE(names.size() + 1 == operator_id_count);
+}
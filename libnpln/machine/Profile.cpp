@@ -0,0 +1,173 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Profile.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string_view>
+#include <utility>
+
+namespace libnpln::machine {
+
+namespace {
+
+auto format_address(Address const a) -> std::string
+{
+    return fmt::format("{:03X}h", a);
+}
+
+} // namespace
+
+Profile::Profile() : address_counts_(memory_size), frames_{Frame{0, root, 1, 0, {}}} {}
+
+auto Profile::record(Address const address, Operator const op, Address const next_address)
+    -> void
+{
+    ++cycles_;
+    ++operator_counts_[static_cast<std::size_t>(to_operator_id(op))];
+    ++address_counts_[address];
+    ++frames_[frame_].cycles;
+
+    if (op == Operator::call_a) {
+        enter(next_address);
+    }
+    else if (op == Operator::ret && frame_ != root) {
+        frame_ = frames_[frame_].parent;
+    }
+}
+
+auto Profile::enter(Address const address) -> void
+{
+    for (auto const c : frames_[frame_].children) {
+        if (frames_[c].address == address) {
+            ++frames_[c].calls;
+            frame_ = c;
+            return;
+        }
+    }
+
+    auto const c = frames_.size();
+    frames_.push_back(Frame{address, frame_, 1, 0, {}});
+    frames_[frame_].children.push_back(c);
+    frame_ = c;
+}
+
+auto Profile::subroutines() const -> std::vector<Subroutine>
+{
+    std::map<Address, Subroutine> subroutines;
+    auto const subroutine = [&subroutines](Address const a) -> Subroutine& {
+        return subroutines.try_emplace(a, Subroutine{a, 0, 0, 0}).first->second;
+    };
+
+    for (auto f = root + 1; f < frames_.size(); ++f) {
+        auto const& frame = frames_[f];
+        auto& s = subroutine(frame.address);
+        s.calls += frame.calls;
+        s.self_cycles += frame.cycles;
+
+        // The cycles of the frame count towards each distinct subroutine in its chain.
+        std::set<Address> chain;
+        for (auto g = f; g != root; g = frames_[g].parent) {
+            if (chain.insert(frames_[g].address).second) {
+                subroutine(frames_[g].address).total_cycles += frame.cycles;
+            }
+        }
+    }
+
+    std::vector<Subroutine> result;
+    result.reserve(subroutines.size());
+    for (auto const& [address, s] : subroutines) {
+        result.push_back(s);
+    }
+    return result;
+}
+
+auto Profile::to_collapsed_stacks() const -> std::string
+{
+    std::string out;
+    for (std::size_t f = 0; f < frames_.size(); ++f) {
+        if (frames_[f].cycles == 0) {
+            continue;
+        }
+
+        std::vector<Address> chain;
+        for (auto g = f; g != root; g = frames_[g].parent) {
+            chain.push_back(frames_[g].address);
+        }
+
+        out += "main";
+        for (auto a = chain.rbegin(); a != chain.rend(); ++a) {
+            out += ';';
+            out += format_address(*a);
+        }
+        fmt::format_to(std::back_inserter(out), " {}\n", frames_[f].cycles);
+    }
+    return out;
+}
+
+auto Profile::to_flat_profile() const -> std::string
+{
+    std::string out;
+    auto it = std::back_inserter(out);
+
+    std::vector<std::pair<std::size_t, std::string_view>> operators;
+    for (std::size_t i = 0; i + 1 < operator_id_count; ++i) {
+        if (operator_counts_[i] != 0) {
+            operators.emplace_back(
+                operator_counts_[i], get_name(to_operator(static_cast<OperatorId>(i))));
+        }
+    }
+    std::stable_sort(operators.begin(), operators.end(), [](auto const& a, auto const& b) {
+        return a.first > b.first;
+    });
+    it = fmt::format_to(it, "{:>12}  {}\n", "executions", "operator");
+    for (auto const& [count, name] : operators) {
+        it = fmt::format_to(it, "{:>12}  {}\n", count, name);
+    }
+
+    std::vector<std::pair<std::size_t, Address>> addresses;
+    for (std::size_t a = 0; a < address_counts_.size(); ++a) {
+        if (address_counts_[a] != 0) {
+            addresses.emplace_back(address_counts_[a], static_cast<Address>(a));
+        }
+    }
+    std::stable_sort(addresses.begin(), addresses.end(), [](auto const& a, auto const& b) {
+        return a.first > b.first;
+    });
+    it = fmt::format_to(it, "\n{:>12}  {}\n", "executions", "address");
+    for (auto const& [count, address] : addresses) {
+        it = fmt::format_to(it, "{:>12}  {}\n", count, format_address(address));
+    }
+
+    auto subroutines = this->subroutines();
+    std::stable_sort(subroutines.begin(), subroutines.end(), [](auto const& a, auto const& b) {
+        return a.total_cycles > b.total_cycles;
+    });
+    it = fmt::format_to(it, "\n{:>12}  {:>12}  {:>12}  {}\n", "calls", "self cycles",
+        "total cycles", "subroutine");
+    it = fmt::format_to(it, "{:>12}  {:>12}  {:>12}  {}\n", 1, frames_[root].cycles, cycles_,
+        "main");
+    for (auto const& s : subroutines) {
+        it = fmt::format_to(it, "{:>12}  {:>12}  {:>12}  {}\n", s.calls, s.self_cycles,
+            s.total_cycles, format_address(s.address));
+    }
+    return out;
+}
+
+} // namespace libnpln::machine
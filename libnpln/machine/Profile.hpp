@@ -0,0 +1,104 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_PROFILE_HPP
+#define LIBNPLN_MACHINE_PROFILE_HPP
+
+#include <libnpln/machine/DataUnits.hpp>
+#include <libnpln/machine/Memory.hpp>
+#include <libnpln/machine/Operator.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace libnpln::machine {
+
+// Counts the instructions that a machine executes by operator, by address, and by the chain of
+// subroutine calls that they execute in.  Calls are followed by a stack of the subroutines that
+// were entered by CALL and not yet left by RET, beginning with the main program.
+class Profile
+{
+public:
+    struct Subroutine
+    {
+        Address address;
+        std::size_t calls;
+        // The cycles spent in the subroutine itself, and including the subroutines that it called.
+        std::size_t self_cycles;
+        std::size_t total_cycles;
+    };
+
+    Profile();
+
+    // Records an instruction that executed without faulting, and left the program counter at the
+    // given next address.
+    auto record(Address address, Operator op, Address next_address) -> void;
+
+    [[nodiscard]] auto cycles() const noexcept -> std::size_t
+    {
+        return cycles_;
+    }
+    [[nodiscard]] auto operator_count(Operator const op) const -> std::size_t
+    {
+        return operator_counts_[static_cast<std::size_t>(to_operator_id(op))];
+    }
+    [[nodiscard]] auto address_count(Address const a) const -> std::size_t
+    {
+        return address_counts_.at(a);
+    }
+
+    // Returns every subroutine that was called, in the order of their addresses.  A recursive
+    // subroutine counts its cycles once in its total cycles, however deeply it recursed.
+    [[nodiscard]] auto subroutines() const -> std::vector<Subroutine>;
+
+    // Returns the chains of calls that executed instructions, one per line, as the addresses of
+    // the subroutines separated by semicolons, followed by the number of cycles spent in the last
+    // of them.  This is the collapsed stack format read by flame graph tools:
+    //
+    //     main 120
+    //     main;2F0h 4000
+    //     main;2F0h;31Ah 2200
+    [[nodiscard]] auto to_collapsed_stacks() const -> std::string;
+
+    // Returns a table of the operators, addresses, and subroutines that executed, from the most to
+    // the least cycles.
+    [[nodiscard]] auto to_flat_profile() const -> std::string;
+
+private:
+    // A chain of calls, whose children are the chains that it extended with a call.
+    struct Frame
+    {
+        Address address;
+        std::size_t parent;
+        std::size_t calls;
+        std::size_t cycles;
+        std::vector<std::size_t> children;
+    };
+
+    static constexpr std::size_t root = 0;
+
+    auto enter(Address address) -> void;
+
+    std::size_t cycles_ = 0;
+    std::array<std::size_t, operator_id_count> operator_counts_{};
+    std::vector<std::size_t> address_counts_;
+    std::vector<Frame> frames_;
+    std::size_t frame_ = root;
+};
+
+} // namespace libnpln::machine
+
+#endif
@@ -0,0 +1,139 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Profile.hpp>
+
+#include <libnpln/machine/Machine.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <string>
+
+using namespace libnpln::machine;
+
+template<>
+struct Catch::StringMaker<Machine>
+{
+    static auto convert(Machine const& m)
+    {
+        return fmt::to_string(m);
+    }
+};
+
+namespace {
+
+// Calls a subroutine that calls another twice, then calls the other directly and idles.
+auto create_machine(Backend const backend) -> Machine
+{
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x22, 0x0A, // CALL 20Ah
+            0x22, 0x0A, // CALL 20Ah
+            0x22, 0x10, // CALL 210h
+            0x12, 0x06, // JMP 206h
+            0x00, 0x00, // Unused
+            0x70, 0x01, // ADD %V0, $01h
+            0x22, 0x10, // CALL 210h
+            0x00, 0xEE, // RET
+            0x71, 0x01, // ADD %V1, $01h
+            0x00, 0xEE, // RET
+        },
+        m.memory());
+    return m;
+}
+
+} // namespace
+
+TEST_CASE("Profile counts the instructions of each operator, address, and call chain",
+    "[machine][profile]")
+{
+    auto m = create_machine(Backend::compiled);
+    m.profile().emplace();
+    REQUIRE(m.run(30, no_stop_reasons) == RunResult{StopReason::budget_exhausted, 30});
+
+    auto const& p = *m.profile();
+    REQUIRE(p.cycles() == 30);
+    REQUIRE(p.operator_count(Operator::call_a) == 5);
+    REQUIRE(p.operator_count(Operator::add_v_b) == 5);
+    REQUIRE(p.operator_count(Operator::ret) == 5);
+    REQUIRE(p.operator_count(Operator::jmp_a) == 15);
+    REQUIRE(p.operator_count(Operator::cls) == 0);
+    REQUIRE(p.address_count(0x200) == 1);
+    REQUIRE(p.address_count(0x206) == 15);
+    REQUIRE(p.address_count(0x210) == 3);
+    REQUIRE(p.address_count(0x208) == 0);
+
+    auto const subroutines = p.subroutines();
+    REQUIRE(subroutines.size() == 2);
+    REQUIRE(subroutines[0].address == 0x20A);
+    REQUIRE(subroutines[0].calls == 2);
+    REQUIRE(subroutines[0].self_cycles == 6);
+    REQUIRE(subroutines[0].total_cycles == 10);
+    REQUIRE(subroutines[1].address == 0x210);
+    REQUIRE(subroutines[1].calls == 3);
+    REQUIRE(subroutines[1].self_cycles == 6);
+    REQUIRE(subroutines[1].total_cycles == 6);
+
+    REQUIRE(p.to_collapsed_stacks()
+        == "main 18\n"
+           "main;20Ah 6\n"
+           "main;20Ah;210h 4\n"
+           "main;210h 2\n");
+
+    auto const flat = p.to_flat_profile();
+    REQUIRE(flat.find("          15  jmp_a\n") != std::string::npos);
+    REQUIRE(flat.find("          15  206h\n") != std::string::npos);
+    REQUIRE(flat.find("           2             6            10  20Ah\n") != std::string::npos);
+}
+
+TEST_CASE("Profile counts the cycles of recursive subroutines once", "[machine][profile]")
+{
+    Machine m;
+    load_into_memory<Machine::program_address>(
+        {
+            0x22, 0x04, // CALL 204h
+            0x12, 0x02, // JMP 202h
+            0x70, 0x01, // ADD %V0, $01h
+            0x30, 0x03, // SEQ %V0, $03h
+            0x22, 0x04, // CALL 204h
+            0x00, 0xEE, // RET
+        },
+        m.memory());
+    m.profile().emplace();
+    REQUIRE(m.run(20, no_stop_reasons) == RunResult{StopReason::budget_exhausted, 20});
+
+    auto const subroutines = m.profile()->subroutines();
+    REQUIRE(subroutines.size() == 1);
+    REQUIRE(subroutines[0].calls == 3);
+    REQUIRE(subroutines[0].self_cycles == 11);
+    REQUIRE(subroutines[0].total_cycles == 11);
+    REQUIRE(m.profile()->to_collapsed_stacks()
+        == "main 9\n"
+           "main;204h 4\n"
+           "main;204h;204h 4\n"
+           "main;204h;204h;204h 3\n");
+}
+
+TEST_CASE("Profiled machines run as unprofiled machines do", "[machine][profile]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+    auto m = create_machine(backend);
+    auto m_expect = create_machine(backend);
+    m.profile().emplace();
+    REQUIRE(m.run(1000, no_stop_reasons) == m_expect.run(1000, no_stop_reasons));
+    REQUIRE(m == m_expect);
+    REQUIRE(m.profile()->cycles() == 1000);
+}
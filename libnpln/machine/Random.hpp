@@ -0,0 +1,65 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_RANDOM_HPP
+#define LIBNPLN_MACHINE_RANDOM_HPP
+
+#include <libnpln/machine/DataUnits.hpp>
+
+#include <cstdint>
+#include <random>
+
+namespace libnpln::machine {
+
+// The source of random bytes for the RND instruction.  The bytes are drawn from an engine with a
+// specified algorithm, without a distribution, so that the same seed produces the same bytes with
+// every standard library.
+class Random
+{
+public:
+    using Seed = std::uint32_t;
+
+    Random() : Random{std::random_device{}()} {}
+    explicit Random(Seed const seed) noexcept : seed_{seed}, engine_{seed} {}
+
+    auto operator==(Random const& rhs) const noexcept
+    {
+        return seed_ == rhs.seed_ && engine_ == rhs.engine_;
+    }
+
+    auto operator!=(Random const& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    auto operator()() noexcept -> Byte
+    {
+        // The engine produces 31 bits, of which the high bits are the most random.
+        return static_cast<Byte>(engine_() >> 23U);
+    }
+
+    // The seed that the random source was created with, regardless of how many bytes were drawn.
+    [[nodiscard]] auto seed() const noexcept -> Seed
+    {
+        return seed_;
+    }
+
+private:
+    Seed seed_;
+    std::minstd_rand engine_;
+};
+
+} // namespace libnpln::machine
+
+#endif
@@ -0,0 +1,45 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Random.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+
+using namespace libnpln::machine;
+
+TEST_CASE("Random draws the same bytes from the same seed everywhere", "[machine][random]")
+{
+    // The bytes are specified by the algorithm of the engine, so they are fixed here.
+    auto r = Random{0x1234};
+    std::array<Byte, 8> bytes{};
+    for (auto& b : bytes) {
+        b = r();
+    }
+    REQUIRE(bytes == std::array<Byte, 8>{0x1A, 0x40, 0x4D, 0xE8, 0xAC, 0xF4, 0xC9, 0xB8});
+    REQUIRE(r.seed() == 0x1234);
+}
+
+TEST_CASE("Random copies draw the same bytes as the original", "[machine][random]")
+{
+    auto r = Random{};
+    r();
+    auto copy = r;
+    REQUIRE(copy == r);
+    REQUIRE(copy() == r());
+    REQUIRE(copy == r);
+    r();
+    REQUIRE(copy != r);
+}
@@ -0,0 +1,55 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Recorder.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace libnpln::machine {
+
+Recorder::Recorder(Machine& machine) : machine_{machine}
+{
+    auto const& memory = std::as_const(machine).memory();
+    auto const first = std::next(memory.begin(), Machine::program_address);
+    auto const last = std::find_if(memory.rbegin(), std::make_reverse_iterator(first), [](Byte b) {
+        return b != 0;
+    }).base();
+
+    replay_.master_clock_rate = machine.master_clock_rate();
+    replay_.seed = machine.random().seed();
+    replay_.program.assign(first, last);
+}
+
+auto Recorder::run(std::size_t const cycle_budget, flags::flags<StopReason> const stop_reasons)
+    -> RunResult
+{
+    if (machine_.keys() != recorded_keys_) {
+        auto const [pressed, released] = keys_difference(recorded_keys_, machine_.keys());
+        for (auto const k : released) {
+            replay_.events.push_back(KeyEvent{replay_.cycles, k, false});
+        }
+        for (auto const k : pressed) {
+            replay_.events.push_back(KeyEvent{replay_.cycles, k, true});
+        }
+        recorded_keys_ = machine_.keys();
+    }
+
+    auto const r = machine_.run(cycle_budget, stop_reasons);
+    replay_.cycles += r.cycles;
+    return r;
+}
+
+} // namespace libnpln::machine
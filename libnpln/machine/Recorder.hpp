@@ -0,0 +1,58 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_RECORDER_HPP
+#define LIBNPLN_MACHINE_RECORDER_HPP
+
+#include <libnpln/machine/Keys.hpp>
+#include <libnpln/machine/Machine.hpp>
+#include <libnpln/machine/Replay.hpp>
+#include <libnpln/machine/RunResult.hpp>
+
+#include <flags/flags.hpp>
+
+#include <cstddef>
+
+namespace libnpln::machine {
+
+// Runs a machine while recording a replay of the run.  The machine must not have run since it was
+// created and its program loaded, so that create_machine can create it again from the replay.  The
+// keys may be changed between runs, and each change is recorded at the cycle that it happened.
+class Recorder
+{
+public:
+    explicit Recorder(Machine& machine);
+    Recorder(Recorder const&) = delete;
+    Recorder(Recorder&&) noexcept = delete;
+    ~Recorder() = default;
+
+    auto operator=(Recorder const&) -> Recorder& = delete;
+    auto operator=(Recorder&&) noexcept -> Recorder& = delete;
+
+    auto run(std::size_t cycle_budget, flags::flags<StopReason> stop_reasons) -> RunResult;
+
+    [[nodiscard]] auto replay() const noexcept -> Replay const&
+    {
+        return replay_;
+    }
+
+private:
+    Machine& machine_;
+    Keys recorded_keys_;
+    Replay replay_;
+};
+
+} // namespace libnpln::machine
+
+#endif
@@ -0,0 +1,100 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Recorder.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <sstream>
+
+using namespace libnpln::machine;
+
+template<>
+struct Catch::StringMaker<Machine>
+{
+    static auto convert(Machine const& m)
+    {
+        return fmt::to_string(m);
+    }
+};
+
+namespace {
+
+// Draws a random digit at a position that depends on which of keys 5 and 6 are held.
+auto create_machine() -> Machine
+{
+    Machine m;
+    load_into_memory<Machine::program_address>(
+        {
+            0x60, 0x05, // MOV %V0, $05h
+            0x61, 0x06, // MOV %V1, $06h
+            0xC2, 0x0F, // RND %V2, $0Fh
+            0xF2, 0x29, // FONT %V2
+            0xE0, 0xA1, // SKNP %V0
+            0x73, 0x05, // ADD %V3, $05h
+            0xE1, 0xA1, // SKNP %V1
+            0x74, 0x03, // ADD %V4, $03h
+            0xD3, 0x45, // DRW %V3, %V4, $5h
+            0x12, 0x04, // JMP 204h
+        },
+        m.memory());
+    return m;
+}
+
+} // namespace
+
+TEST_CASE("Recorder records a run that can be replayed exactly", "[machine][recorder]")
+{
+    auto m = create_machine();
+    auto recorder = Recorder{m};
+
+    // The keys change between runs of uneven lengths, including before the first.
+    m.keys().set(to_index(Key::k5));
+    REQUIRE(recorder.run(37, no_stop_reasons).cycles == 37);
+    m.keys().set(to_index(Key::k6));
+    REQUIRE(recorder.run(1, no_stop_reasons).cycles == 1);
+    REQUIRE(recorder.run(50, no_stop_reasons).cycles == 50);
+    m.keys().reset(to_index(Key::k5));
+    m.keys().reset(to_index(Key::k6));
+    m.keys().set(to_index(Key::ka));
+    REQUIRE(recorder.run(200, no_stop_reasons).cycles == 200);
+
+    auto s = std::stringstream{};
+    REQUIRE(write_replay(s, recorder.replay()));
+    auto const r = read_replay(s);
+    REQUIRE(r == recorder.replay());
+    REQUIRE(r->cycles == 288);
+    REQUIRE(r->events
+        == InputScript{
+            KeyEvent{0, Key::k5, true},
+            KeyEvent{37, Key::k6, true},
+            KeyEvent{88, Key::k5, false},
+            KeyEvent{88, Key::k6, false},
+            KeyEvent{88, Key::ka, true},
+        });
+
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+    auto replayed = create_machine(*r, backend);
+    REQUIRE(replayed != std::nullopt);
+    auto event = r->events.begin();
+    for (std::size_t cycle = 0; cycle < r->cycles; ++cycle) {
+        for (; event != r->events.end() && event->cycle == cycle; ++event) {
+            replayed->keys().set(to_index(event->key), event->pressed);
+        }
+        REQUIRE(replayed->cycle());
+    }
+    REQUIRE(*replayed == m);
+    REQUIRE(replayed->random() == m.random());
+}
@@ -0,0 +1,175 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Replay.hpp>
+
+#include <libnpln/detail/cpp2b.hpp>
+
+#include <gsl/gsl>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+
+namespace libnpln::machine {
+
+namespace {
+
+constexpr std::array<char, 4> magic{'N', 'P', 'L', 'R'};
+constexpr char version = 1;
+
+// The largest program that fits in memory after the program address.
+constexpr std::size_t max_program_size = memory_size - Machine::program_address;
+
+auto write_number(std::ostream& s, std::uint64_t n) -> void
+{
+    while (n >= 0x80U) {
+        s.put(static_cast<char>(n | 0x80U));
+        n >>= 7U;
+    }
+    s.put(static_cast<char>(n));
+}
+
+auto read_number(std::istream& s) -> std::optional<std::uint64_t>
+{
+    std::uint64_t n = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        auto const c = s.get();
+        if (c == std::istream::traits_type::eof()) {
+            return std::nullopt;
+        }
+
+        auto const b = static_cast<std::uint64_t>(c);
+        n |= (b & 0x7FU) << shift;
+        if ((b & 0x80U) == 0) {
+            return n;
+        }
+    }
+
+    return std::nullopt;
+}
+
+} // namespace
+
+auto create_machine(Replay const& r, Backend const backend) -> std::optional<Machine>
+{
+    Machine m{backend};
+    if (!load_into_memory(
+            r.program.begin(), r.program.end(), m.memory(), Machine::program_address)) {
+        return std::nullopt;
+    }
+
+    m.master_clock_rate() = r.master_clock_rate;
+    m.random() = Random{r.seed};
+    return m;
+}
+
+auto write_replay(std::ostream& s, Replay const& r) -> bool
+{
+    s.write(magic.data(), magic.size());
+    s.put(version);
+    write_number(s, static_cast<std::uint64_t>(r.master_clock_rate.count()));
+    write_number(s, r.seed);
+    write_number(s, r.cycles);
+
+    write_number(s, r.program.size());
+    // reinterpret_cast between unsigned char* and char* is safe because they have the same
+    // representation and alignment.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    s.write(reinterpret_cast<char const*>(r.program.data()),
+        gsl::narrow<std::streamsize>(r.program.size()));
+
+    write_number(s, r.events.size());
+    std::size_t cycle = 0;
+    for (auto const& e : r.events) {
+        write_number(s, e.cycle - cycle);
+        s.put(static_cast<char>(
+            (libnpln::detail::to_underlying(e.key) << 1U) | static_cast<unsigned>(e.pressed)));
+        cycle = e.cycle;
+    }
+
+    return static_cast<bool>(s);
+}
+
+auto write_replay(std::filesystem::path const& p, Replay const& r) -> bool
+{
+    auto s = std::ofstream{p, std::ios::out | std::ios::binary};
+    return s ? write_replay(s, r) : false;
+}
+
+auto read_replay(std::istream& s) -> std::optional<Replay>
+{
+    std::array<char, magic.size() + 1> header{};
+    if (!s.read(header.data(), header.size())
+        || !std::equal(magic.begin(), magic.end(), header.begin()) || header.back() != version) {
+        return std::nullopt;
+    }
+
+    auto const rate = read_number(s);
+    auto const seed = read_number(s);
+    auto const cycles = read_number(s);
+    auto const program_size = read_number(s);
+    if (rate == std::nullopt || *rate == 0
+        || *rate > static_cast<std::uint64_t>(std::numeric_limits<frequencypp::hertz::rep>::max())
+        || seed == std::nullopt || *seed > std::numeric_limits<Random::Seed>::max()
+        || cycles == std::nullopt || program_size == std::nullopt
+        || *program_size > max_program_size) {
+        return std::nullopt;
+    }
+
+    Replay r;
+    r.master_clock_rate = frequencypp::hertz{static_cast<frequencypp::hertz::rep>(*rate)};
+    r.seed = static_cast<Random::Seed>(*seed);
+    r.cycles = gsl::narrow_cast<std::size_t>(*cycles);
+    r.program.resize(*program_size);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (!s.read(reinterpret_cast<char*>(r.program.data()),
+            gsl::narrow<std::streamsize>(r.program.size()))) {
+        return std::nullopt;
+    }
+
+    auto const event_count = read_number(s);
+    if (event_count == std::nullopt) {
+        return std::nullopt;
+    }
+
+    std::size_t cycle = 0;
+    for (std::uint64_t i = 0; i < *event_count; ++i) {
+        auto const delta = read_number(s);
+        auto const c = s.get();
+        if (delta == std::nullopt || c == std::istream::traits_type::eof()
+            || (static_cast<unsigned>(c) >> 1U) >= key_count) {
+            return std::nullopt;
+        }
+
+        cycle += gsl::narrow_cast<std::size_t>(*delta);
+        r.events.push_back(
+            KeyEvent{cycle, static_cast<Key>(static_cast<unsigned>(c) >> 1U), (c & 1) != 0});
+    }
+
+    return r;
+}
+
+auto read_replay(std::filesystem::path const& p) -> std::optional<Replay>
+{
+    auto s = std::ifstream{p, std::ios::in | std::ios::binary};
+    return s ? read_replay(s) : std::nullopt;
+}
+
+} // namespace libnpln::machine
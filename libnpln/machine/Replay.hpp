@@ -0,0 +1,73 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_REPLAY_HPP
+#define LIBNPLN_MACHINE_REPLAY_HPP
+
+#include <libnpln/machine/Backend.hpp>
+#include <libnpln/machine/DataUnits.hpp>
+#include <libnpln/machine/InputScript.hpp>
+#include <libnpln/machine/Machine.hpp>
+#include <libnpln/machine/Random.hpp>
+
+#include <frequencypp/frequency.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <vector>
+
+namespace libnpln::machine {
+
+// Everything that a run of a machine depends on, so that it can be executed again exactly.
+struct Replay
+{
+    auto operator==(Replay const& rhs) const noexcept
+    {
+        return master_clock_rate == rhs.master_clock_rate && seed == rhs.seed
+            && program == rhs.program && events == rhs.events && cycles == rhs.cycles;
+    }
+    auto operator!=(Replay const& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    frequencypp::hertz master_clock_rate{120};
+    Random::Seed seed = 0;
+    // The memory from the program address, without the zeros at its end.
+    std::vector<Byte> program;
+    InputScript events;
+    // The number of cycles that the machine ran for.
+    std::size_t cycles = 0;
+};
+
+// Creates the machine that the replay was recorded from, or std::nullopt if the program does not
+// fit in memory.  The backend does not affect the run.
+auto create_machine(Replay const& r, Backend backend) -> std::optional<Machine>;
+
+// Replays are written in a compact binary format: the magic bytes "NPLR" and a version byte,
+// followed by the clock rate, seed, cycles, program size, and the program, then the number of
+// events and each event as the cycles since the previous event and a byte holding the key and
+// whether it was pressed.  Numbers are written in LEB128, seven bits to a byte.
+auto write_replay(std::ostream& s, Replay const& r) -> bool;
+auto write_replay(std::filesystem::path const& p, Replay const& r) -> bool;
+
+// Reads a replay written by write_replay, or returns std::nullopt if it is not one.
+auto read_replay(std::istream& s) -> std::optional<Replay>;
+auto read_replay(std::filesystem::path const& p) -> std::optional<Replay>;
+
+} // namespace libnpln::machine
+
+#endif
@@ -0,0 +1,88 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Replay.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+
+using namespace libnpln::machine;
+
+namespace {
+
+auto create_replay() -> Replay
+{
+    Replay r;
+    r.master_clock_rate = frequencypp::hertz{540};
+    r.seed = 0xDEADBEEF;
+    r.program = {0xC0, 0xFF, 0x12, 0x00};
+    r.events = {
+        KeyEvent{0, Key::k5, true},
+        KeyEvent{0, Key::ka, true},
+        KeyEvent{300, Key::k5, false},
+        KeyEvent{100'000, Key::ka, false},
+    };
+    r.cycles = 1'000'000;
+    return r;
+}
+
+} // namespace
+
+TEST_CASE("Replay can be written and read back", "[machine][replay]")
+{
+    auto const r = create_replay();
+    auto s = std::stringstream{};
+    REQUIRE(write_replay(s, r));
+
+    // Every number but the seed and the last cycles fits in a few bytes.
+    REQUIRE(s.str().size() < 40);
+    REQUIRE(read_replay(s) == r);
+}
+
+TEST_CASE("Replay cannot be read from a truncated or invalid file", "[machine][replay]")
+{
+    auto written = std::stringstream{};
+    REQUIRE(write_replay(written, create_replay()));
+    auto const bytes = written.str();
+
+    auto const size = GENERATE_COPY(range<std::size_t>(0, bytes.size()));
+    auto truncated = std::istringstream{bytes.substr(0, size)};
+    REQUIRE(read_replay(truncated) == std::nullopt);
+
+    auto const corruption = GENERATE(as<std::string>{}, "NPLX", "NPLR\x02");
+    auto corrupted = std::istringstream{corruption + bytes.substr(corruption.size())};
+    REQUIRE(read_replay(corrupted) == std::nullopt);
+}
+
+TEST_CASE("Replay cannot be read from a missing file", "[machine][replay]")
+{
+    REQUIRE(read_replay(std::filesystem::path{"replay-test-missing-file"}) == std::nullopt);
+}
+
+TEST_CASE("Replay creates the machine that it was recorded from", "[machine][replay]")
+{
+    auto r = create_replay();
+    auto const m = create_machine(r, Backend::threaded);
+    REQUIRE(m != std::nullopt);
+    REQUIRE(m->backend() == Backend::threaded);
+    REQUIRE(m->master_clock_rate() == r.master_clock_rate);
+    REQUIRE(m->random() == Random{r.seed});
+    REQUIRE(m->memory()[Machine::program_address] == 0xC0);
+    REQUIRE(m->memory()[Machine::program_address + 3] == 0x00);
+
+    r.program.resize(memory_size - Machine::program_address + 1);
+    REQUIRE(create_machine(r, Backend::switched) == std::nullopt);
+}
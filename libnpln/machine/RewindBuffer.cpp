@@ -0,0 +1,215 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/RewindBuffer.hpp>
+
+#include <libnpln/machine/Snapshot.hpp>
+
+#include <gsl/gsl>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace libnpln::machine {
+
+namespace {
+
+// Lengths are written in LEB128, seven bits to a byte with the high bit set on all but the last.
+auto write_length(std::size_t length, std::vector<Byte>& out) -> void
+{
+    while (length >= 0x80U) {
+        out.push_back(static_cast<Byte>(length | 0x80U));
+        length >>= 7U;
+    }
+    out.push_back(static_cast<Byte>(length));
+}
+
+auto read_length(gsl::span<Byte const> const in, std::size_t& offset) -> std::size_t
+{
+    std::size_t length = 0;
+    for (std::size_t shift = 0;; shift += 7) {
+        auto const b = in[offset++];
+        length |= std::size_t{b & 0x7FU} << shift;
+        if ((b & 0x80U) == 0) {
+            return length;
+        }
+    }
+}
+
+// Encodes the XOR of two frames of equal size as pairs of a run of zeros, written as its length,
+// and a run of other bytes, written as its length followed by the bytes.
+auto encode_delta(gsl::span<Byte const> const a, gsl::span<Byte const> const b)
+    -> std::vector<Byte>
+{
+    std::vector<Byte> delta;
+    std::size_t i = 0;
+    while (i < a.size()) {
+        auto const zeros_begin = i;
+        while (i < a.size() && a[i] == b[i]) {
+            ++i;
+        }
+        auto const literal_begin = i;
+        while (i < a.size() && a[i] != b[i]) {
+            ++i;
+        }
+
+        write_length(literal_begin - zeros_begin, delta);
+        write_length(i - literal_begin, delta);
+        for (auto j = literal_begin; j < i; ++j) {
+            delta.push_back(static_cast<Byte>(a[j] ^ b[j]));
+        }
+    }
+    return delta;
+}
+
+// XORs the frame with the delta that encode_delta produced.
+auto apply_delta(gsl::span<Byte const> const delta, gsl::span<Byte> const frame) -> void
+{
+    std::size_t offset = 0;
+    std::size_t i = 0;
+    while (offset < delta.size()) {
+        i += read_length(delta, offset);
+        auto const literals = read_length(delta, offset);
+        for (std::size_t j = 0; j < literals; ++j) {
+            frame[i++] ^= delta[offset++];
+        }
+    }
+}
+
+} // namespace
+
+RewindBuffer::RewindBuffer(Machine& machine, std::size_t const interval, std::size_t const capacity)
+    : machine_{machine}, interval_{interval}, capacity_{capacity}
+{
+    if (interval == 0 || capacity == 0) {
+        throw std::invalid_argument{"RewindBuffer requires a positive interval and capacity"};
+    }
+
+    record();
+}
+
+auto RewindBuffer::run(std::size_t const cycle_budget, flags::flags<StopReason> const stop_reasons)
+    -> RunResult
+{
+    // The keys are only changed between runs, so the state is recorded before running with new
+    // keys.
+    if (machine_.keys() != recorded_keys_) {
+        if (records_.back().cycle == cycle_ && records_.size() > 1) {
+            pop_record();
+        }
+        else if (records_.back().cycle == cycle_) {
+            records_.clear();
+        }
+        record();
+    }
+
+    // Records are taken at multiples of the interval, even after recording a change of the keys.
+    std::size_t cycles = 0;
+    while (cycles < cycle_budget) {
+        auto const next_record = (cycle_ / interval_ + 1) * interval_;
+        auto const r =
+            machine_.run(std::min(cycle_budget - cycles, next_record - cycle_), stop_reasons);
+        cycles += r.cycles;
+        cycle_ += r.cycles;
+        if (cycle_ == next_record) {
+            record();
+        }
+        if (r.reason != StopReason::budget_exhausted) {
+            return {r.reason, cycles};
+        }
+    }
+
+    return {StopReason::budget_exhausted, cycles};
+}
+
+auto RewindBuffer::step_back() -> bool
+{
+    if (cycle_ == records_.back().cycle) {
+        if (records_.size() == 1) {
+            return false;
+        }
+        pop_record();
+    }
+
+    restore_newest();
+    return true;
+}
+
+auto RewindBuffer::seek(std::size_t const cycle) -> bool
+{
+    if (cycle < first_cycle() || cycle > cycle_) {
+        return false;
+    }
+    if (cycle == cycle_) {
+        return true;
+    }
+
+    while (records_.back().cycle > cycle) {
+        pop_record();
+    }
+    restore_newest();
+
+    // Nothing that was not recorded changed between the record and the cycle.
+    machine_.run(cycle - cycle_, no_stop_reasons);
+    cycle_ = cycle;
+    return true;
+}
+
+auto RewindBuffer::history_size() const noexcept -> std::size_t
+{
+    auto size = newest_frame_.size();
+    for (auto const& r : records_) {
+        size += sizeof(r) + r.delta.size();
+    }
+    return size;
+}
+
+auto RewindBuffer::record() -> void
+{
+    auto const s = machine_.snapshot();
+    std::vector<Byte> frame(Snapshot::frame_size);
+    s.write_frame(frame);
+
+    if (!records_.empty()) {
+        records_.back().delta = encode_delta(newest_frame_, frame);
+    }
+    records_.push_back({cycle_, s.random(), {}});
+    newest_frame_ = std::move(frame);
+    recorded_keys_ = s.keys();
+
+    if (records_.size() > capacity_) {
+        records_.pop_front();
+    }
+}
+
+auto RewindBuffer::pop_record() -> void
+{
+    records_.pop_back();
+    apply_delta(records_.back().delta, newest_frame_);
+    records_.back().delta.clear();
+    records_.back().delta.shrink_to_fit();
+}
+
+auto RewindBuffer::restore_newest() -> void
+{
+    // The pages that did not change since the record are shared with the machine, which then
+    // keeps them along with the code decoded and compiled from them.
+    auto const current = machine_.snapshot();
+    machine_.restore(
+        Snapshot::read_frame(newest_frame_, records_.back().random, current.pages()));
+    cycle_ = records_.back().cycle;
+    recorded_keys_ = machine_.keys();
+}
+
+} // namespace libnpln::machine
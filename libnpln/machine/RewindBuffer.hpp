@@ -0,0 +1,108 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_REWINDBUFFER_HPP
+#define LIBNPLN_MACHINE_REWINDBUFFER_HPP
+
+#include <libnpln/machine/DataUnits.hpp>
+#include <libnpln/machine/Keys.hpp>
+#include <libnpln/machine/Machine.hpp>
+#include <libnpln/machine/RunResult.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace libnpln::machine {
+
+// Runs a machine while recording its state, so that it can be rewound to any earlier cycle within
+// a bounded history.  The state is recorded at every multiple of the interval and whenever the keys
+// changed since the last record, so that the cycles between records can be simulated again exactly.
+//
+// Only the newest record is kept whole.  Every other record is kept as the XOR of its frame with
+// the frame of the next record, with runs of zeros encoded by their length, which is small for the
+// mostly unchanging state of a machine.  As XOR is its own inverse, each step back through the
+// records takes a single delta.
+class RewindBuffer
+{
+public:
+    // Records the current state of the machine as cycle zero.  From now on, the machine must only
+    // be run through this buffer, and only its keys may be changed between runs.
+    RewindBuffer(Machine& machine, std::size_t interval, std::size_t capacity);
+    RewindBuffer(RewindBuffer const&) = delete;
+    RewindBuffer(RewindBuffer&&) noexcept = delete;
+    ~RewindBuffer() = default;
+
+    auto operator=(RewindBuffer const&) -> RewindBuffer& = delete;
+    auto operator=(RewindBuffer&&) noexcept -> RewindBuffer& = delete;
+
+    // Runs the machine as Machine::run does, recording its state along the way.
+    auto run(std::size_t cycle_budget, flags::flags<StopReason> stop_reasons = all_stop_reasons)
+        -> RunResult;
+
+    // Restores the newest record before the current cycle, discarding any newer ones.  Returns
+    // whether there was such a record.
+    auto step_back() -> bool;
+
+    // Restores the state at the given cycle by restoring the newest record at or before it and
+    // running the machine up to it, discarding any newer records.  Returns whether the cycle is
+    // within the history.
+    auto seek(std::size_t cycle) -> bool;
+
+    // The number of cycles that the machine has run through this buffer.
+    [[nodiscard]] auto cycle() const noexcept -> std::size_t
+    {
+        return cycle_;
+    }
+
+    // The cycle of the oldest record, which is the earliest cycle that can be sought.
+    [[nodiscard]] auto first_cycle() const noexcept -> std::size_t
+    {
+        return records_.front().cycle;
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return records_.size();
+    }
+
+    // The number of bytes that the records occupy.
+    [[nodiscard]] auto history_size() const noexcept -> std::size_t;
+
+private:
+    struct Record
+    {
+        std::size_t cycle;
+        Random random;
+        // The frame of this record XORed with the frame of the next, or empty for the newest.
+        std::vector<Byte> delta;
+    };
+
+    auto record() -> void;
+    auto pop_record() -> void;
+    auto restore_newest() -> void;
+
+    Machine& machine_;
+    std::size_t interval_;
+    std::size_t capacity_;
+    std::size_t cycle_ = 0;
+
+    std::deque<Record> records_;
+    std::vector<Byte> newest_frame_;
+    Keys recorded_keys_;
+};
+
+} // namespace libnpln::machine
+
+#endif
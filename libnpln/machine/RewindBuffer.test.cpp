@@ -0,0 +1,178 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/RewindBuffer.hpp>
+
+#include <libnpln/machine/Snapshot.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+using namespace libnpln::machine;
+
+template<>
+struct Catch::StringMaker<Machine>
+{
+    static auto convert(Machine const& m)
+    {
+        return fmt::to_string(m);
+    }
+};
+
+namespace {
+
+// Draws random digits at positions that depend on whether key 5 is held.
+auto create_machine() -> Machine
+{
+    Machine m;
+    load_into_memory<Machine::program_address>(
+        {
+            0xC0, 0x0F, // RND %V0, $0Fh
+            0xF0, 0x29, // FONT %V0
+            0xD1, 0x25, // DRW %V1, %V2, $5h
+            0x71, 0x05, // ADD %V1, $05h
+            0x63, 0x05, // MOV %V3, $05h
+            0xE3, 0x9E, // SKP %V3
+            0x12, 0x00, // JMP 200h
+            0x72, 0x03, // ADD %V2, $03h
+            0xA3, 0x00, // MOV %I, $300h
+            0xF2, 0x33, // BCD %V2
+            0x12, 0x00, // JMP 200h
+        },
+        m.memory());
+    return m;
+}
+
+// Runs the machine from one cycle to another, holding key 5 from cycle 105 to 205.
+auto run_to(Machine& m, std::size_t const from, std::size_t const to) -> void
+{
+    for (auto c = from; c < to; ++c) {
+        m.keys().set(to_index(Key::k5), c >= 105 && c < 205);
+        REQUIRE(m.run(1, no_stop_reasons).cycles == 1);
+    }
+}
+
+auto run_to(RewindBuffer& b, Machine& m, std::size_t const to) -> void
+{
+    for (auto c = b.cycle(); c < to; ++c) {
+        m.keys().set(to_index(Key::k5), c >= 105 && c < 205);
+        REQUIRE(b.run(1, no_stop_reasons).cycles == 1);
+    }
+}
+
+} // namespace
+
+TEST_CASE("RewindBuffer steps back through each record", "[machine][rewind_buffer]")
+{
+    auto m = create_machine();
+    auto b = RewindBuffer{m, 10, 100};
+    REQUIRE(b.size() == 1);
+
+    // Each record is expected at each multiple of the interval.
+    std::vector<Machine> expected{m};
+    for (std::size_t c = 10; c <= 300; c += 10) {
+        run_to(b, m, c);
+        expected.push_back(m);
+    }
+    run_to(b, m, 305);
+
+    // Both key changes happen between records, so they are recorded on their own.
+    REQUIRE(b.size() == expected.size() + 2);
+
+    for (auto e = expected.rbegin(); e != expected.rend(); ++e) {
+        REQUIRE(b.step_back());
+        if (b.cycle() % 10 != 0) {
+            REQUIRE((b.cycle() == 105 || b.cycle() == 205));
+            REQUIRE(b.step_back());
+        }
+        REQUIRE(m == *e);
+        REQUIRE(b.cycle() == static_cast<std::size_t>(std::distance(e, expected.rend()) - 1) * 10);
+    }
+    REQUIRE_FALSE(b.step_back());
+    REQUIRE(b.cycle() == 0);
+}
+
+TEST_CASE("RewindBuffer keeps the pages that did not change", "[machine][rewind_buffer]")
+{
+    auto m = create_machine();
+    auto b = RewindBuffer{m, 10, 100};
+    run_to(b, m, 300);
+
+    // Only the page at 300h is written by the program.
+    auto const pages = m.snapshot().pages();
+    REQUIRE(b.step_back());
+    auto const restored = m.snapshot().pages();
+    for (std::size_t p = 0; p < page_count; ++p) {
+        if (p != 0x3) {
+            REQUIRE(restored[p] == pages[p]);
+        }
+    }
+}
+
+TEST_CASE("RewindBuffer seeks to exact cycles", "[machine][rewind_buffer]")
+{
+    auto const target = GENERATE(0, 1, 9, 10, 104, 105, 106, 150, 204, 205, 206, 299, 300);
+
+    auto m = create_machine();
+    auto m_expect = m;
+    auto b = RewindBuffer{m, 10, 100};
+    run_to(b, m, 300);
+
+    REQUIRE(b.seek(target));
+    REQUIRE(b.cycle() == static_cast<std::size_t>(target));
+    run_to(m_expect, 0, target);
+    REQUIRE(m.registers() == m_expect.registers());
+    REQUIRE(m.display() == m_expect.display());
+    REQUIRE(m.memory() == m_expect.memory());
+
+    // The machine continues from the target as it did the first time.
+    run_to(b, m, 400);
+    run_to(m_expect, target, 400);
+    REQUIRE(m == m_expect);
+}
+
+TEST_CASE("RewindBuffer cannot seek outside of its history", "[machine][rewind_buffer]")
+{
+    auto m = create_machine();
+    auto b = RewindBuffer{m, 10, 5};
+    run_to(b, m, 95);
+
+    REQUIRE(b.size() == 5);
+    REQUIRE(b.first_cycle() == 50);
+    REQUIRE_FALSE(b.seek(49));
+    REQUIRE_FALSE(b.seek(96));
+    REQUIRE(b.seek(50));
+    REQUIRE_FALSE(b.step_back());
+}
+
+TEST_CASE("RewindBuffer stores records as small deltas", "[machine][rewind_buffer]")
+{
+    auto m = create_machine();
+    auto b = RewindBuffer{m, 10, 1000};
+    REQUIRE(b.run(10'000, no_stop_reasons).cycles == 10'000);
+
+    REQUIRE(b.size() == 1000);
+    REQUIRE(b.history_size() < b.size() * Snapshot::frame_size / 20);
+}
+
+TEST_CASE("RewindBuffer requires a positive interval and capacity", "[machine][rewind_buffer]")
+{
+    auto m = create_machine();
+    REQUIRE_THROWS_AS(RewindBuffer(m, 0, 1), std::invalid_argument);
+    REQUIRE_THROWS_AS(RewindBuffer(m, 1, 0), std::invalid_argument);
+}
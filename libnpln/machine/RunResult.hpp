@@ -0,0 +1,110 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_RUNRESULT_HPP
+#define LIBNPLN_MACHINE_RUNRESULT_HPP
+
+#include <flags/flags.hpp>
+#include <fmt/format.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+
+namespace libnpln::machine {
+
+enum class StopReason
+{
+    budget_exhausted = 1U << 0U,
+    fault = 1U << 1U,
+    wait_for_key = 1U << 2U,
+    display_changed = 1U << 3U,
+    breakpoint = 1U << 4U,
+    watchpoint = 1U << 5U,
+};
+
+} // namespace libnpln::machine
+
+ALLOW_FLAGS_FOR_ENUM(libnpln::machine::StopReason);
+
+namespace libnpln::machine {
+
+extern flags::flags<StopReason> const no_stop_reasons;
+extern flags::flags<StopReason> const all_stop_reasons;
+
+struct RunResult
+{
+    StopReason reason;
+    std::size_t cycles;
+};
+
+constexpr auto operator==(RunResult const& lhs, RunResult const& rhs) noexcept
+{
+    return lhs.reason == rhs.reason && lhs.cycles == rhs.cycles;
+}
+
+constexpr auto operator!=(RunResult const& lhs, RunResult const& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+constexpr auto get_name(StopReason const r) -> std::string_view
+{
+    switch (r) {
+    case StopReason::budget_exhausted: return "budget_exhausted";
+    case StopReason::fault: return "fault";
+    case StopReason::wait_for_key: return "wait_for_key";
+    case StopReason::display_changed: return "display_changed";
+    case StopReason::breakpoint: return "breakpoint";
+    case StopReason::watchpoint: return "watchpoint";
+    }
+
+    throw std::out_of_range("Unknown StopReason in get_name");
+}
+
+} // namespace libnpln::machine
+
+template<>
+struct fmt::formatter<libnpln::machine::StopReason>
+{
+    template<typename ParseContext>
+    constexpr auto parse(ParseContext& context)
+    {
+        return context.begin();
+    }
+
+    template<typename FormatContext>
+    auto format(libnpln::machine::StopReason const& value, FormatContext& context)
+    {
+        return format_to(context.out(), "{}", libnpln::machine::get_name(value));
+    }
+};
+
+template<>
+struct fmt::formatter<libnpln::machine::RunResult>
+{
+    template<typename ParseContext>
+    constexpr auto parse(ParseContext& context)
+    {
+        return context.begin();
+    }
+
+    template<typename FormatContext>
+    auto format(libnpln::machine::RunResult const& value, FormatContext& context)
+    {
+        return format_to(context.out(), "{} after {} cycles", value.reason, value.cycles);
+    }
+};
+
+#endif
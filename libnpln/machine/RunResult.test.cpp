@@ -0,0 +1,97 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/RunResult.hpp>
+
+#include <libnpln/detail/cpp2b.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+using namespace libnpln;
+using namespace libnpln::machine;
+
+namespace {
+
+auto const stop_reasons = {
+    StopReason::budget_exhausted,
+    StopReason::fault,
+    StopReason::wait_for_key,
+    StopReason::display_changed,
+    StopReason::breakpoint,
+    StopReason::watchpoint,
+};
+
+} // namespace
+
+TEST_CASE("StopReason exposes correct enumerators", "[machine][run_result]")
+{
+    // Ensure that every stop reason has a unique nonzero underlying value.
+    for (auto i = std::begin(stop_reasons); i != std::end(stop_reasons); ++i) {
+        REQUIRE(detail::to_underlying(*i) != 0);
+        for (auto j = std::next(i); j != std::end(stop_reasons); ++j) {
+            REQUIRE(detail::to_underlying(*i) != detail::to_underlying(*j));
+        }
+    }
+}
+
+TEST_CASE("StopReason exposes flag interface", "[machine][run_result]")
+{
+    static_assert(flags::is_flags<StopReason>::value);
+
+    REQUIRE(no_stop_reasons.to_bitset().count() == 0);
+    REQUIRE(all_stop_reasons.to_bitset().count() == stop_reasons.size());
+}
+
+TEST_CASE("StopReasons define names", "[machine][run_result]")
+{
+    REQUIRE(get_name(StopReason::budget_exhausted) == "budget_exhausted");
+    REQUIRE(get_name(StopReason::fault) == "fault");
+    REQUIRE(get_name(StopReason::wait_for_key) == "wait_for_key");
+    REQUIRE(get_name(StopReason::display_changed) == "display_changed");
+    REQUIRE(get_name(StopReason::breakpoint) == "breakpoint");
+    REQUIRE(get_name(StopReason::watchpoint) == "watchpoint");
+}
+
+TEST_CASE("Unknown StopReasons do not define names", "[machine][run_result]")
+{
+    auto const invalid_stop_reason =
+        static_cast<StopReason>(std::numeric_limits<std::underlying_type_t<StopReason>>::max());
+    REQUIRE_THROWS_AS(get_name(invalid_stop_reason), std::out_of_range);
+}
+
+TEST_CASE("StopReason returns its name when formatted", "[machine][run_result]")
+{
+    for (auto&& r : stop_reasons) {
+        REQUIRE(fmt::format("{}", r) == get_name(r));
+    }
+}
+
+TEST_CASE("RunResult compares correctly", "[machine][run_result]")
+{
+    REQUIRE(RunResult{StopReason::fault, 3} == RunResult{StopReason::fault, 3});
+    REQUIRE(RunResult{StopReason::fault, 3} != RunResult{StopReason::fault, 4});
+    REQUIRE(RunResult{StopReason::fault, 3} != RunResult{StopReason::wait_for_key, 3});
+}
+
+TEST_CASE("RunResult formats correctly", "[machine][run_result]")
+{
+    REQUIRE(fmt::format("{}", RunResult{StopReason::budget_exhausted, 100})
+        == "budget_exhausted after 100 cycles");
+    REQUIRE(fmt::format("{}", RunResult{StopReason::display_changed, 7})
+        == "display_changed after 7 cycles");
+}
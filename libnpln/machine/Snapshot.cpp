@@ -0,0 +1,197 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Snapshot.hpp>
+
+#include <libnpln/detail/cpp2b.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace libnpln::machine {
+
+namespace {
+
+constexpr std::size_t byte_bits = std::numeric_limits<Byte>::digits;
+
+// Writes unsigned integers in little-endian order at consecutive offsets of a frame.
+class FrameWriter
+{
+public:
+    explicit FrameWriter(gsl::span<Byte> const frame) : frame_{frame} {}
+
+    template<typename T>
+    auto write(T const value) -> void
+    {
+        for (std::size_t b = 0; b < sizeof(T); ++b) {
+            frame_[offset_++] = static_cast<Byte>(value >> (b * byte_bits));
+        }
+    }
+
+private:
+    gsl::span<Byte> frame_;
+    std::size_t offset_ = 0;
+};
+
+// Reads what FrameWriter writes.
+class FrameReader
+{
+public:
+    explicit FrameReader(gsl::span<Byte const> const frame) : frame_{frame} {}
+
+    template<typename T>
+    auto read() -> T
+    {
+        T value = 0;
+        for (std::size_t b = 0; b < sizeof(T); ++b) {
+            value |= static_cast<T>(T{frame_[offset_++]} << (b * byte_bits));
+        }
+        return value;
+    }
+
+private:
+    gsl::span<Byte const> frame_;
+    std::size_t offset_ = 0;
+};
+
+} // namespace
+
+auto Snapshot::write_frame(gsl::span<Byte> const frame) const -> void
+{
+    if (frame.size() != frame_size) {
+        throw std::invalid_argument{"Snapshot frames must be of frame_size bytes"};
+    }
+
+    auto w = FrameWriter{frame};
+    w.write(static_cast<Byte>(fault_ != std::nullopt));
+    w.write(fault_ != std::nullopt ? static_cast<Byte>(fault_->type) : Byte{0});
+    w.write(fault_ != std::nullopt ? fault_->address : Address{0});
+    w.write(program_counter_);
+
+    for (std::size_t r = 0; r <= libnpln::detail::to_underlying(Register::vf); ++r) {
+        w.write(registers_[static_cast<Register>(r)]);
+    }
+    w.write(registers_.dt);
+    w.write(registers_.st);
+    w.write(registers_.i);
+
+    // The stack is written from the bottom, so that pushing and popping change few bytes.
+    w.write(static_cast<Byte>(stack_.size()));
+    auto a = std::begin(stack_);
+    for (std::size_t i = 0; i < Stack::max_size(); ++i) {
+        w.write(a != std::end(stack_) ? *a++ : Address{0});
+    }
+
+    for (auto const& page : pages_) {
+        for (auto const b : *page) {
+            w.write(b);
+        }
+    }
+    w.write(static_cast<std::uint16_t>(keys_.to_ulong()));
+
+    for (std::size_t y = 0; y < Display::height; ++y) {
+        w.write(display_.row(y));
+    }
+
+    w.write(static_cast<std::uint64_t>(master_clock_rate_.count()));
+    w.write(static_cast<std::uint64_t>(delay_cycles_));
+    w.write(static_cast<std::uint64_t>(sound_cycles_));
+    w.write(static_cast<std::uint64_t>(
+        timer_periods_clock_rate_ != std::nullopt ? timer_periods_clock_rate_->count() : 0));
+    w.write(static_cast<std::uint64_t>(delay_period_));
+    w.write(static_cast<std::uint64_t>(sound_period_));
+}
+
+auto Snapshot::read_frame(gsl::span<Byte const> const frame, Random const& random,
+    Pages const& pages) -> Snapshot
+{
+    if (frame.size() != frame_size) {
+        throw std::invalid_argument{"Snapshot frames must be of frame_size bytes"};
+    }
+
+    auto r = FrameReader{frame};
+    Snapshot s;
+    auto const faulted = r.read<Byte>() != 0;
+    auto const fault_type = static_cast<Fault::Type>(r.read<Byte>());
+    auto const fault_address = r.read<Address>();
+    if (faulted) {
+        s.fault_ = Fault{fault_type, fault_address};
+    }
+    s.program_counter_ = r.read<Address>();
+
+    for (std::size_t v = 0; v <= libnpln::detail::to_underlying(Register::vf); ++v) {
+        s.registers_[static_cast<Register>(v)] = r.read<Byte>();
+    }
+    s.registers_.dt = r.read<Byte>();
+    s.registers_.st = r.read<Byte>();
+    s.registers_.i = r.read<Word>();
+
+    auto const stack_size = r.read<Byte>();
+    for (std::size_t i = 0; i < Stack::max_size(); ++i) {
+        auto const a = r.read<Address>();
+        if (i < stack_size) {
+            s.stack_.push(a);
+        }
+    }
+
+    for (std::size_t p = 0; p < page_count; ++p) {
+        Page bytes{};
+        for (auto& b : bytes) {
+            b = r.read<Byte>();
+        }
+
+        auto const& shared = gsl::at(pages, static_cast<gsl::index>(p));
+        auto& page = gsl::at(s.pages_, static_cast<gsl::index>(p));
+        if (shared != nullptr && *shared == bytes) {
+            page = shared;
+        }
+        else {
+            page = std::make_shared<Page const>(bytes);
+        }
+    }
+    s.keys_ = Keys{r.read<std::uint16_t>()};
+
+    for (std::size_t y = 0; y < Display::height; ++y) {
+        s.display_.set_row(y, r.read<Display::Row>());
+    }
+
+    using Rep = frequencypp::hertz::rep;
+    s.master_clock_rate_ = frequencypp::hertz{static_cast<Rep>(r.read<std::uint64_t>())};
+    s.delay_cycles_ = r.read<std::uint64_t>();
+    s.sound_cycles_ = r.read<std::uint64_t>();
+    auto const timer_periods_clock_rate = r.read<std::uint64_t>();
+    if (timer_periods_clock_rate != 0) {
+        s.timer_periods_clock_rate_ =
+            frequencypp::hertz{static_cast<Rep>(timer_periods_clock_rate)};
+    }
+    s.delay_period_ = r.read<std::uint64_t>();
+    s.sound_period_ = r.read<std::uint64_t>();
+
+    s.random_ = random;
+    return s;
+}
+
+auto Snapshot::memory() const -> Memory
+{
+    Memory m{};
+    auto o = std::begin(m);
+    for (auto const& page : pages_) {
+        o = std::copy(std::begin(*page), std::end(*page), o);
+    }
+    return m;
+}
+
+} // namespace libnpln::machine
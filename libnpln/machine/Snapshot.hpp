@@ -0,0 +1,139 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_SNAPSHOT_HPP
+#define LIBNPLN_MACHINE_SNAPSHOT_HPP
+
+#include <libnpln/machine/DataUnits.hpp>
+#include <libnpln/machine/Display.hpp>
+#include <libnpln/machine/Fault.hpp>
+#include <libnpln/machine/Keys.hpp>
+#include <libnpln/machine/Memory.hpp>
+#include <libnpln/machine/Random.hpp>
+#include <libnpln/machine/Registers.hpp>
+#include <libnpln/machine/Stack.hpp>
+
+#include <frequencypp/frequency.hpp>
+#include <gsl/gsl>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace libnpln::machine {
+
+constexpr std::size_t page_size = 0x100;
+constexpr std::size_t page_count = memory_size / page_size;
+
+// Pages of memory are immutable once captured, so that any number of snapshots can share them.
+using Page = std::array<Byte, page_size>;
+using Pages = std::array<std::shared_ptr<Page const>, page_count>;
+
+// The state of a machine at one point in time, which can be restored to any machine later.
+// Snapshots share the pages of memory that were not written between them, so taking a snapshot
+// costs little more than copying the pages written since the previous one.
+class Snapshot
+{
+public:
+    // The size of a snapshot written as a frame of bytes.  Each part of the state is at a fixed
+    // offset in the frame, so that the frames of similar states differ in few bytes.
+    static constexpr std::size_t frame_size = 2 + sizeof(Address) // Fault
+        + sizeof(Address) // Program counter
+        + 18 + sizeof(Word) // Registers
+        + 1 + Stack::max_size() * sizeof(Address) // Stack
+        + memory_size + sizeof(std::uint16_t) // Memory and keys
+        + Display::height * sizeof(Display::Row) // Display
+        + 6 * sizeof(std::uint64_t); // Timers
+
+    // Writes the state to a frame of frame_size bytes, except for the random source, whose state is
+    // not exposed as bytes.
+    auto write_frame(gsl::span<Byte> frame) const -> void;
+
+    // Reads a snapshot from a frame written by write_frame and the random source.  Each page of the
+    // frame that equals the corresponding given page shares it, so that restoring the snapshot to
+    // the machine that the pages came from copies only the pages that differ.
+    static auto read_frame(gsl::span<Byte const> frame, Random const& random,
+        Pages const& pages = {}) -> Snapshot;
+
+    [[nodiscard]] auto fault() const noexcept -> std::optional<Fault> const&
+    {
+        return fault_;
+    }
+
+    [[nodiscard]] auto program_counter() const noexcept -> Address
+    {
+        return program_counter_;
+    }
+
+    [[nodiscard]] auto registers() const noexcept -> Registers const&
+    {
+        return registers_;
+    }
+
+    [[nodiscard]] auto stack() const noexcept -> Stack const&
+    {
+        return stack_;
+    }
+
+    [[nodiscard]] auto pages() const noexcept -> Pages const&
+    {
+        return pages_;
+    }
+
+    // Returns a copy of the memory assembled from the pages.
+    [[nodiscard]] auto memory() const -> Memory;
+
+    [[nodiscard]] auto keys() const noexcept -> Keys const&
+    {
+        return keys_;
+    }
+
+    [[nodiscard]] auto display() const noexcept -> Display const&
+    {
+        return display_;
+    }
+
+    [[nodiscard]] auto random() const noexcept -> Random const&
+    {
+        return random_;
+    }
+
+private:
+    friend class Machine;
+
+    Snapshot() = default;
+
+    std::optional<Fault> fault_;
+    Address program_counter_{};
+    Registers registers_;
+    Stack stack_;
+    Pages pages_;
+    Keys keys_;
+    Display display_;
+
+    frequencypp::hertz master_clock_rate_{120};
+    std::size_t delay_cycles_ = 0;
+    std::size_t sound_cycles_ = 0;
+    std::optional<frequencypp::hertz> timer_periods_clock_rate_;
+    std::size_t delay_period_ = 1;
+    std::size_t sound_period_ = 1;
+
+    Random random_;
+};
+
+} // namespace libnpln::machine
+
+#endif
@@ -0,0 +1,172 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Machine.hpp>
+#include <libnpln/machine/Snapshot.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace libnpln::machine;
+
+template<>
+struct Catch::StringMaker<Machine>
+{
+    static auto convert(Machine const& m)
+    {
+        return fmt::to_string(m);
+    }
+};
+
+namespace {
+
+// Writes a count to the page at 300h in decimal and draws random digits.
+auto create_machine(Backend const backend) -> Machine
+{
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0xC0, 0x0F, // RND %V0, $0Fh
+            0x71, 0x05, // ADD %V1, $05h
+            0xA3, 0x00, // MOV %I, $300h
+            0xF1, 0x33, // BCD %V1
+            0xF0, 0x29, // FONT %V0
+            0xD1, 0x25, // DRW %V1, %V2, $5h
+            0xF0, 0x15, // MOV %DT, %V0
+            0x12, 0x00, // JMP 200h
+        },
+        m.memory());
+    return m;
+}
+
+auto run(Machine& m, std::size_t const cycles) -> void
+{
+    REQUIRE(m.run(cycles, no_stop_reasons) == RunResult{StopReason::budget_exhausted, cycles});
+}
+
+} // namespace
+
+TEST_CASE("Snapshots restore the state of the machine", "[machine][snapshot]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+
+    auto m = create_machine(backend);
+    run(m, 37);
+    auto const s = m.snapshot();
+    auto const m_expect = m;
+    REQUIRE(s.memory() == m.memory());
+    REQUIRE(s.program_counter() == m.program_counter());
+    REQUIRE(s.registers() == m.registers());
+    REQUIRE(s.display() == m.display());
+
+    run(m, 1000);
+    REQUIRE(m != m_expect);
+
+    m.restore(s);
+    REQUIRE(m == m_expect);
+
+    // The random source and timers are restored, so the machine runs as it did after the snapshot.
+    auto m_after = m_expect;
+    run(m_after, 1000);
+    run(m, 1000);
+    REQUIRE(m == m_after);
+}
+
+TEST_CASE("Snapshots restore the state of other machines", "[machine][snapshot]")
+{
+    auto m = create_machine(Backend::threaded);
+    run(m, 100);
+    auto const s = m.snapshot();
+
+    Machine other{Backend::switched};
+    other.restore(s);
+    REQUIRE(other == m);
+    REQUIRE(other.backend() == Backend::switched);
+
+    run(m, 100);
+    run(other, 100);
+    REQUIRE(other == m);
+}
+
+TEST_CASE("Snapshots share the pages that were not written", "[machine][snapshot]")
+{
+    auto m = create_machine(Backend::switched);
+    auto const s0 = m.snapshot();
+    auto const s1 = m.snapshot();
+    REQUIRE(s1.pages() == s0.pages());
+
+    // Access that may write to memory only copies the pages that were changed.
+    m.memory()[0x400] = 0xAA;
+    auto const s2 = m.snapshot();
+    for (std::size_t p = 0; p < page_count; ++p) {
+        REQUIRE((s2.pages()[p] == s0.pages()[p]) == (p != 0x4));
+    }
+
+    // The program writes to the page at 300h.
+    run(m, 8);
+    auto const s3 = m.snapshot();
+    for (std::size_t p = 0; p < page_count; ++p) {
+        REQUIRE((s3.pages()[p] == s2.pages()[p]) == (p != 0x3));
+    }
+    REQUIRE(s2.memory()[0x300] == 0x00);
+    REQUIRE(s3.memory() == m.memory());
+
+    // Restoring only copies the pages that differ, and shares them again.
+    m.restore(s2);
+    REQUIRE(m.memory() == s2.memory());
+    REQUIRE(m.snapshot().pages() == s2.pages());
+}
+
+TEST_CASE("Snapshots can be written to frames and read back", "[machine][snapshot]")
+{
+    auto m = create_machine(Backend::switched);
+    run(m, 50);
+    m.keys().set(3);
+    m.stack().push(0x234);
+    m.fault() = Fault{Fault::Type::full_stack, 0x210};
+    auto const s = m.snapshot();
+    auto const m_expect = m;
+
+    std::vector<Byte> frame(Snapshot::frame_size);
+    s.write_frame(frame);
+    auto const read = Snapshot::read_frame(frame, s.random());
+
+    Machine other;
+    other.restore(read);
+    REQUIRE(other == m_expect);
+    REQUIRE(read.memory() == s.memory());
+
+    // Reading with the pages of a snapshot shares those that are equal.
+    auto pages = s.pages();
+    auto changed = std::make_shared<Page>(*pages[0x2]);
+    (*changed)[0x00] ^= 0xFFU;
+    pages[0x2] = changed;
+    auto const shared = Snapshot::read_frame(frame, s.random(), pages);
+    for (std::size_t p = 0; p < page_count; ++p) {
+        REQUIRE((shared.pages()[p] == s.pages()[p]) == (p != 0x2));
+    }
+    REQUIRE(shared.memory() == s.memory());
+
+    other.fault() = std::nullopt;
+    m.fault() = std::nullopt;
+    run(other, 100);
+    run(m, 100);
+    REQUIRE(other == m);
+
+    REQUIRE_THROWS_AS(s.write_frame(gsl::span<Byte>{frame}.subspan(1)), std::invalid_argument);
+}
@@ -0,0 +1,140 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Trace.hpp>
+
+#include <gsl/gsl>
+
+#include <algorithm>
+#include <array>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace libnpln::machine {
+
+namespace {
+
+constexpr std::array<char, 4> magic{'N', 'P', 'L', 'T'};
+constexpr char version = 1;
+
+constexpr std::size_t entry_size = 16;
+
+// The number of entries that are encoded before they are written to the stream at once.
+constexpr std::size_t chunk_size = 4096;
+
+template<typename T>
+auto encode(T value, char*& out) noexcept -> void
+{
+    for (std::size_t b = 0; b < sizeof(T); ++b) {
+        *out++ = static_cast<char>(value & 0xFFU); // NOLINT(cppcoreguidelines-pro-bounds-*)
+        value = static_cast<T>(value >> 8U);
+    }
+}
+
+template<typename T>
+auto decode(char const*& in) noexcept -> T
+{
+    T value = 0;
+    for (std::size_t b = 0; b < sizeof(T); ++b) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        value |= static_cast<T>(static_cast<T>(static_cast<unsigned char>(*in++)) << (8U * b));
+    }
+    return value;
+}
+
+} // namespace
+
+Trace::Trace(std::size_t const capacity)
+{
+    if (capacity == 0) {
+        throw std::invalid_argument("Trace capacity must not be zero");
+    }
+
+    capacity_ = 1;
+    while (capacity_ < capacity) {
+        capacity_ <<= 1U;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+    entries_ = std::make_unique<TraceEntry[]>(capacity_);
+}
+
+auto write_trace_header(std::ostream& s) -> bool
+{
+    s.write(magic.data(), magic.size());
+    s.put(version);
+    return static_cast<bool>(s);
+}
+
+auto write_trace(std::ostream& s, Trace& trace) -> bool
+{
+    std::vector<char> chunk(chunk_size * entry_size);
+    trace.take([&](TraceEntry const* first, std::size_t count) {
+        while (count > 0) {
+            auto const n = std::min(count, chunk_size);
+            auto* out = chunk.data();
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            std::for_each(first, first + n, [&out](TraceEntry const& e) {
+                encode(e.cycle, out);
+                encode(e.address, out);
+                encode(e.word, out);
+                encode(e.changed_registers, out);
+            });
+            s.write(chunk.data(), gsl::narrow<std::streamsize>(n * entry_size));
+            first += n; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            count -= n;
+        }
+    });
+    return static_cast<bool>(s);
+}
+
+auto read_trace_header(std::istream& s) -> bool
+{
+    std::array<char, magic.size() + 1> header{};
+    return s.read(header.data(), header.size())
+        && std::equal(magic.begin(), magic.end(), header.begin()) && header.back() == version;
+}
+
+auto read_trace_entry(std::istream& s) -> std::optional<TraceEntry>
+{
+    std::array<char, entry_size> bytes{};
+    if (!s.read(bytes.data(), bytes.size())) {
+        return std::nullopt;
+    }
+
+    char const* in = bytes.data();
+    TraceEntry e{};
+    e.cycle = decode<std::uint64_t>(in);
+    e.address = decode<Address>(in);
+    e.word = decode<Word>(in);
+    e.changed_registers = decode<std::uint32_t>(in);
+    return e;
+}
+
+auto render_trace(std::istream& in, std::ostream& out) -> bool
+{
+    if (!read_trace_header(in)) {
+        return false;
+    }
+
+    for (auto e = read_trace_entry(in); e != std::nullopt; e = read_trace_entry(in)) {
+        out << fmt::format("{}\n", *e);
+    }
+
+    // The trace is complete if it ended between entries.
+    return in.gcount() == 0 && static_cast<bool>(out);
+}
+
+} // namespace libnpln::machine
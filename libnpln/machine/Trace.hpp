@@ -0,0 +1,321 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_MACHINE_TRACE_HPP
+#define LIBNPLN_MACHINE_TRACE_HPP
+
+#include <libnpln/detail/cpp2b.hpp>
+#include <libnpln/machine/DataUnits.hpp>
+#include <libnpln/machine/Instruction.hpp>
+#include <libnpln/machine/Register.hpp>
+#include <libnpln/machine/Registers.hpp>
+
+#include <fmt/format.h>
+
+#ifdef __SSE2__
+#    include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace libnpln::machine {
+
+// Whether machines record their traces, which are compiled out if LIBNPLN_NO_TRACE is defined.
+#ifdef LIBNPLN_NO_TRACE
+constexpr bool tracing_enabled = false;
+#else
+constexpr bool tracing_enabled = true;
+#endif
+
+// An executed instruction, packed into 16 bytes.
+struct TraceEntry
+{
+    // The bits of changed_registers after those of the general-purpose registers, which are
+    // indexed by their number.
+    static constexpr std::uint32_t dt_changed = 1U << 16U;
+    static constexpr std::uint32_t st_changed = 1U << 17U;
+    static constexpr std::uint32_t i_changed = 1U << 18U;
+
+    auto operator==(TraceEntry const& rhs) const noexcept
+    {
+        return cycle == rhs.cycle && address == rhs.address && word == rhs.word
+            && changed_registers == rhs.changed_registers;
+    }
+    auto operator!=(TraceEntry const& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    // The number of instructions that were recorded before this one.
+    std::uint64_t cycle;
+    Address address;
+    Word word;
+    std::uint32_t changed_registers;
+};
+
+static_assert(sizeof(TraceEntry) == 16);
+
+// Finds the registers that each instruction changed by comparing them with their values after the
+// previous instruction.  The registers are compared as two overlapping runs of 16 bytes, from the
+// first general-purpose register and from the last four bytes, which hold the timers and index:
+// by one vector comparison each where SSE2 is available, and otherwise eight bytes at a time in
+// the lanes of an integer.
+class RegisterChanges
+{
+public:
+    explicit RegisterChanges(Registers const& registers) noexcept
+        : low_(load(registers, 0)), high_(load(registers, high_offset))
+    {}
+
+    // Returns the bits of TraceEntry::changed_registers for the registers that the instruction
+    // changed, given the registers after it.
+    auto update(Registers const& after) noexcept -> std::uint32_t
+    {
+        auto const low = load(after, 0);
+        auto const high = load(after, high_offset);
+        auto const general = differ(low_, low);
+        auto const timers = differ(high_, high) >> (offsetof(Registers, dt) - high_offset);
+        low_ = low;
+        high_ = high;
+        return general | (timers & 0b11U) << 16U
+            | static_cast<std::uint32_t>((timers >> 2U) != 0) << 18U;
+    }
+
+    // Takes the timers after they tick between instructions.
+    auto tick(Registers const& after) noexcept -> void
+    {
+        high_ = load(after, high_offset);
+    }
+
+private:
+    static_assert(offsetof(Registers, v0) == 0x00 && offsetof(Registers, vf) == 0x0F
+        && offsetof(Registers, dt) == 0x10 && offsetof(Registers, st) == 0x11
+        && offsetof(Registers, i) == 0x12 && sizeof(Registers) == 0x14);
+    static constexpr std::size_t high_offset = sizeof(Registers) - 16;
+
+#ifdef __SSE2__
+    using Lanes = __m128i;
+
+    static auto load(Registers const& registers, std::size_t const offset) noexcept -> Lanes
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto const* const bytes = reinterpret_cast<unsigned char const*>(&registers) + offset;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return _mm_loadu_si128(reinterpret_cast<__m128i const*>(bytes));
+    }
+
+    // Returns a bit for each of the 16 bytes that differ.
+    static auto differ(Lanes const a, Lanes const b) noexcept -> std::uint32_t
+    {
+        return ~static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) & 0xFFFFU;
+    }
+#else
+    using Lanes = std::array<std::uint64_t, 2>;
+
+    static auto load(Registers const& registers, std::size_t const offset) noexcept -> Lanes
+    {
+        Lanes lanes{};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        std::memcpy(lanes.data(), reinterpret_cast<unsigned char const*>(&registers) + offset,
+            sizeof(lanes));
+        return lanes;
+    }
+
+    // Returns a bit for each of the 16 bytes that differ.  The highest bit of each byte of the
+    // difference is set if any of its bits are, and the multiplication gathers those bits into the
+    // highest byte.  This assumes that the bytes of an integer are stored from the least
+    // significant.
+    static auto differ(Lanes const& a, Lanes const& b) noexcept -> std::uint32_t
+    {
+        constexpr std::uint64_t low_bits = 0x7F7F'7F7F'7F7F'7F7FU;
+        constexpr std::uint64_t gather = 0x0102'0408'1020'4080U;
+        auto const differ_eight = [](std::uint64_t const x) {
+            auto const high_bits = (((x & low_bits) + low_bits) | x) & ~low_bits;
+            return static_cast<std::uint32_t>(((high_bits >> 7U) * gather) >> 56U);
+        };
+        return differ_eight(a[0] ^ b[0]) | differ_eight(a[1] ^ b[1]) << 8U;
+    }
+#endif
+
+    Lanes low_;
+    Lanes high_;
+};
+
+// A fixed-size ring of the instructions that a machine executed, which one producer thread records
+// and one consumer thread takes without locking.  The producer never waits: an instruction that is
+// recorded while the ring is full is dropped and counted, but still advances the cycle, so that the
+// consumer can see where the gaps are.
+class Trace
+{
+public:
+    // The capacity is rounded up to a power of two.
+    explicit Trace(std::size_t capacity);
+    Trace(Trace const&) = delete;
+    Trace(Trace&&) noexcept = delete;
+    ~Trace() = default;
+
+    auto operator=(Trace const&) -> Trace& = delete;
+    auto operator=(Trace&&) noexcept -> Trace& = delete;
+
+    // Records an instruction.  Only the producer may call this.
+    auto record(Address const address, Word const word, std::uint32_t const changed_registers)
+        noexcept -> void
+    {
+        auto const cycle = cycle_++;
+        auto const head = head_.load(std::memory_order_relaxed);
+        if (head - tail_cache_ == capacity_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head - tail_cache_ == capacity_) {
+                dropped_.store(dropped_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        entries_[head & (capacity_ - 1)] = {cycle, address, word, changed_registers};
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    // Takes every entry that was recorded since the last take, handing them to the function as one
+    // or two contiguous ranges of a pointer to the first entry and a count, in the order they were
+    // recorded.  Returns the number of entries taken.  Only the consumer may call this.
+    template<typename Function>
+    auto take(Function&& f) -> std::size_t
+    {
+        auto const tail = tail_.load(std::memory_order_relaxed);
+        auto const count = head_.load(std::memory_order_acquire) - tail;
+        if (count == 0) {
+            return 0;
+        }
+
+        auto const first = tail & (capacity_ - 1);
+        auto const contiguous = std::min(count, capacity_ - first);
+        f(entries_.get() + first, contiguous);
+        if (contiguous < count) {
+            f(entries_.get(), count - contiguous);
+        }
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Returns whether nothing was recorded since the last take.  Only the consumer may call this.
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t
+    {
+        return capacity_;
+    }
+
+    // The number of instructions that were dropped because the ring was full.
+    [[nodiscard]] auto dropped() const noexcept -> std::uint64_t
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    // The indices are kept on separate cache lines, as each is written by a different thread.
+    static constexpr std::size_t cache_line_size = 64;
+
+    std::size_t capacity_;
+    std::unique_ptr<TraceEntry[]> entries_; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+    // Owned by the producer.
+    alignas(cache_line_size) std::atomic<std::size_t> head_{0};
+    std::size_t tail_cache_ = 0;
+    std::uint64_t cycle_ = 0;
+    std::atomic<std::uint64_t> dropped_{0};
+
+    // Owned by the consumer.
+    alignas(cache_line_size) std::atomic<std::size_t> tail_{0};
+};
+
+// Traces are written in a binary format: the magic bytes "NPLT" and a version byte, followed by
+// each entry as its cycle, address, word, and changed registers in 16 little-endian bytes.  As the
+// header and entries are written separately, a trace can be streamed to a file while it is
+// recorded.
+auto write_trace_header(std::ostream& s) -> bool;
+
+// Takes every entry that was recorded in the trace since the last take and writes them.  Only the
+// consumer of the trace may call this.
+auto write_trace(std::ostream& s, Trace& trace) -> bool;
+
+// Reads the header of a trace written by write_trace_header, and returns whether it is one.
+auto read_trace_header(std::istream& s) -> bool;
+
+// Reads the next entry of a trace after its header, or returns std::nullopt at its end.
+auto read_trace_entry(std::istream& s) -> std::optional<TraceEntry>;
+
+// Renders a trace as text, one entry per line, and returns whether it was a complete trace.
+auto render_trace(std::istream& in, std::ostream& out) -> bool;
+
+} // namespace libnpln::machine
+
+// Formats an entry as its cycle, address, word, instruction, and changed registers:
+//
+//         1042  20Ah  7001  ADD $01h, %V0         V0
+template<>
+struct fmt::formatter<libnpln::machine::TraceEntry>
+{
+    template<typename ParseContext>
+    constexpr auto parse(ParseContext& context)
+    {
+        return context.begin();
+    }
+
+    template<typename FormatContext>
+    auto format(libnpln::machine::TraceEntry const& value, FormatContext& context)
+    {
+        using namespace libnpln::machine;
+
+        std::string changed;
+        for (auto r = Byte{0}; r <= libnpln::detail::to_underlying(Register::vf); ++r) {
+            if ((value.changed_registers & (1U << r)) != 0) {
+                changed += fmt::format(" {}", static_cast<Register>(r));
+            }
+        }
+        if ((value.changed_registers & TraceEntry::dt_changed) != 0) {
+            changed += " DT";
+        }
+        if ((value.changed_registers & TraceEntry::st_changed) != 0) {
+            changed += " ST";
+        }
+        if ((value.changed_registers & TraceEntry::i_changed) != 0) {
+            changed += " I";
+        }
+
+        auto const instruction = Instruction::decode(value.word);
+        auto const text =
+            instruction == std::nullopt ? std::string{"invalid"} : fmt::to_string(*instruction);
+        if (changed.empty()) {
+            return format_to(context.out(), "{:>12}  {:03X}h  {:04X}  {}", value.cycle,
+                value.address, value.word, text);
+        }
+        return format_to(context.out(), "{:>12}  {:03X}h  {:04X}  {:<20} {}", value.cycle,
+            value.address, value.word, text, changed);
+    }
+};
+
+#endif
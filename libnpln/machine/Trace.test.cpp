@@ -0,0 +1,251 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/machine/Trace.hpp>
+
+#include <libnpln/machine/Machine.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libnpln::machine;
+
+template<>
+struct Catch::StringMaker<Machine>
+{
+    static auto convert(Machine const& m)
+    {
+        return fmt::to_string(m);
+    }
+};
+
+template<>
+struct Catch::StringMaker<TraceEntry>
+{
+    static auto convert(TraceEntry const& e)
+    {
+        return fmt::to_string(e);
+    }
+};
+
+namespace {
+
+auto create_machine(Backend const backend) -> Machine
+{
+    Machine m{backend};
+    load_into_memory<Machine::program_address>(
+        {
+            0x60, 0x05, // MOV %V0, $05h
+            0xA3, 0x00, // MOV %I, $300h
+            0xF0, 0x33, // BCD %V0
+            0x71, 0xFF, // ADD %V1, $FFh
+            0x81, 0x04, // ADD %V1, %V0
+            0x12, 0x0A, // JMP 20Ah
+        },
+        m.memory());
+    return m;
+}
+
+auto take_all(Trace& t) -> std::vector<TraceEntry>
+{
+    std::vector<TraceEntry> entries;
+    t.take([&entries](TraceEntry const* first, std::size_t const count) {
+        entries.insert(entries.end(), first, first + count);
+    });
+    return entries;
+}
+
+} // namespace
+
+TEST_CASE("Trace capacity is rounded up to a power of two", "[machine][trace]")
+{
+    REQUIRE(Trace{1}.capacity() == 1);
+    REQUIRE(Trace{5}.capacity() == 8);
+    REQUIRE(Trace{64}.capacity() == 64);
+    REQUIRE_THROWS_AS(Trace{0}, std::invalid_argument);
+}
+
+TEST_CASE("Register changes have one bit for each register", "[machine][trace]")
+{
+    Registers before;
+    REQUIRE(RegisterChanges{before}.update(before) == 0);
+    for (auto r = Byte{0}; r <= libnpln::detail::to_underlying(Register::vf); ++r) {
+        for (auto const value : {Byte{0x01}, Byte{0x80}, Byte{0xFF}}) {
+            auto after = before;
+            after[static_cast<Register>(r)] = value;
+            REQUIRE(RegisterChanges{before}.update(after) == 1U << r);
+        }
+    }
+
+    auto after = before;
+    after.dt = 1;
+    after.i = 0x100;
+    RegisterChanges changes{before};
+    REQUIRE(changes.update(after) == (TraceEntry::dt_changed | TraceEntry::i_changed));
+    REQUIRE(changes.update(after) == 0);
+
+    // Changes between instructions are not attributed to the next instruction.
+    after.st = 1;
+    changes.tick(after);
+    after.v0 = 1;
+    after.vf = 1;
+    REQUIRE(changes.update(after) == 0x8001U);
+    after.st = 0;
+    REQUIRE(changes.update(after) == TraceEntry::st_changed);
+}
+
+TEST_CASE("Trace records each instruction and the registers that it changed", "[machine][trace]")
+{
+    auto m = create_machine(Backend::compiled);
+    m.trace() = std::make_shared<Trace>(16);
+    REQUIRE(m.run(7, no_stop_reasons) == RunResult{StopReason::budget_exhausted, 7});
+
+    REQUIRE_FALSE(m.trace()->empty());
+    auto const entries = take_all(*m.trace());
+    REQUIRE(entries
+        == std::vector<TraceEntry>{
+            {0, 0x200, 0x6005, 1U << 0U},
+            {1, 0x202, 0xA300, TraceEntry::i_changed},
+            {2, 0x204, 0xF033, 0},
+            {3, 0x206, 0x71FF, 1U << 1U},
+            {4, 0x208, 0x8104, 1U << 1U | 1U << 0xFU},
+            {5, 0x20A, 0x120A, 0},
+            {6, 0x20A, 0x120A, 0},
+        });
+    REQUIRE(m.trace()->empty());
+    REQUIRE(take_all(*m.trace()).empty());
+    REQUIRE(m.trace()->dropped() == 0);
+}
+
+TEST_CASE("Trace drops instructions while it is full", "[machine][trace]")
+{
+    Trace t{4};
+    for (Address a = 0; a < 6; ++a) {
+        t.record(a, 0x00E0, 0);
+    }
+    REQUIRE(t.dropped() == 2);
+
+    auto entries = take_all(t);
+    REQUIRE(entries.size() == 4);
+    REQUIRE(entries.back().cycle == 3);
+
+    // The ring wraps around, and the cycles continue past the dropped instructions.
+    for (Address a = 6; a < 9; ++a) {
+        t.record(a, 0x00E0, 0);
+    }
+    entries = take_all(t);
+    REQUIRE(entries.size() == 3);
+    REQUIRE(entries.front() == TraceEntry{6, 6, 0x00E0, 0});
+    REQUIRE(entries.back() == TraceEntry{8, 8, 0x00E0, 0});
+}
+
+TEST_CASE("Trace is taken by one thread while another records it", "[machine][trace]")
+{
+    constexpr std::uint64_t count = 100'000;
+    Trace t{64};
+    std::thread producer{[&t]() {
+        for (std::uint64_t c = 0; c < count; ++c) {
+            t.record(static_cast<Address>(c), static_cast<Word>(c), 0);
+        }
+    }};
+
+    // Every entry that was not dropped arrives once, in order, and intact.
+    std::uint64_t taken = 0;
+    std::uint64_t next = 0;
+    auto ordered = true;
+    auto const take = [&]() {
+        taken += t.take([&](TraceEntry const* first, std::size_t const n) {
+            for (auto const* e = first; e != first + n; ++e) {
+                ordered = ordered && e->cycle >= next
+                    && e->address == static_cast<Address>(e->cycle);
+                next = e->cycle + 1;
+            }
+        });
+    };
+    while (next < count && taken + t.dropped() < count) {
+        take();
+    }
+    producer.join();
+    take();
+
+    REQUIRE(ordered);
+    REQUIRE(taken + t.dropped() == count);
+}
+
+TEST_CASE("Traced machines run as untraced machines do", "[machine][trace]")
+{
+    auto const backend = GENERATE(Backend::switched, Backend::threaded, Backend::compiled);
+    auto m = create_machine(backend);
+    auto m_expect = create_machine(backend);
+    m.trace() = std::make_shared<Trace>(1024);
+    m.profile().emplace();
+    REQUIRE(m.run(1000, no_stop_reasons) == m_expect.run(1000, no_stop_reasons));
+    REQUIRE(m == m_expect);
+    REQUIRE(take_all(*m.trace()).size() == 1000);
+    REQUIRE(m.profile()->cycles() == 1000);
+
+    // Copies are not traced, but moves take the trace with them.
+    auto const trace = m.trace();
+    REQUIRE(Machine{m}.trace() == nullptr);
+    REQUIRE(Machine{std::move(m)}.trace() == trace);
+}
+
+TEST_CASE("Trace is written and read in its binary format", "[machine][trace]")
+{
+    auto m = create_machine(Backend::switched);
+    m.trace() = std::make_shared<Trace>(4);
+
+    std::stringstream s;
+    REQUIRE(write_trace_header(s));
+    m.run(3, no_stop_reasons);
+    REQUIRE(write_trace(s, *m.trace()));
+    m.run(3, no_stop_reasons);
+    REQUIRE(write_trace(s, *m.trace()));
+
+    REQUIRE(read_trace_header(s));
+    for (std::uint64_t c = 0; c < 6; ++c) {
+        auto const e = read_trace_entry(s);
+        REQUIRE(e != std::nullopt);
+        REQUIRE(e->cycle == c);
+    }
+    REQUIRE(read_trace_entry(s) == std::nullopt);
+
+    s.clear();
+    s.seekg(0);
+    std::ostringstream text;
+    REQUIRE(render_trace(s, text));
+    REQUIRE(text.str()
+        == "           0  200h  6005  MOV $05h, %V0         V0\n"
+           "           1  202h  A300  MOV 300h, %I          I\n"
+           "           2  204h  F033  BCD %V0\n"
+           "           3  206h  71FF  ADD $FFh, %V1         V1\n"
+           "           4  208h  8104  ADD %V0, %V1          V1 VF\n"
+           "           5  20Ah  120A  JMP 20Ah\n");
+
+    // A truncated trace is rendered up to its last complete entry.
+    auto truncated = std::istringstream{s.str().substr(0, s.str().size() - 1)};
+    text.str({});
+    REQUIRE_FALSE(render_trace(truncated, text));
+    REQUIRE(text.str().find("208h") != std::string::npos);
+
+    auto invalid = std::istringstream{"NPLR"};
+    REQUIRE_FALSE(render_trace(invalid, text));
+}
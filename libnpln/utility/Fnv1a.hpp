@@ -0,0 +1,60 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_UTILITY_FNV1A_HPP
+#define LIBNPLN_UTILITY_FNV1A_HPP
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace libnpln::utility {
+
+// Computes a 64-bit FNV-1a hash of a sequence of bytes, which is stable across platforms and runs.
+class Fnv1a
+{
+public:
+    constexpr auto add(std::uint8_t const byte) noexcept -> void
+    {
+        hash_ ^= byte;
+        hash_ *= prime;
+    }
+
+    // Adds the bytes of the integer from the most to the least significant, independently of the
+    // byte order.
+    template<typename T>
+    constexpr auto add_integer(T const value) noexcept
+        -> std::enable_if_t<std::is_integral_v<T> && std::is_unsigned_v<T>, void>
+    {
+        constexpr auto byte_bits = std::numeric_limits<std::uint8_t>::digits;
+        for (auto shift = std::numeric_limits<T>::digits; shift > 0; shift -= byte_bits) {
+            add(static_cast<std::uint8_t>(value >> (shift - byte_bits)));
+        }
+    }
+
+    [[nodiscard]] constexpr auto value() const noexcept -> std::uint64_t
+    {
+        return hash_;
+    }
+
+private:
+    static constexpr std::uint64_t offset_basis = 0xCBF29CE484222325;
+    static constexpr std::uint64_t prime = 0x100000001B3;
+
+    std::uint64_t hash_ = offset_basis;
+};
+
+} // namespace libnpln::utility
+
+#endif
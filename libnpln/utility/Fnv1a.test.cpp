@@ -0,0 +1,53 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/utility/Fnv1a.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <string_view>
+
+using namespace libnpln::utility;
+
+namespace {
+
+auto hash_string(std::string_view const s) -> std::uint64_t
+{
+    Fnv1a h;
+    for (auto const c : s) {
+        h.add(static_cast<std::uint8_t>(c));
+    }
+    return h.value();
+}
+
+} // namespace
+
+TEST_CASE("Fnv1a produces the reference hashes", "[utility][fnv1a]")
+{
+    REQUIRE(hash_string("") == 0xCBF29CE484222325);
+    REQUIRE(hash_string("a") == 0xAF63DC4C8601EC8C);
+    REQUIRE(hash_string("foobar") == 0x85944171F73967E8);
+}
+
+TEST_CASE("Fnv1a adds integers from the most significant byte", "[utility][fnv1a]")
+{
+    Fnv1a h;
+    h.add_integer(std::uint16_t{0x6162});
+    REQUIRE(h.value() == hash_string("ab"));
+
+    Fnv1a h32;
+    h32.add_integer(std::uint32_t{0x666F6F62});
+    REQUIRE(h32.value() == hash_string("foob"));
+}
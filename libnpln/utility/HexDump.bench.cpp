@@ -0,0 +1,54 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/utility/HexDump.hpp>
+
+#include <libnpln/libnpln.bench.hpp>
+#include <libnpln/machine/Machine.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+using namespace libnpln;
+using namespace libnpln::machine;
+
+namespace {
+
+// Dumps the memory of a machine loaded with each ROM in turn, which has runs of zero rows for the
+// dump to elide.
+auto BM_ToHexDump(benchmark::State& state) -> void
+{
+    std::vector<Memory> memories;
+    for (auto const& rom : bench::get_roms()) {
+        Machine m;
+        load_into_memory(
+            std::begin(rom.program), std::end(rom.program), m.memory(), Machine::program_address);
+        memories.push_back(m.memory());
+    }
+    if (memories.empty()) {
+        memories.push_back(Machine{}.memory());
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utility::to_hex_dump(memories[i]));
+        i = (i + 1) % memories.size();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * memory_size));
+}
+
+} // namespace
+
+BENCHMARK(BM_ToHexDump);
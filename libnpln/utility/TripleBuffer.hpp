@@ -0,0 +1,86 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_UTILITY_TRIPLEBUFFER_HPP
+#define LIBNPLN_UTILITY_TRIPLEBUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace libnpln::utility {
+
+// Hands the latest of a series of values from one producer thread to one consumer thread without
+// either thread ever waiting for the other.  The producer writes into the back value and publishes
+// it, and the consumer takes the most recently published value as its front value.  Values that
+// are published while the consumer is not taking them are dropped.
+template<typename TValue>
+class TripleBuffer
+{
+public:
+    using value_type = TValue;
+
+    // Returns the value that the producer writes into.  Only the producer may call this.
+    auto back() noexcept -> value_type&
+    {
+        return values_[back_];
+    }
+
+    // Publishes the back value and exchanges it for another to write into.  Only the producer may
+    // call this.
+    auto publish() noexcept -> void
+    {
+        auto const previous =
+            middle_.exchange(static_cast<std::uint8_t>(back_ | fresh), std::memory_order_acq_rel);
+        back_ = static_cast<std::uint8_t>(previous & index_mask);
+    }
+
+    // Takes the most recently published value as the front value, if any was published since the
+    // last take, and returns whether it did.  Only the consumer may call this.
+    auto take() noexcept -> bool
+    {
+        if ((middle_.load(std::memory_order_acquire) & fresh) == 0) {
+            return false;
+        }
+
+        auto const previous = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = static_cast<std::uint8_t>(previous & index_mask);
+        return true;
+    }
+
+    // Returns the value that was last taken.  Only the consumer may call this.
+    auto front() noexcept -> value_type&
+    {
+        return values_[front_];
+    }
+    [[nodiscard]] auto front() const noexcept -> value_type const&
+    {
+        return values_[front_];
+    }
+
+private:
+    // The middle value is shared by both threads.  Its index is stored together with whether it
+    // was published since it was last taken, so that both can be exchanged atomically.
+    static constexpr std::uint8_t index_mask = 0b011;
+    static constexpr std::uint8_t fresh = 0b100;
+
+    std::array<value_type, 3> values_{};
+    std::uint8_t back_ = 0;
+    std::uint8_t front_ = 1;
+    std::atomic<std::uint8_t> middle_{2};
+};
+
+} // namespace libnpln::utility
+
+#endif
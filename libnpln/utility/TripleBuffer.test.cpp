@@ -0,0 +1,124 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/utility/TripleBuffer.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <thread>
+
+using namespace libnpln::utility;
+
+SCENARIO("TripleBuffer hands over the latest published value", "[utility][triplebuffer]")
+{
+    GIVEN("an empty buffer")
+    {
+        auto b = TripleBuffer<int>{};
+
+        WHEN("nothing is published")
+        {
+            THEN("nothing is taken")
+            {
+                REQUIRE_FALSE(b.take());
+                REQUIRE(b.front() == 0);
+            }
+        }
+
+        WHEN("a value is published")
+        {
+            b.back() = 1;
+            b.publish();
+
+            THEN("it is taken once")
+            {
+                REQUIRE(b.take());
+                REQUIRE(b.front() == 1);
+                REQUIRE_FALSE(b.take());
+                REQUIRE(b.front() == 1);
+            }
+        }
+
+        WHEN("several values are published before a take")
+        {
+            for (auto i = 1; i <= 5; ++i) {
+                b.back() = i;
+                b.publish();
+            }
+
+            THEN("only the last is taken")
+            {
+                REQUIRE(b.take());
+                REQUIRE(b.front() == 5);
+                REQUIRE_FALSE(b.take());
+            }
+        }
+
+        WHEN("values are published and taken alternately")
+        {
+            THEN("every value is taken")
+            {
+                for (auto i = 1; i <= 5; ++i) {
+                    b.back() = i;
+                    b.publish();
+                    REQUIRE(b.take());
+                    REQUIRE(b.front() == i);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("TripleBuffer hands over values between threads", "[utility][triplebuffer]")
+{
+    GIVEN("a buffer of values that are only consistent if they are not torn")
+    {
+        struct Value
+        {
+            std::size_t first = 0;
+            std::size_t second = 0;
+        };
+        auto b = TripleBuffer<Value>{};
+
+        WHEN("one thread publishes increasing values while another takes them")
+        {
+            static constexpr std::size_t last = 100000;
+            auto producer = std::thread{[&b]() {
+                for (std::size_t i = 1; i <= last; ++i) {
+                    b.back() = Value{i, i};
+                    b.publish();
+                }
+            }};
+
+            auto consistent = true;
+            auto increasing = true;
+            std::size_t previous = 0;
+            while (previous != last) {
+                if (b.take()) {
+                    auto const& v = b.front();
+                    consistent = consistent && v.first == v.second;
+                    increasing = increasing && v.first > previous;
+                    previous = v.first;
+                }
+            }
+            producer.join();
+
+            THEN("every value taken is whole and newer than the last")
+            {
+                REQUIRE(consistent);
+                REQUIRE(increasing);
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef LIBNPLN_UTILITY_WORKSTEALINGDEQUE_HPP
+#define LIBNPLN_UTILITY_WORKSTEALINGDEQUE_HPP
+
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace libnpln::utility {
+
+// A queue of work that belongs to one worker thread and that other worker threads steal from when
+// they run out of their own.  The owner takes the newest value, which is most likely to still be
+// in its cache, and thieves take the oldest, so that the two rarely contend for the same end.
+//
+// Each operation holds a lock for only as long as it takes to move one value, which costs far less
+// than the work that a value represents.
+template<typename TValue>
+class WorkStealingDeque
+{
+public:
+    using value_type = TValue;
+
+    // Adds a value to be taken next by the owner.
+    auto push(value_type value) -> void
+    {
+        auto const lock = std::lock_guard{mutex_};
+        values_.push_back(std::move(value));
+    }
+
+    // Adds a value to be taken by the owner only after every other value, such as the remainder of
+    // work that has already had its turn.
+    auto defer(value_type value) -> void
+    {
+        auto const lock = std::lock_guard{mutex_};
+        values_.push_front(std::move(value));
+    }
+
+    // Takes the value that was most recently pushed, if any.  Only the owner may call this.
+    auto pop() -> std::optional<value_type>
+    {
+        auto const lock = std::lock_guard{mutex_};
+        if (values_.empty()) {
+            return std::nullopt;
+        }
+
+        auto value = std::move(values_.back());
+        values_.pop_back();
+        return value;
+    }
+
+    // Takes the value that the owner would take last, if any.  Any thread may call this.
+    auto steal() -> std::optional<value_type>
+    {
+        auto const lock = std::lock_guard{mutex_};
+        if (values_.empty()) {
+            return std::nullopt;
+        }
+
+        auto value = std::move(values_.front());
+        values_.pop_front();
+        return value;
+    }
+
+    [[nodiscard]] auto empty() const -> bool
+    {
+        auto const lock = std::lock_guard{mutex_};
+        return values_.empty();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::deque<value_type> values_;
+};
+
+} // namespace libnpln::utility
+
+#endif
@@ -0,0 +1,111 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <libnpln/utility/WorkStealingDeque.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace libnpln::utility;
+
+SCENARIO(
+    "WorkStealingDeque gives the owner and thieves opposite ends", "[utility][workstealingdeque]")
+{
+    GIVEN("a deque with some values")
+    {
+        auto d = WorkStealingDeque<int>{};
+        d.push(1);
+        d.push(2);
+        d.push(3);
+
+        WHEN("values are popped")
+        {
+            THEN("the newest value is taken first")
+            {
+                REQUIRE(d.pop() == 3);
+                REQUIRE(d.pop() == 2);
+                REQUIRE(d.pop() == 1);
+                REQUIRE(d.pop() == std::nullopt);
+                REQUIRE(d.empty());
+            }
+        }
+
+        WHEN("values are stolen")
+        {
+            THEN("the oldest value is taken first")
+            {
+                REQUIRE(d.steal() == 1);
+                REQUIRE(d.steal() == 2);
+                REQUIRE(d.steal() == 3);
+                REQUIRE(d.steal() == std::nullopt);
+                REQUIRE(d.empty());
+            }
+        }
+
+        WHEN("a value is deferred")
+        {
+            d.defer(4);
+
+            THEN("the owner takes it after every other value")
+            {
+                REQUIRE(d.pop() == 3);
+                REQUIRE(d.pop() == 2);
+                REQUIRE(d.pop() == 1);
+                REQUIRE(d.pop() == 4);
+            }
+        }
+    }
+}
+
+SCENARIO(
+    "WorkStealingDeque gives each value to exactly one thread", "[utility][workstealingdeque]")
+{
+    GIVEN("a deque with many values")
+    {
+        static constexpr int count = 100000;
+        auto d = WorkStealingDeque<int>{};
+        for (auto i = 0; i < count; ++i) {
+            d.push(i);
+        }
+
+        WHEN("the owner pops while other threads steal")
+        {
+            std::vector<int> taken(count, 0);
+            auto const take_all = [&taken](auto take) {
+                while (auto const v = take()) {
+                    ++taken[static_cast<std::size_t>(*v)];
+                }
+            };
+
+            std::vector<std::thread> thieves;
+            for (auto t = 0; t < 3; ++t) {
+                thieves.emplace_back(
+                    [&d, &take_all]() { take_all([&d]() { return d.steal(); }); });
+            }
+            take_all([&d]() { return d.pop(); });
+            for (auto& t : thieves) {
+                t.join();
+            }
+
+            THEN("every value is taken once")
+            {
+                REQUIRE(std::all_of(taken.begin(), taken.end(), [](int n) { return n == 1; }));
+            }
+        }
+    }
+}
@@ -14,20 +14,329 @@
 
 #include <npln/disassembler/Disassembler.hpp>
 
+#include <npln/disassembler/MappedFile.hpp>
 #include <npln/disassembler/Parameters.hpp>
 
+#include <libnpln/disassembler/Disassembler.hpp>
+#include <libnpln/disassembler/TextRenderer.hpp>
+#include <libnpln/machine/Operator.hpp>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
 #include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 
 namespace npln::disassembler {
 
-Disassembler::Disassembler(Parameters const& params)
+namespace {
+
+using libnpln::disassembler::Summary;
+
+// The size of the listing that is rendered before it is written, which is 64 KiB.
+constexpr std::size_t flush_size = std::size_t{1} << 16U;
+
+// Determines whether a file name matches a pattern, in which * matches any run of characters and ?
+// matches any one character.
+auto matches(std::string_view const name, std::string_view const pattern) noexcept -> bool
+{
+    // After a mismatch, the last * is retried against one more character of the name.
+    std::size_t n = 0;
+    std::size_t p = 0;
+    auto star = std::string_view::npos;
+    std::size_t star_n = 0;
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            ++n;
+            ++p;
+        }
+        else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            star_n = n;
+        }
+        else if (star != std::string_view::npos) {
+            p = star + 1;
+            n = ++star_n;
+        }
+        else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        ++p;
+    }
+    return p == pattern.size();
+}
+
+// Appends the programs that an input names: the input itself, every file under it if it is a
+// directory, or every file beside it whose name matches it if it is a pattern.  The files of a
+// directory or pattern are appended in the order of their paths.
+auto expand(std::filesystem::path const& input, std::vector<std::filesystem::path>& paths) -> void
+{
+    namespace fs = std::filesystem;
+
+    auto const first = paths.size();
+    auto const pattern = input.filename().string();
+    if (fs::is_directory(input)) {
+        for (auto const& entry : fs::recursive_directory_iterator{input}) {
+            if (entry.is_regular_file()) {
+                paths.push_back(entry.path());
+            }
+        }
+    }
+    else if (pattern.find_first_of("*?") != std::string::npos) {
+        auto const directory = input.has_parent_path() ? input.parent_path() : fs::path{"."};
+        for (auto const& entry : fs::directory_iterator{directory}) {
+            if (entry.is_regular_file() && matches(entry.path().filename().string(), pattern)) {
+                paths.push_back(entry.path());
+            }
+        }
+    }
+    else {
+        paths.push_back(input);
+        return;
+    }
+
+    if (paths.size() == first) {
+        spdlog::warn("No programs found for {}", input.c_str());
+    }
+    std::sort(std::next(paths.begin(), static_cast<std::ptrdiff_t>(first)), paths.end());
+}
+
+// Writes the listings of the programs to a file in the order of the programs, whatever order they
+// are disassembled in.  A listing is written in pieces as it is rendered once every listing before
+// it has been written, and is held in its buffer until then.
+class ListingWriter
+{
+public:
+    ListingWriter(std::FILE* const file, std::filesystem::path const& path) noexcept
+        : file_{file}, path_{path}
+    {}
+
+    // Writes a piece of the listing of a program if every listing before it has been written.
+    auto write_if_next(std::size_t const index, fmt::memory_buffer& buffer) -> void
+    {
+        auto const lock = std::scoped_lock{mutex_};
+        if (next_ == index) {
+            write(buffer);
+        }
+    }
+
+    // Waits for every listing before that of a program to be written, then writes the rest of it.
+    auto finish(std::size_t const index, fmt::memory_buffer& buffer) -> void
+    {
+        auto lock = std::unique_lock{mutex_};
+        next_changed_.wait(lock, [this, index] { return next_ == index; });
+
+        // The next listing may be written even if this one fails to be, so that its thread does
+        // not wait forever.
+        ++next_;
+        next_changed_.notify_all();
+        write(buffer);
+    }
+
+private:
+    auto write(fmt::memory_buffer& buffer) -> void
+    {
+        if (std::fwrite(buffer.data(), 1, buffer.size(), file_) != buffer.size()) {
+            throw std::runtime_error{
+                fmt::format("Unable to write output file {}", path_.c_str())};
+        }
+        buffer.clear();
+    }
+
+    std::FILE* file_;
+    std::filesystem::path const& path_;
+
+    std::mutex mutex_;
+    std::condition_variable next_changed_;
+    std::size_t next_ = 0;
+};
+
+} // namespace
+
+Disassembler::Disassembler(Parameters const& params) : params_(params)
 {
-    (void)params;
+    using libnpln::disassembler::Column;
+    if (params.include_label) {
+        columns_ |= Column::label;
+    }
+    if (params.include_address) {
+        columns_ |= Column::address;
+    }
+    if (params.include_opcode) {
+        columns_ |= Column::opcode;
+    }
+    if (params.include_instruction) {
+        columns_ |= Column::instruction;
+    }
+
+    for (auto const& p : params.input_paths) {
+        expand(p, paths_);
+    }
+    if (paths_.empty()) {
+        throw std::runtime_error{"No programs to disassemble"};
+    }
 }
 
 auto Disassembler::run() -> int
 {
-    return EXIT_SUCCESS;
+    auto file = std::unique_ptr<std::FILE, decltype(&std::fclose)>{nullptr, &std::fclose};
+    if (!params_.output_path.empty()) {
+        file.reset(std::fopen(params_.output_path.c_str(), "wb"));
+        if (file == nullptr) {
+            throw std::runtime_error{
+                fmt::format("Unable to open output file {}", params_.output_path.c_str())};
+        }
+    }
+    auto* const out = file != nullptr ? file.get() : stdout;
+
+    auto writer = ListingWriter{out, params_.output_path};
+    auto const renderer = libnpln::disassembler::TextRenderer{columns_};
+    auto summaries = std::vector<std::optional<Summary>>(paths_.size());
+
+    // The threads take the programs in order, so that a thread waiting to write a listing only
+    // waits for the programs that are being disassembled by the other threads.
+    std::atomic<std::size_t> next_path{0};
+    std::atomic<bool> stopped{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto const work = [&]() {
+        // The listing is rendered into a buffer that is written whenever it fills, so that only a
+        // piece of each listing is held in memory at once.
+        auto disassembler = libnpln::disassembler::Disassembler{{}};
+        auto buffer = fmt::memory_buffer{};
+        buffer.reserve(flush_size);
+        try {
+            // Every program that is taken is finished, even once the threads have been stopped, so
+            // that the threads waiting to write the listings after it do not wait forever.
+            for (auto i = next_path++; i < paths_.size(); i = next_path++) {
+                auto const& path = paths_[i];
+                try {
+                    if (stopped) {
+                        buffer.clear();
+                    }
+                    else {
+                        if (paths_.size() > 1) {
+                            fmt::format_to(std::back_inserter(buffer), "{}; {}\n",
+                                i == 0 ? "" : "\n", path.c_str());
+                        }
+
+                        auto const input = MappedFile{path};
+                        disassembler.reset(input.bytes());
+                        auto const& table = disassembler.run();
+                        for (auto const& row : table) {
+                            renderer.render(row, table.label(row), buffer);
+                            if (buffer.size() >= flush_size) {
+                                writer.write_if_next(i, buffer);
+                            }
+                        }
+                        summaries[i] = Summary{table};
+                    }
+                }
+                catch (std::exception const& e) {
+                    spdlog::error("Unable to disassemble program {}: {}", path.c_str(), e.what());
+                }
+                writer.finish(i, buffer);
+            }
+        }
+        catch (...) {
+            auto const lock = std::scoped_lock{error_mutex};
+            if (error == nullptr) {
+                error = std::current_exception();
+            }
+            stopped = true;
+        }
+    };
+
+    auto thread_count = params_.jobs != 0 ? params_.jobs : std::thread::hardware_concurrency();
+    thread_count = std::clamp<std::size_t>(thread_count, 1, paths_.size());
+    {
+        // This thread is one of the workers.
+        auto threads = std::vector<std::thread>{};
+        threads.reserve(thread_count - 1);
+        for (std::size_t i = 1; i < thread_count; ++i) {
+            threads.emplace_back(work);
+        }
+        work();
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+
+    if (std::fflush(out) != 0) {
+        throw std::runtime_error{
+            fmt::format("Unable to write output file {}", params_.output_path.c_str())};
+    }
+    if (!params_.summary_path.empty()) {
+        write_summary(summaries);
+    }
+
+    auto const succeeded = std::all_of(std::begin(summaries), std::end(summaries),
+        [](auto const& s) { return s != std::nullopt; });
+    return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+auto Disassembler::write_summary(std::vector<std::optional<Summary>> const& summaries) const
+    -> void
+{
+    using namespace libnpln::machine;
+
+    std::string text;
+    auto it = std::back_inserter(text);
+
+    auto total = Summary{};
+    it = fmt::format_to(
+        it, "{:>12}  {:>12}  {:>10}  {}\n", "code bytes", "data bytes", "code ratio", "program");
+    for (std::size_t i = 0; i < paths_.size(); ++i) {
+        if (summaries[i] == std::nullopt) {
+            continue;
+        }
+        auto const& s = *summaries[i];
+        it = fmt::format_to(it, "{:>12}  {:>12}  {:>10.3f}  {}\n", s.code_bytes(), s.data_bytes(),
+            s.code_ratio(), paths_[i].c_str());
+        total += s;
+    }
+    it = fmt::format_to(it, "{:>12}  {:>12}  {:>10.3f}  {}\n", total.code_bytes(),
+        total.data_bytes(), total.code_ratio(), "total");
+
+    std::vector<std::pair<std::size_t, std::string_view>> operators;
+    for (std::size_t i = 0; i + 1 < operator_id_count; ++i) {
+        auto const op = to_operator(static_cast<OperatorId>(i));
+        if (total.operator_count(op) != 0) {
+            operators.emplace_back(total.operator_count(op), get_name(op));
+        }
+    }
+    std::stable_sort(operators.begin(), operators.end(), [](auto const& a, auto const& b) {
+        return a.first > b.first;
+    });
+    it = fmt::format_to(it, "\n{:>12}  {}\n", "instructions", "operator");
+    for (auto const& [count, name] : operators) {
+        it = fmt::format_to(it, "{:>12}  {}\n", count, name);
+    }
+
+    auto s = std::ofstream{params_.summary_path};
+    s << text;
+    if (!s) {
+        throw std::runtime_error{
+            fmt::format("Unable to write summary file {}", params_.summary_path.c_str())};
+    }
 }
 
 } // namespace npln::disassembler
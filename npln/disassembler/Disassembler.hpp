@@ -15,10 +15,22 @@
 #ifndef NPLN_DISASSEMBLER_DISASSEMBLER_HPP
 #define NPLN_DISASSEMBLER_DISASSEMBLER_HPP
 
+#include <libnpln/disassembler/Column.hpp>
+#include <libnpln/disassembler/Summary.hpp>
+
+#include <flags/flags.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
 namespace npln::disassembler {
 
 struct Parameters;
 
+// Disassembles programs and writes their listings to a file or the standard output, in the order
+// of their paths.  The programs are disassembled in parallel on a pool of threads, each of which
+// reuses its disassembler and listing buffer from one program to the next.
 class Disassembler
 {
 public:
@@ -31,6 +43,17 @@ public:
     auto operator=(Disassembler&&) noexcept -> Disassembler& = delete;
 
     auto run() -> int;
+
+private:
+    // Writes the code and data of each program that was disassembled, and the instructions of all
+    // of them by operator, to the summary file.
+    auto write_summary(
+        std::vector<std::optional<libnpln::disassembler::Summary>> const& summaries) const -> void;
+
+    Parameters const& params_;
+    flags::flags<libnpln::disassembler::Column> columns_;
+    // The programs to disassemble, with the directories and patterns of the inputs expanded.
+    std::vector<std::filesystem::path> paths_;
 };
 
 } // namespace npln::disassembler
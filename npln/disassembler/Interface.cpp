@@ -33,17 +33,32 @@ auto install_interface(CLI::App& app, Parameters& params) -> CLI::App*
         "Include the address of each disassembly item");
     run_app->add_flag("-c,!-C,--opcode,!--no-opcode", params.include_opcode,
         "Include the opcode of each disassembly item");
+    run_app->add_flag("-l,!-L,--label,!--no-label", params.include_label,
+        "Include the label of each disassembly item");
+    run_app->add_flag("-i,!-I,--instruction,!--no-instruction", params.include_instruction,
+        "Include the instruction of each disassembly item");
     run_app->add_option("-o,--output", params.output_path, "Path to the listing output file");
-    run_app->add_option("input", params.input_path, "Path to the program input file")->required();
+    run_app->add_option("-s,--summary", params.summary_path,
+        "Path to a file to write the code, data, and operators of the programs to");
+    run_app->add_option("-j,--jobs", params.jobs,
+        "Number of programs to disassemble at once, or 0 for one per thread");
+    run_app
+        ->add_option("inputs", params.input_paths,
+            "Paths to the program input files, directories of them, or patterns of their names")
+        ->required();
     run_app->final_callback([&params]() {
+        int status = EXIT_SUCCESS;
         try {
-            Disassembler{params}.run();
+            status = Disassembler{params}.run();
         }
         catch (std::exception const& e) {
             spdlog::error(
                 "Uncaught exception of type {} in disassembler: {}", typeid(e).name(), e.what());
             throw CLI::RuntimeError{EXIT_FAILURE};
         }
+        if (status != EXIT_SUCCESS) {
+            throw CLI::RuntimeError{status};
+        }
     });
     return run_app;
 }
@@ -0,0 +1,109 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <npln/disassembler/MappedFile.hpp>
+
+#include <fmt/format.h>
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <unistd.h>
+#    define NPLN_HAS_MMAP
+#endif
+
+namespace npln::disassembler {
+
+MappedFile::MappedFile(std::filesystem::path const& path)
+{
+#ifdef NPLN_HAS_MMAP
+    auto const fd = ::open(path.c_str(), O_RDONLY); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (fd < 0) {
+        throw std::runtime_error{fmt::format("Unable to open input file {}", path.c_str())};
+    }
+
+    auto error = std::error_code{};
+    size_ = static_cast<std::size_t>(std::filesystem::file_size(path, error));
+    if (!error && size_ > 0) {
+        data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data_ == MAP_FAILED) { // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+            data_ = nullptr;
+        }
+        else {
+            // The file is read from front to back.
+            ::madvise(data_, size_, MADV_SEQUENTIAL);
+        }
+    }
+    ::close(fd);
+
+    if (error || (size_ > 0 && data_ == nullptr)) {
+        throw std::runtime_error{fmt::format("Unable to map input file {}", path.c_str())};
+    }
+#else
+    auto s = std::ifstream{path, std::ios::in | std::ios::binary};
+    if (!s) {
+        throw std::runtime_error{fmt::format("Unable to open input file {}", path.c_str())};
+    }
+    buffer_.assign(std::istreambuf_iterator<char>{s}, std::istreambuf_iterator<char>{});
+    size_ = buffer_.size();
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_{std::exchange(other.data_, nullptr)}
+    , size_{std::exchange(other.size_, 0)}
+    , buffer_{std::move(other.buffer_)}
+{}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile&
+{
+    if (this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        buffer_ = std::move(other.buffer_);
+    }
+    return *this;
+}
+
+auto MappedFile::bytes() const noexcept -> gsl::span<libnpln::machine::Byte const>
+{
+    if (data_ == nullptr) {
+        return {buffer_.data(), buffer_.size()};
+    }
+    return {static_cast<libnpln::machine::Byte const*>(data_), size_};
+}
+
+auto MappedFile::unmap() noexcept -> void
+{
+#ifdef NPLN_HAS_MMAP
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+} // namespace npln::disassembler
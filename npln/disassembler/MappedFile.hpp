@@ -0,0 +1,54 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef NPLN_DISASSEMBLER_MAPPEDFILE_HPP
+#define NPLN_DISASSEMBLER_MAPPEDFILE_HPP
+
+#include <libnpln/machine/DataUnits.hpp>
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace npln::disassembler {
+
+// The contents of a file mapped read-only into memory, so that the pages of the file are read on
+// demand instead of being copied into a buffer.  Where files cannot be mapped, the contents are
+// read into a buffer instead.
+class MappedFile
+{
+public:
+    explicit MappedFile(std::filesystem::path const& path);
+    MappedFile(MappedFile const&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    auto operator=(MappedFile const&) -> MappedFile& = delete;
+    auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+    [[nodiscard]] auto bytes() const noexcept -> gsl::span<libnpln::machine::Byte const>;
+
+private:
+    auto unmap() noexcept -> void;
+
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::vector<libnpln::machine::Byte> buffer_;
+};
+
+} // namespace npln::disassembler
+
+#endif
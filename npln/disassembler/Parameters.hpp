@@ -15,16 +15,26 @@
 #ifndef NPLN_DISASSEMBLER_PARAMETERS_HPP
 #define NPLN_DISASSEMBLER_PARAMETERS_HPP
 
+#include <cstddef>
 #include <filesystem>
+#include <vector>
 
 namespace npln::disassembler {
 
 struct Parameters
 {
-    std::filesystem::path input_path;
+    // The programs, directories of programs, or patterns of the names of programs to disassemble.
+    std::vector<std::filesystem::path> input_paths;
     std::filesystem::path output_path;
+    // The file to write a summary of the programs to, or empty to not summarize them.
+    std::filesystem::path summary_path;
     bool include_address{true};
     bool include_opcode{true};
+    bool include_label{true};
+    bool include_instruction{true};
+
+    // The number of programs to disassemble at once, or zero for one per hardware thread.
+    std::size_t jobs = 0;
 };
 
 } // namespace npln::disassembler
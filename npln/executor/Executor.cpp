@@ -0,0 +1,197 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <npln/executor/Executor.hpp>
+
+#include <npln/executor/Parameters.hpp>
+#include <npln/executor/TraceThread.hpp>
+
+#include <libnpln/executor/Executor.hpp>
+#include <libnpln/machine/Json.hpp>
+#include <libnpln/machine/Machine.hpp>
+#include <libnpln/machine/Replay.hpp>
+#include <libnpln/machine/RunResult.hpp>
+
+#include <fmt/format.h>
+#include <gsl/narrow>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace npln::executor {
+
+namespace {
+
+// The number of instructions that each trace holds until they are written, which are 16 MiB.
+constexpr std::size_t trace_capacity = std::size_t{1} << 20U;
+
+} // namespace
+
+Executor::Executor(Parameters const& params) : params_(params)
+{
+    // The profiles and traces are named after the programs, so the programs must be named
+    // differently.
+    if (!params.profile_path.empty() || !params.trace_path.empty()) {
+        std::set<std::filesystem::path> names;
+        for (auto const& p : params.paths) {
+            if (!names.insert(p.filename()).second) {
+                throw std::runtime_error{fmt::format(
+                    "Unable to profile or trace programs of the same name {}", p.c_str())};
+            }
+        }
+    }
+
+    if (params.input_path.empty()) {
+        return;
+    }
+
+    auto script = libnpln::machine::parse_input_script(params.input_path);
+    if (script == std::nullopt) {
+        throw std::runtime_error{
+            fmt::format("Unable to load input script {}", params.input_path.c_str())};
+    }
+    script_ = std::move(*script);
+}
+
+auto Executor::run() -> int
+{
+    using namespace libnpln::machine;
+    namespace executor = libnpln::executor;
+
+    auto file = std::ofstream{};
+    if (!params_.output_path.empty()) {
+        file.open(params_.output_path);
+        if (!file) {
+            throw std::runtime_error{
+                fmt::format("Unable to open output file {}", params_.output_path.c_str())};
+        }
+    }
+    auto& out = params_.output_path.empty() ? std::cout : file;
+
+    auto succeeded = true;
+    auto entries = std::vector<std::string>(params_.paths.size());
+    auto jobs = std::vector<executor::Job>{};
+    auto job_paths = std::vector<std::size_t>{};
+    auto traces = TraceThread::Traces{};
+    for (std::size_t i = 0; i < params_.paths.size(); ++i) {
+        auto job = load(params_.paths[i]);
+        if (job == std::nullopt) {
+            entries[i] = fmt::format(R"({{"path": {}, "error": "Unable to load program"}})",
+                to_json(params_.paths[i].string()));
+            succeeded = false;
+            continue;
+        }
+        if (!params_.trace_path.empty()) {
+            auto trace = std::make_shared<Trace>(trace_capacity);
+            job->machine().trace() = trace;
+            traces.emplace_back(
+                params_.trace_path / (params_.paths[i].filename().string() + ".trace"), trace);
+        }
+        jobs.push_back(std::move(*job));
+        job_paths.push_back(i);
+    }
+
+    auto trace_thread = std::optional<TraceThread>{};
+    if (!traces.empty()) {
+        trace_thread.emplace(std::move(traces));
+    }
+
+    executor::Executor{params_.jobs}.run(std::move(jobs), [&](executor::JobResult&& r) {
+        auto const i = job_paths[r.index];
+        if (r.machine.profile() != std::nullopt) {
+            write_profile(params_.paths[i], *r.machine.profile());
+        }
+        entries[i] = fmt::format(
+            R"({{"path": {}, "stop": "{}", "cycles": {}, "fusions": {}, "state": {}}})",
+            to_json(params_.paths[i].string()),
+            r.result.reason,
+            r.result.cycles,
+            to_json(r.machine.fusion_counts()),
+            to_json(r.machine));
+    });
+    if (trace_thread != std::nullopt) {
+        trace_thread->finish();
+    }
+
+    // One program per line in the order given, so that the results of large batches can be
+    // processed line by line.
+    out << "[\n";
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        out << "  " << entries[i] << (i + 1 < entries.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+
+    return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+auto Executor::load(std::filesystem::path const& path) const
+    -> std::optional<libnpln::executor::Job>
+{
+    using namespace libnpln::machine;
+
+    if (params_.replays) {
+        auto replay = read_replay(path);
+        auto m = replay ? create_machine(*replay, params_.backend) : std::nullopt;
+        if (m == std::nullopt) {
+            return std::nullopt;
+        }
+        if (!params_.profile_path.empty()) {
+            m->profile().emplace();
+        }
+        return libnpln::executor::Job{std::move(*m), std::move(replay->events), replay->cycles};
+    }
+
+    Machine m{params_.backend};
+    if (!params_.profile_path.empty()) {
+        m.profile().emplace();
+    }
+    if (params_.clock_rate != 0) {
+        m.master_clock_rate() =
+            frequencypp::hertz{gsl::narrow<frequencypp::hertz::rep>(params_.clock_rate)};
+    }
+
+    if (!load_into_memory(path, m.memory(), Machine::program_address)) {
+        return std::nullopt;
+    }
+
+    auto const budget = params_.ticks == 0
+        ? params_.cycles
+        : static_cast<std::size_t>(
+            params_.ticks * m.master_clock_rate().count() / Machine::delay_clock_rate.count());
+    return libnpln::executor::Job{std::move(m), script_, budget};
+}
+
+auto Executor::write_profile(
+    std::filesystem::path const& path, libnpln::machine::Profile const& profile) const -> void
+{
+    auto const write = [](std::filesystem::path const& p, std::string const& contents) {
+        auto file = std::ofstream{p};
+        if (!(file << contents)) {
+            throw std::runtime_error{fmt::format("Unable to write profile {}", p.c_str())};
+        }
+    };
+
+    auto const stem = params_.profile_path / path.filename();
+    write(stem.string() + ".profile", profile.to_flat_profile());
+    write(stem.string() + ".folded", profile.to_collapsed_stacks());
+}
+
+} // namespace npln::executor
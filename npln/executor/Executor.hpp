@@ -0,0 +1,57 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef NPLN_EXECUTOR_EXECUTOR_HPP
+#define NPLN_EXECUTOR_EXECUTOR_HPP
+
+#include <libnpln/executor/Job.hpp>
+#include <libnpln/machine/InputScript.hpp>
+#include <libnpln/machine/Profile.hpp>
+
+#include <filesystem>
+#include <optional>
+
+namespace npln::executor {
+
+struct Parameters;
+
+// Runs programs without a window and reports the final state of each one as JSON.
+class Executor
+{
+public:
+    explicit Executor(Parameters const& params);
+    Executor(Executor const&) = delete;
+    Executor(Executor&&) noexcept = delete;
+    ~Executor() = default;
+
+    auto operator=(Executor const&) -> Executor& = delete;
+    auto operator=(Executor&&) noexcept -> Executor& = delete;
+
+    auto run() -> int;
+
+private:
+    // Returns the job that runs the program, or nothing if the program could not be loaded.
+    auto load(std::filesystem::path const& path) const -> std::optional<libnpln::executor::Job>;
+
+    // Writes the flat profile and collapsed stacks of the program to the profile directory.
+    auto write_profile(
+        std::filesystem::path const& path, libnpln::machine::Profile const& profile) const -> void;
+
+    Parameters const& params_;
+    libnpln::machine::InputScript script_;
+};
+
+} // namespace npln::executor
+
+#endif
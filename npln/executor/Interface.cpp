@@ -0,0 +1,93 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <npln/executor/Interface.hpp>
+
+#include <npln/executor/Executor.hpp>
+#include <npln/executor/Parameters.hpp>
+
+#include <CLI/App.hpp>
+#include <spdlog/spdlog.h>
+
+#include <cstdlib>
+#include <exception>
+#include <map>
+#include <string>
+#include <typeinfo>
+
+namespace npln::executor {
+
+namespace {
+
+auto get_backend_names() -> std::map<std::string, libnpln::machine::Backend>
+{
+    std::map<std::string, libnpln::machine::Backend> names;
+    for (auto const b : libnpln::machine::backends) {
+        names.emplace(get_name(b), b);
+    }
+    return names;
+}
+
+} // namespace
+
+auto install_interface(CLI::App& app, Parameters& params) -> CLI::App*
+{
+    auto* exec_app =
+        app.add_subcommand("exec", "Run CHIP-8 executables without a window and report as JSON");
+    exec_app
+        ->add_option(
+            "-b,--backend", params.backend, "Interpreter backend to execute the programs with")
+        ->transform(CLI::CheckedTransformer(get_backend_names(), CLI::ignore_case));
+    auto* cycles_option =
+        exec_app
+            ->add_option("-n,--cycles", params.cycles, "Number of cycles to run each program for")
+            ->capture_default_str();
+    exec_app
+        ->add_option("-t,--ticks", params.ticks, "Number of timer ticks to run each program for")
+        ->excludes(cycles_option);
+    exec_app->add_option("-r,--clock-rate", params.clock_rate, "Master clock rate in hertz");
+    exec_app->add_option(
+        "-j,--jobs", params.jobs, "Number of programs to run at once, or 0 for one per thread");
+    auto* keys_option = exec_app->add_option(
+        "-k,--keys", params.input_path, "Path to the input script of key events");
+    exec_app
+        ->add_flag("--replay", params.replays, "Run replays recorded by run instead of executables")
+        ->excludes(keys_option);
+    exec_app->add_option("-o,--output", params.output_path, "Path to the JSON output file");
+    exec_app->add_option("-p,--profile",
+        params.profile_path,
+        "Path to a directory to write a flat profile and collapsed stacks of each program to");
+    exec_app->add_option("--trace",
+        params.trace_path,
+        "Path to a directory to write a binary trace of every instruction of each program to");
+    exec_app->add_option("paths", params.paths, "Paths to the executable or replay files to run")
+        ->required();
+    exec_app->final_callback([&params]() {
+        int status = EXIT_SUCCESS;
+        try {
+            status = Executor{params}.run();
+        }
+        catch (std::exception const& e) {
+            spdlog::error(
+                "Uncaught exception of type {} in executor: {}", typeid(e).name(), e.what());
+            throw CLI::RuntimeError{EXIT_FAILURE};
+        }
+        if (status != EXIT_SUCCESS) {
+            throw CLI::RuntimeError{status};
+        }
+    });
+    return exec_app;
+}
+
+} // namespace npln::executor
@@ -0,0 +1,53 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef NPLN_EXECUTOR_PARAMETERS_HPP
+#define NPLN_EXECUTOR_PARAMETERS_HPP
+
+#include <libnpln/machine/Backend.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace npln::executor {
+
+struct Parameters
+{
+    std::vector<std::filesystem::path> paths;
+    // Whether the paths are of replays, which give their own clock rate, keys, and budget.
+    bool replays = false;
+    std::filesystem::path input_path;
+    std::filesystem::path output_path;
+    // The directory to write the profile of each program to, or empty to not profile them.
+    std::filesystem::path profile_path;
+    // The directory to write the trace of each program to, or empty to not trace them.
+    std::filesystem::path trace_path;
+    libnpln::machine::Backend backend = libnpln::machine::Backend::switched;
+
+    // The budget of each program in cycles, unless a budget in timer ticks is given.
+    std::size_t cycles = 1'000'000;
+    std::size_t ticks = 0;
+
+    // The master clock rate in hertz, or zero for the default rate of the machine.
+    std::uint64_t clock_rate = 0;
+
+    // The number of programs to run at once, or zero for one per hardware thread.
+    std::size_t jobs = 0;
+};
+
+} // namespace npln::executor
+
+#endif
@@ -0,0 +1,92 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <npln/executor/TraceThread.hpp>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+
+namespace npln::executor {
+
+TraceThread::TraceThread(Traces traces) : traces_(std::move(traces))
+{
+    for (auto const& [path, trace] : traces_) {
+        auto& file = files_.emplace_back(path, std::ios::out | std::ios::binary);
+        if (!file || !libnpln::machine::write_trace_header(file)) {
+            throw std::runtime_error{fmt::format("Unable to write trace {}", path.c_str())};
+        }
+    }
+
+    thread_ = std::thread{[this]() { run(); }};
+}
+
+TraceThread::~TraceThread()
+{
+    stop();
+}
+
+auto TraceThread::finish() -> void
+{
+    stop();
+    write();
+
+    for (std::size_t i = 0; i < traces_.size(); ++i) {
+        auto const& [path, trace] = traces_[i];
+        if (!files_[i].flush()) {
+            throw std::runtime_error{fmt::format("Unable to write trace {}", path.c_str())};
+        }
+        if (trace->dropped() != 0) {
+            spdlog::warn("Dropped {} instructions from trace {}", trace->dropped(), path.c_str());
+        }
+    }
+}
+
+auto TraceThread::run() -> void
+{
+    // The rings are drained as fast as they are written, and checked again after a short sleep
+    // once they are empty.
+    static constexpr auto idle = std::chrono::milliseconds{1};
+
+    while (!stopping_.load(std::memory_order_relaxed)) {
+        if (!write()) {
+            std::this_thread::sleep_for(idle);
+        }
+    }
+}
+
+auto TraceThread::stop() -> void
+{
+    if (thread_.joinable()) {
+        stopping_.store(true, std::memory_order_relaxed);
+        thread_.join();
+    }
+}
+
+auto TraceThread::write() -> bool
+{
+    auto recorded = false;
+    for (std::size_t i = 0; i < traces_.size(); ++i) {
+        // A file that failed to be written stays failed, and is reported by finish.
+        auto& trace = *traces_[i].second;
+        recorded = recorded || !trace.empty();
+        libnpln::machine::write_trace(files_[i], trace);
+    }
+    return recorded;
+}
+
+} // namespace npln::executor
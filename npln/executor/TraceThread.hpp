@@ -0,0 +1,68 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef NPLN_EXECUTOR_TRACETHREAD_HPP
+#define NPLN_EXECUTOR_TRACETHREAD_HPP
+
+#include <libnpln/machine/Trace.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace npln::executor {
+
+// Streams traces to their files on its own thread while the machines that record them run, so
+// that traces of any length can be written from rings of a fixed size.
+class TraceThread
+{
+public:
+    using Traces =
+        std::vector<std::pair<std::filesystem::path, std::shared_ptr<libnpln::machine::Trace>>>;
+
+    // Creates the file of each trace and starts streaming to them.
+    explicit TraceThread(Traces traces);
+    TraceThread(TraceThread const&) = delete;
+    TraceThread(TraceThread&&) noexcept = delete;
+    ~TraceThread();
+
+    auto operator=(TraceThread const&) -> TraceThread& = delete;
+    auto operator=(TraceThread&&) noexcept -> TraceThread& = delete;
+
+    // Stops the thread once the machines have stopped, and writes the rest of each trace.
+    auto finish() -> void;
+
+private:
+    auto run() -> void;
+    auto stop() -> void;
+
+    // Writes what was recorded in each trace since the last write, and returns whether anything
+    // was recorded.
+    auto write() -> bool;
+
+    Traces traces_;
+    std::vector<std::ofstream> files_;
+    std::atomic<bool> stopping_ = false;
+
+    // Started last, once every other member is initialized.
+    std::thread thread_;
+};
+
+} // namespace npln::executor
+
+#endif
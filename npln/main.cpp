@@ -19,6 +19,11 @@
 #    include <npln/disassembler/Parameters.hpp>
 #endif
 
+#ifdef NPLN_BUILD_EXECUTOR
+#    include <npln/executor/Interface.hpp>
+#    include <npln/executor/Parameters.hpp>
+#endif
+
 #ifdef NPLN_BUILD_RUNNER
 #    include <npln/runner/Interface.hpp>
 #    include <npln/runner/Parameters.hpp>
@@ -40,6 +45,11 @@ auto main(int argc, char** argv) -> int
     npln::disassembler::install_interface(app, disassembler_params);
 #endif
 
+#ifdef NPLN_BUILD_EXECUTOR
+    npln::executor::Parameters executor_params;
+    npln::executor::install_interface(app, executor_params);
+#endif
+
 #ifdef NPLN_BUILD_RUNNER
     npln::runner::Parameters runner_params;
     npln::runner::install_interface(app, runner_params);
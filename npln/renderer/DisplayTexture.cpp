@@ -27,7 +27,12 @@ namespace npln::renderer {
 
 DisplayTexture::DisplayTexture(libnpln::machine::Display& display) : display_(display)
 {
-    update();
+    for (std::decay_t<decltype(height)> y = 0; y < height; ++y) {
+        convert_row(y);
+    }
+    generation_ = display_.generation();
+    display_.clear_dirty_rows();
+
     texture_.image2D(0, format, width, height, 0, format, type, pixels.data());
     texture_.setParameter(gl::GL_TEXTURE_MIN_FILTER, gl::GL_NEAREST);
     texture_.setParameter(gl::GL_TEXTURE_MAG_FILTER, gl::GL_NEAREST);
@@ -35,19 +40,57 @@ DisplayTexture::DisplayTexture(libnpln::machine::Display& display) : display_(di
 
 auto DisplayTexture::update() -> void
 {
+    if (display_.generation() == generation_) {
+        return;
+    }
+
+    auto const& dirty_rows = display_.dirty_rows();
     for (std::decay_t<decltype(height)> y = 0; y < height; ++y) {
-        for (std::decay_t<decltype(width)> x = 0; x < width; ++x) {
-            auto& pixel = gsl::at(pixels, gsl::narrow<gsl::index>(y * width + x));
-            pixel = *display_.pixel(x, y) ? on_color : off_color;
+        if (dirty_rows.test(y)) {
+            convert_row(y);
         }
     }
+
+    upload_rows_ |= dirty_rows;
+    generation_ = display_.generation();
+    display_.clear_dirty_rows();
 }
 
 auto DisplayTexture::render() -> void
 {
-    // TODO: Profile whether it is faster to upload the texture on every frame or only after
-    // checking whether the display has actually changed.
-    texture_.subImage2D(0, 0, 0, width, height, format, type, pixels.data());
+    if (upload_rows_.none()) {
+        return;
+    }
+
+    // Upload the smallest band of rows that covers every changed row in a single call.
+    std::size_t first = 0;
+    while (!upload_rows_.test(first)) {
+        ++first;
+    }
+    auto last = height - 1;
+    while (!upload_rows_.test(last)) {
+        --last;
+    }
+
+    texture_.subImage2D(0,
+        0,
+        gsl::narrow<gl::GLint>(first),
+        width,
+        gsl::narrow<gl::GLsizei>(last - first + 1),
+        format,
+        type,
+        &gsl::at(pixels, gsl::narrow<gsl::index>(first * width)));
+    upload_rows_.reset();
+}
+
+auto DisplayTexture::convert_row(std::size_t const y) -> void
+{
+    // The leftmost pixel of a row is its most significant bit.
+    auto const row = display_.row(y);
+    for (std::decay_t<decltype(width)> x = 0; x < width; ++x) {
+        auto& pixel = gsl::at(pixels, gsl::narrow<gsl::index>(y * width + x));
+        pixel = ((row >> (width - 1 - x)) & 1U) != 0 ? on_color : off_color;
+    }
 }
 
 } // namespace npln::renderer
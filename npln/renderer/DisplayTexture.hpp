@@ -21,6 +21,7 @@
 #include <globjects/Texture.h>
 
 #include <array>
+#include <cstddef>
 #include <type_traits>
 
 namespace npln::renderer {
@@ -54,10 +55,15 @@ public:
         return texture_;
     }
 
+    // Converts the rows of the display that changed since the last update into texture pixels.
     auto update() -> void;
+
+    // Uploads the pixels of the rows that changed since the last render, if any.
     auto render() -> void;
 
 private:
+    auto convert_row(std::size_t y) -> void;
+
     libnpln::machine::Display& display_;
 
     static constexpr auto width = std::decay_t<decltype(display_)>::width;
@@ -66,6 +72,8 @@ private:
     static constexpr auto type = gl::GL_UNSIGNED_INT_8_8_8_8;
 
     std::array<gl::GLuint, width * height> pixels{};
+    libnpln::machine::Display::Generation generation_ = 0;
+    libnpln::machine::Display::DirtyRows upload_rows_;
 
     globjects::Texture texture_;
 };
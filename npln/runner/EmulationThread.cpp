@@ -0,0 +1,98 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <npln/runner/EmulationThread.hpp>
+
+#include <libnpln/machine/RunResult.hpp>
+
+#include <chrono>
+#include <cstddef>
+
+namespace npln::runner {
+
+EmulationThread::EmulationThread(
+    libnpln::machine::Machine& machine, libnpln::machine::Recorder* recorder)
+    : machine_(machine)
+    , recorder_(recorder)
+    , keys_(machine.keys().to_ulong())
+    , thread_([this]() { run(); })
+{}
+
+EmulationThread::~EmulationThread()
+{
+    stopping_.store(true, std::memory_order_relaxed);
+    thread_.join();
+}
+
+auto EmulationThread::set_keys(libnpln::machine::Keys const& keys) noexcept -> void
+{
+    keys_.store(keys.to_ulong(), std::memory_order_relaxed);
+}
+
+auto EmulationThread::take_frame(libnpln::machine::Display& display) -> bool
+{
+    if (!frames_.take()) {
+        return false;
+    }
+
+    display.copy_pixels(frames_.front());
+    return true;
+}
+
+auto EmulationThread::run() -> void
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Slices are short enough that input latency is imperceptible, but long enough that the
+    // thread spends most of its time asleep.
+    static constexpr auto slice = std::chrono::milliseconds{1};
+
+    auto generation = machine_.display().generation();
+    frames_.back() = machine_.display();
+    frames_.publish();
+
+    auto accumulated_time = Clock::duration{};
+    auto last_time = Clock::now();
+    auto next_time = last_time + slice;
+    while (!stopping_.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_until(next_time);
+        next_time += slice;
+
+        // Ensure that the machine cycles in real time regardless of how long the thread slept.
+        auto const now = Clock::now();
+        accumulated_time += now - last_time;
+        last_time = now;
+        auto const passed_cycles = accumulated_time * machine_.master_clock_rate();
+        accumulated_time -= passed_cycles
+            * frequencypp::duration_cast<Clock::duration>(machine_.master_clock_rate());
+
+        machine_.keys() = libnpln::machine::Keys{keys_.load(std::memory_order_relaxed)};
+        if (recorder_ != nullptr) {
+            recorder_->run(
+                static_cast<std::size_t>(passed_cycles), libnpln::machine::no_stop_reasons);
+        }
+        else {
+            machine_.run(
+                static_cast<std::size_t>(passed_cycles), libnpln::machine::no_stop_reasons);
+        }
+
+        if (machine_.display().generation() != generation) {
+            generation = machine_.display().generation();
+            frames_.back() = machine_.display();
+            frames_.publish();
+        }
+    }
+}
+
+} // namespace npln::runner
@@ -0,0 +1,67 @@
+// Copyright 2020-2022 Jeremiah Griffin
+//
+// Permission to use, copy, modify, and/or distribute this software for any
+// purpose with or without fee is hereby granted, provided that the above
+// copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+// WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+// ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+// WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+// ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+// OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#ifndef NPLN_RUNNER_EMULATIONTHREAD_HPP
+#define NPLN_RUNNER_EMULATIONTHREAD_HPP
+
+#include <libnpln/machine/Display.hpp>
+#include <libnpln/machine/Keys.hpp>
+#include <libnpln/machine/Machine.hpp>
+#include <libnpln/machine/Recorder.hpp>
+#include <libnpln/utility/TripleBuffer.hpp>
+
+#include <atomic>
+#include <thread>
+
+namespace npln::runner {
+
+// Runs a machine in real time on its own thread, so that rendering cannot delay it.  The machine
+// belongs to the thread until the EmulationThread is destroyed.  Frames of the display are handed
+// to the render thread, and keys are handed to the machine, without either thread waiting for the
+// other.  If a recorder is given, the machine is run through it.
+class EmulationThread
+{
+public:
+    explicit EmulationThread(
+        libnpln::machine::Machine& machine, libnpln::machine::Recorder* recorder = nullptr);
+    EmulationThread(EmulationThread const&) = delete;
+    EmulationThread(EmulationThread&&) noexcept = delete;
+    ~EmulationThread();
+
+    auto operator=(EmulationThread const&) -> EmulationThread& = delete;
+    auto operator=(EmulationThread&&) noexcept -> EmulationThread& = delete;
+
+    // Sets the keys that the machine sees from its next slice of cycles.
+    auto set_keys(libnpln::machine::Keys const& keys) noexcept -> void;
+
+    // Copies the pixels of the latest frame into the display if a frame was published since the
+    // last call, and returns whether one was.  Only one thread may take frames.
+    auto take_frame(libnpln::machine::Display& display) -> bool;
+
+private:
+    auto run() -> void;
+
+    libnpln::machine::Machine& machine_;
+    libnpln::machine::Recorder* recorder_;
+    libnpln::utility::TripleBuffer<libnpln::machine::Display> frames_;
+    std::atomic<unsigned long> keys_;
+    std::atomic<bool> stopping_ = false;
+
+    // Started last, once every other member is initialized.
+    std::thread thread_;
+};
+
+} // namespace npln::runner
+
+#endif
@@ -22,13 +22,37 @@
 
 #include <cstdlib>
 #include <exception>
+#include <map>
+#include <string>
 #include <typeinfo>
 
 namespace npln::runner {
 
+namespace {
+
+auto get_backend_names() -> std::map<std::string, libnpln::machine::Backend>
+{
+    using libnpln::machine::Backend;
+    std::map<std::string, Backend> names;
+    for (auto const b : libnpln::machine::backends) {
+        names.emplace(get_name(b), b);
+    }
+    return names;
+}
+
+} // namespace
+
 auto install_interface(CLI::App& app, Parameters& params) -> CLI::App*
 {
     auto* run_app = app.add_subcommand("run", "Run a CHIP-8 executable");
+    run_app
+        ->add_option(
+            "-b,--backend", params.backend, "Interpreter backend to execute the program with")
+        ->transform(CLI::CheckedTransformer(get_backend_names(), CLI::ignore_case));
+    run_app->add_flag("-t,--thread",
+        params.emulation_thread,
+        "Run the machine on its own thread, independently of rendering");
+    run_app->add_option("-r,--record", params.record_path, "Path to write a replay of the run to");
     run_app->add_option("path", params.path, "Path to the executable file to run")->required();
     run_app->final_callback([&params]() {
         try {
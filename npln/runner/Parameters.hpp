@@ -15,6 +15,8 @@
 #ifndef NPLN_RUNNER_PARAMETERS_HPP
 #define NPLN_RUNNER_PARAMETERS_HPP
 
+#include <libnpln/machine/Backend.hpp>
+
 #include <filesystem>
 
 namespace npln::runner {
@@ -22,6 +24,9 @@ namespace npln::runner {
 struct Parameters
 {
     std::filesystem::path path;
+    std::filesystem::path record_path;
+    libnpln::machine::Backend backend = libnpln::machine::Backend::switched;
+    bool emulation_thread = false;
 };
 
 } // namespace npln::runner
@@ -15,11 +15,13 @@
 #include <npln/runner/Runner.hpp>
 
 #include <npln/renderer/DisplayTexture.hpp>
+#include <npln/runner/EmulationThread.hpp>
 #include <npln/runner/GlfwError.hpp>
 #include <npln/runner/Parameters.hpp>
 
 #include <GLFW/glfw3.h>
 #include <fmt/format.h>
+#include <gsl/gsl>
 #include <glbinding/gl/gl.h>
 #include <globjects/TextureHandle.h>
 #include <globjects/globjects.h>
@@ -28,19 +30,54 @@
 #include <imgui_impl_opengl3.h>
 #include <spdlog/spdlog.h>
 
+#include <cstddef>
 #include <cstdlib>
+#include <optional>
 #include <stdexcept>
-#include <type_traits>
 
 namespace npln::runner {
 
-Runner::Runner(Parameters const& params)
+namespace {
+
+// Maps the keys of the left side of a QWERTY keyboard onto the hexadecimal keypad, preserving the
+// physical layout of the keypad.
+auto to_machine_key(int const key) noexcept -> std::optional<libnpln::machine::Key>
+{
+    using libnpln::machine::Key;
+    switch (key) {
+    case GLFW_KEY_1: return Key::k1;
+    case GLFW_KEY_2: return Key::k2;
+    case GLFW_KEY_3: return Key::k3;
+    case GLFW_KEY_4: return Key::kc;
+    case GLFW_KEY_Q: return Key::k4;
+    case GLFW_KEY_W: return Key::k5;
+    case GLFW_KEY_E: return Key::k6;
+    case GLFW_KEY_R: return Key::kd;
+    case GLFW_KEY_A: return Key::k7;
+    case GLFW_KEY_S: return Key::k8;
+    case GLFW_KEY_D: return Key::k9;
+    case GLFW_KEY_F: return Key::ke;
+    case GLFW_KEY_Z: return Key::ka;
+    case GLFW_KEY_X: return Key::k0;
+    case GLFW_KEY_C: return Key::kb;
+    case GLFW_KEY_V: return Key::kf;
+    default: return std::nullopt;
+    }
+}
+
+} // namespace
+
+Runner::Runner(Parameters const& params) : record_path_(params.record_path)
 {
     using namespace libnpln::machine;
+    machine.backend() = params.backend;
     if (!load_into_memory(params.path, machine.memory(), Machine::program_address)) {
         throw std::runtime_error{
             fmt::format("Unable to load program {} into memory", params.path.c_str())};
     }
+    if (!record_path_.empty()) {
+        recorder_ = std::make_unique<Recorder>(machine);
+    }
 
     install_error_callback();
     create_window();
@@ -48,7 +85,14 @@ Runner::Runner(Parameters const& params)
     initialize_imgui();
     initialize_framebuffer();
 
-    display_texture_ = std::make_unique<renderer::DisplayTexture>(machine.display());
+    if (params.emulation_thread) {
+        display_.copy_pixels(machine.display());
+        display_texture_ = std::make_unique<renderer::DisplayTexture>(display_);
+        emulation_thread_ = std::make_unique<EmulationThread>(machine, recorder_.get());
+    }
+    else {
+        display_texture_ = std::make_unique<renderer::DisplayTexture>(machine.display());
+    }
 }
 
 Runner::~Runner()
@@ -146,6 +190,19 @@ auto Runner::run() -> int
 
         frame_time = FrameClock::now() - start_time;
     }
+
+    // The machine belongs to its thread until the thread stops.
+    emulation_thread_.reset();
+    for (std::size_t i = 0; i < libnpln::machine::fusion_count; ++i) {
+        spdlog::debug("Fusion {}: {} times",
+            static_cast<libnpln::machine::Fusion>(i),
+            gsl::at(machine.fusion_counts(), static_cast<gsl::index>(i)));
+    }
+
+    if (recorder_ != nullptr && !write_replay(record_path_, recorder_->replay())) {
+        spdlog::error("Unable to write replay {}", record_path_.c_str());
+        return EXIT_FAILURE;
+    }
     return EXIT_SUCCESS;
 }
 
@@ -165,11 +222,29 @@ auto Runner::process_key(int key, int scan_code, int action, int mods) -> void
     if (key == GLFW_KEY_ESCAPE && action == GLFW_RELEASE) {
         glfwSetWindowShouldClose(window, GLFW_TRUE);
     }
+
+    auto const machine_key = to_machine_key(key);
+    if (machine_key == std::nullopt || action == GLFW_REPEAT) {
+        return;
+    }
+
+    keys_.set(libnpln::machine::to_index(*machine_key), action == GLFW_PRESS);
+    if (emulation_thread_ != nullptr) {
+        emulation_thread_->set_keys(keys_);
+    }
+    else {
+        machine.keys() = keys_;
+    }
 }
 
 auto Runner::update(FrameClock::duration const& frame_time) -> void
 {
-    cycle_machine(frame_time);
+    if (emulation_thread_ != nullptr) {
+        emulation_thread_->take_frame(display_);
+    }
+    else {
+        cycle_machine(frame_time);
+    }
 
     display_texture_->update();
 
@@ -211,8 +286,11 @@ auto Runner::cycle_machine(FrameClock::duration const& frame_time) -> void
     auto const passed_cycles = accumulated_frame_time * machine.master_clock_rate();
     accumulated_frame_time -= passed_cycles
         * frequencypp::duration_cast<FrameClock::duration>(machine.master_clock_rate());
-    for (std::decay_t<decltype(passed_cycles)> i = 0; i < passed_cycles; ++i) {
-        machine.cycle();
+    if (recorder_ != nullptr) {
+        recorder_->run(static_cast<std::size_t>(passed_cycles), libnpln::machine::no_stop_reasons);
+    }
+    else {
+        machine.run(static_cast<std::size_t>(passed_cycles), libnpln::machine::no_stop_reasons);
     }
 }
 
@@ -17,9 +17,13 @@
 
 #include <npln/runner/GlfwLibrary.hpp>
 
+#include <libnpln/machine/Display.hpp>
+#include <libnpln/machine/Keys.hpp>
 #include <libnpln/machine/Machine.hpp>
+#include <libnpln/machine/Recorder.hpp>
 
 #include <chrono>
+#include <filesystem>
 #include <memory>
 
 struct GLFWwindow;
@@ -32,6 +36,7 @@ class DisplayTexture;
 
 namespace npln::runner {
 
+class EmulationThread;
 struct Parameters;
 
 class Runner
@@ -68,6 +73,17 @@ private:
 
     libnpln::machine::Machine machine;
     FrameClock::duration accumulated_frame_time{};
+    libnpln::machine::Keys keys_;
+
+    // When recording, the machine is run through the recorder, and the replay is written once the
+    // runner stops.
+    std::filesystem::path record_path_;
+    std::unique_ptr<libnpln::machine::Recorder> recorder_;
+
+    // When the machine runs on its own thread, the display shows the latest frame that the thread
+    // handed over instead of the display of the machine.
+    std::unique_ptr<EmulationThread> emulation_thread_;
+    libnpln::machine::Display display_;
 
     GlfwLibrary glfwLibrary;
     GLFWwindow* window = nullptr;